@@ -0,0 +1,136 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: Unlicense
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <thread>
+
+#if defined(__GNUC__) || defined(__clang__)
+    #define DIGITALCURLING_CLIENT_PRINTF_FORMAT(fmt, args) __attribute__((format(printf, fmt, args)))
+#else
+    #define DIGITALCURLING_CLIENT_PRINTF_FORMAT(fmt, args)
+#endif
+
+namespace digitalcurling::client {
+
+/// @brief ログのレベル
+enum class LogLevel : std::uint8_t {
+    kDebug,
+    kInfo,
+    kWarning,
+    kError,
+};
+
+/// @brief ログの1レコード
+///
+/// リングバッファ上に固定長で格納する。呼び出し元では書式の整形 (`vsnprintf`) のみを行い、出力は書き込みスレッドで行う。
+/// 呼び出し元でヒープを確保しないよう、`message` に収まらない長いメッセージは末尾を `...` に置き換えて切り捨てる。
+struct LogRecord {
+    static constexpr std::size_t kTagSize = 16;
+    static constexpr std::size_t kMessageSize = 224;
+
+    /// @brief ロガーの開始からの経過時間 [ns]
+    std::int64_t timestamp;
+    /// @brief レベル
+    LogLevel level;
+    /// @brief サブシステムのタグ (終端文字を含む)
+    char tag[kTagSize];
+    /// @brief メッセージの長さ
+    std::uint32_t length;
+    /// @brief メッセージ
+    char message[kMessageSize];
+
+    /// @brief メッセージを返す
+    /// @return メッセージ
+    std::string_view GetMessage() const { return std::string_view(message, length); }
+};
+
+/// @brief 非同期ロガー
+///
+/// 書き込みは呼び出し元での書式の整形と、固定長のリングバッファへの lock-free な追加のみで行い、
+/// 標準出力やファイルへの出力はバックグラウンドのスレッドが行う。
+/// リングバッファが一杯の場合、レコードは破棄され、呼び出し元はブロックされない。
+/// 書き込みスレッドはリングバッファが空の間は条件変数で待機し、待機中の場合のみ呼び出し元が起こす。
+///
+/// コンソールには `kInfo` のメッセージをそのまま、それ以外のレベルは接頭辞を付けて出力する
+/// (`kError` は標準エラー出力)。ログファイルには全てのレコードをタイムスタンプとタグ付きで出力する。
+class AsyncLogger {
+public:
+    /// @brief インスタンスを返す
+    /// @return インスタンス
+    static AsyncLogger& GetInstance();
+
+    AsyncLogger(AsyncLogger const&) = delete;
+    AsyncLogger& operator=(AsyncLogger const&) = delete;
+    ~AsyncLogger();
+
+    /// @brief コンソールに出力する最低レベルを設定する
+    /// @param level レベル
+    void SetConsoleLevel(LogLevel level) { console_level_.store(level, std::memory_order_relaxed); }
+
+    /// @brief ログファイルを開く
+    /// @param path ログファイルのパス
+    /// @exception std::runtime_error ファイルを開けなかった場合
+    void OpenFile(std::filesystem::path const& path);
+
+    /// @brief ログを書き込む
+    ///
+    /// `LogRecord::kMessageSize` に収まらないメッセージは切り捨てる。
+    /// @param level レベル
+    /// @param tag サブシステムのタグ
+    /// @param format `printf` 形式の書式
+    void Log(LogLevel level, char const* tag, char const* format, ...) DIGITALCURLING_CLIENT_PRINTF_FORMAT(4, 5);
+
+    /// @brief それまでに書き込まれたログが出力されるまで待つ
+    void Flush();
+
+    /// @brief リングバッファが一杯で破棄したレコード数を返す
+    /// @return 破棄したレコード数
+    std::uint64_t GetDroppedCount() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr std::size_t kCapacity = 4096;
+
+    struct Slot {
+        std::atomic<std::size_t> sequence;
+        LogRecord record;
+    };
+
+    std::chrono::steady_clock::time_point origin_;
+    std::atomic<LogLevel> console_level_ = LogLevel::kInfo;
+    std::unique_ptr<Slot[]> slots_;
+    alignas(64) std::atomic<std::size_t> enqueue_position_ = 0;
+    alignas(64) std::atomic<std::size_t> dequeue_position_ = 0;
+    std::atomic<std::uint64_t> dropped_ = 0;
+
+    std::mutex file_mutex_;
+    std::FILE* file_ = nullptr;
+
+    std::atomic<bool> is_stopped_ = false;
+    std::thread writer_thread_;
+
+    /// @brief 書き込みスレッドの待機と `Flush()` の待機に用いる
+    std::mutex wake_mutex_;
+    std::condition_variable wake_cond_;
+    std::condition_variable flushed_cond_;
+    std::atomic<bool> is_writer_waiting_ = false;
+
+    AsyncLogger();
+
+    bool HasRecord() const;
+    void Wake();
+    bool TryPop(LogRecord& record);
+    void Write(LogRecord const& record);
+    void Run();
+};
+
+} // namespace digitalcurling::client
@@ -0,0 +1,51 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: Unlicense
+
+#pragma once
+
+#include <cmath>
+#include <limits>
+#include <digitalcurling/digitalcurling.hpp>
+#include "digitalcurling/client/compact_board.hpp"
+
+namespace digitalcurling::client {
+
+/// @brief ハウスの半径 [m]
+constexpr float kHouseRadius = 1.829f;
+
+/// @brief 現在の盤面でエンドが終了した場合の得点を返す
+///
+/// ハウス内 (ストーンの一部がハウスにかかっていればよい) で最もティーに近いストーンのチームが、
+/// 相手チームの最もティーに近いストーンより内側にあるストーンの数だけ得点する。
+/// @param board 盤面
+/// @param team 得点を求めるチーム
+/// @return `team` の得点 (相手チームが得点する場合は負の値)
+inline int GetEndScore(CompactBoard const& board, Team team) {
+    constexpr float kScoringDistance = kHouseRadius + Stone::kRadius;
+
+    float nearest[2] = { std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity() };
+    float distances[CompactBoard::kStoneCount];
+    for (std::size_t i = 0; i < CompactBoard::kStoneCount; ++i) {
+        distances[i] = std::numeric_limits<float>::infinity();
+        if (!board.HasStone(i)) continue;
+
+        auto const diff = board.GetPosition(i) - coordinate::kTee;
+        float const distance = std::hypot(diff.x, diff.y);
+        if (distance > kScoringDistance) continue;
+
+        distances[i] = distance;
+        nearest[i / 8] = std::min(nearest[i / 8], distance);
+    }
+
+    if (nearest[0] == nearest[1]) return 0; // ハウス内にストーンがない
+
+    std::size_t const scoring_team = nearest[0] < nearest[1] ? 0 : 1;
+    float const limit = nearest[1 - scoring_team];
+    int score = 0;
+    for (std::size_t i = scoring_team * 8; i < scoring_team * 8 + 8; ++i) {
+        if (distances[i] < limit) score++;
+    }
+    return scoring_team == static_cast<std::size_t>(team) ? score : -score;
+}
+
+} // namespace digitalcurling::client
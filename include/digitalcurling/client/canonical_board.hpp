@@ -0,0 +1,155 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: Unlicense
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <digitalcurling/digitalcurling.hpp>
+#include <digitalcurling/moves/shot.hpp>
+#include "digitalcurling/client/compact_board.hpp"
+
+namespace digitalcurling::client {
+
+/// @brief 盤面をセンターラインについて反転する
+/// @param board 盤面
+/// @return 反転した盤面
+inline CompactBoard MirrorBoard(CompactBoard const& board) {
+    CompactBoard mirrored = board;
+    for (std::size_t i = 0; i < CompactBoard::kStoneCount; ++i) {
+        if (board.HasStone(i)) mirrored.x[i] = 2.f * coordinate::kTee.x - board.x[i];
+    }
+    return mirrored;
+}
+
+/// @brief ショットをセンターラインについて反転する
+///
+/// リリース角度と角速度の符号を反転する。反転した盤面に反転したショットを投げた結果は、元の結果を反転したものとなる。
+/// @param shot ショット
+/// @return 反転したショット
+inline moves::Shot MirrorShot(moves::Shot const& shot) {
+    return moves::Shot(shot.translational_velocity, -shot.angular_velocity, -shot.release_angle);
+}
+
+/// @brief 正規化した盤面
+///
+/// 手番のチームのストーンを先、相手チームのストーンを後に並べ、それぞれを座標順に整列する。
+/// ストーンのインデックスやチームの番号が異なっても、同じ配置であれば同じ盤面となる。
+/// 座標は `kResolution` 単位に丸める。定石やエンドゲームのテーブルのキーに用いる。
+/// シートはセンターラインについて対称であるため、盤面とそれを反転した盤面のうち座標の辞書順で小さい方を用いる。
+/// 反転した場合、テーブルに登録するショットや、テーブルから取り出したショットも `MirrorShot()` で反転すること。
+struct CanonicalBoard {
+    /// @brief 座標の分解能 [m]
+    static constexpr float kResolution = 0.01f;
+
+    /// @brief 手番のチームのストーン数
+    std::uint8_t own_count = 0;
+    /// @brief 相手チームのストーン数
+    std::uint8_t opponent_count = 0;
+    /// @brief ストーンの座標 (`kResolution` 単位)
+    std::array<std::array<std::int16_t, 2>, CompactBoard::kStoneCount> positions {};
+
+    /// @brief 盤面を正規化する
+    /// @param board 盤面
+    /// @param team 手番のチーム
+    /// @param[out] is_mirrored 反転したかどうか (`nullptr` なら出力しない)
+    /// @return 正規化した盤面
+    static CanonicalBoard Create(CompactBoard const& board, Team team, bool* is_mirrored = nullptr) {
+        auto const original = CreateUnmirrored(board, team);
+        auto const mirrored = original.Mirror();
+        // 左右対称な盤面は反転しない
+        bool const mirror = mirrored.positions < original.positions;
+        if (is_mirrored != nullptr) *is_mirrored = mirror;
+        return mirror ? mirrored : original;
+    }
+
+    /// @brief 反転せずに盤面を正規化する
+    /// @param board 盤面
+    /// @param team 手番のチーム
+    /// @return 正規化した盤面
+    static CanonicalBoard CreateUnmirrored(CompactBoard const& board, Team team) {
+        CanonicalBoard canonical;
+        std::size_t count = 0;
+        for (Team t : { team, GetOpponentTeam(team) }) {
+            auto const begin = count;
+            auto const offset = static_cast<std::size_t>(t) * 8;
+            for (auto i = offset; i < offset + 8; ++i) {
+                if (!board.HasStone(i)) continue;
+                canonical.positions[count++] = { Quantize(board.x[i]), Quantize(board.y[i]) };
+            }
+            std::sort(canonical.positions.begin() + begin, canonical.positions.begin() + count);
+            (t == team ? canonical.own_count : canonical.opponent_count) = static_cast<std::uint8_t>(count - begin);
+        }
+        return canonical;
+    }
+
+    /// @brief センターラインについて反転した盤面を返す
+    ///
+    /// センターラインは x = 0 (`coordinate::kTee.x`) であるため、丸めた座標の符号の反転で厳密に反転できる。
+    /// @return 反転した盤面
+    CanonicalBoard Mirror() const {
+        CanonicalBoard mirrored = *this;
+        for (std::size_t i = 0; i < GetStoneCount(); ++i) mirrored.positions[i][0] = -positions[i][0];
+        auto const own_end = mirrored.positions.begin() + own_count;
+        std::sort(mirrored.positions.begin(), own_end);
+        std::sort(own_end, own_end + opponent_count);
+        return mirrored;
+    }
+
+    /// @brief ハッシュ値を返す
+    /// @return ハッシュ値
+    std::uint64_t GetHash() const {
+        // FNV-1a
+        std::uint64_t hash = 0xcbf29ce484222325ull;
+        auto const mix = [&hash](std::uint64_t value) {
+            hash ^= value;
+            hash *= 0x100000001b3ull;
+        };
+        mix(own_count);
+        mix(opponent_count);
+        for (std::size_t i = 0; i < GetStoneCount(); ++i) {
+            mix(static_cast<std::uint16_t>(positions[i][0]));
+            mix(static_cast<std::uint16_t>(positions[i][1]));
+        }
+        return hash;
+    }
+
+    /// @brief 2つの盤面の距離を返す
+    /// @param other 盤面
+    /// @return 各ストーンの位置ずれの最大値 [m] (ストーン数が異なる場合は無限大)
+    float GetDistance(CanonicalBoard const& other) const {
+        if (own_count != other.own_count || opponent_count != other.opponent_count) {
+            return std::numeric_limits<float>::infinity();
+        }
+
+        int max_distance = 0;
+        for (std::size_t i = 0; i < GetStoneCount(); ++i) {
+            int const dx = positions[i][0] - other.positions[i][0];
+            int const dy = positions[i][1] - other.positions[i][1];
+            max_distance = std::max(max_distance, dx * dx + dy * dy);
+        }
+        return std::sqrt(static_cast<float>(max_distance)) * kResolution;
+    }
+
+    /// @brief ストーン数を返す
+    /// @return ストーン数
+    std::size_t GetStoneCount() const { return static_cast<std::size_t>(own_count) + opponent_count; }
+
+    bool operator==(CanonicalBoard const& other) const {
+        return own_count == other.own_count && opponent_count == other.opponent_count && positions == other.positions;
+    }
+    bool operator!=(CanonicalBoard const& other) const { return !(*this == other); }
+
+private:
+    static std::int16_t Quantize(float value) {
+        return static_cast<std::int16_t>(std::lround(value / kResolution));
+    }
+};
+
+static_assert(std::is_trivially_copyable_v<CanonicalBoard>);
+
+} // namespace digitalcurling::client
@@ -3,14 +3,18 @@
 
 #pragma once
 
+#include <atomic>
 #include <string>
 #include <vector>
 #include <memory>
 #include <functional>
+#include <future>
 
 #include <httplib.h>
 #include <digitalcurling/digitalcurling.hpp>
+#include "digitalcurling/client/event_cursor.hpp"
 #include "digitalcurling/client/protocol_models.hpp"
+#include "digitalcurling/client/thinking_context.hpp"
 
 namespace digitalcurling::client {
 
@@ -32,6 +36,10 @@ struct ClientConnectSetting {
     std::chrono::milliseconds retry_wait_time = std::chrono::seconds(5);
     /// @brief コールバック関数
     Callback callback;
+    /// @brief 最初のイベントを処理する前に完了を待つ処理 (思考エンジンの準備など)
+    std::shared_future<void> ready;
+    /// @brief 着手の期限を決める際に、残り思考時間から差し引く余裕 (通信の遅延など)
+    std::chrono::milliseconds think_time_margin = std::chrono::milliseconds(500);
 };
 
 class ClientBase {
@@ -66,6 +74,11 @@ public:
     /// @return 参加したチーム
     Team JoinGame(Team const& team, std::string const& auth_id, std::string const& auth_pw);
 
+    /// @brief 思考エンジンの準備処理を行う
+    ///
+    /// `JoinGame()` や `Connect()` と並行して呼び出すことができる。
+    void WarmUp();
+
     /// @brief サーバーに接続する
     /// @param setting 接続設定
     void Connect(ClientConnectSetting const& setting = {});
@@ -84,6 +97,9 @@ protected:
     /// @return プレイヤーの投球順のリスト
     virtual std::vector<std::uint8_t> GetPlayersIndex() const = 0;
 
+    /// @brief 思考エンジンの準備処理
+    virtual void OnWarmUp() = 0;
+
     /// @brief ゲーム開始の通知
     /// @param team 自チーム
     /// @param states これまでの試合状況とショットの履歴
@@ -97,6 +113,9 @@ protected:
     virtual void OnNextEnd(StateUpdateEventData const& event_data) = 0;
 
     /// @brief 自チームのターンのアクション
+    ///
+    /// イベント処理とは別のスレッドで呼び出される。実行中の思考の状態は `ThinkingContext::GetCurrent()` で取得できる。
+    /// 思考中に試合状況が変わった場合は思考が取り消され、他の通知は思考が戻るまで待たされる。
     /// @param[in] game_state 現在の試合状況
     /// @return 行動
     virtual moves::Move OnMyTurn(StateUpdateEventData const& event_data) = 0;
@@ -109,7 +128,37 @@ protected:
     /// @param[in] game_state 現在の試合状況
     virtual void OnGameOver(StateUpdateEventData const& event_data) = 0;
 
+    /// @brief 思考を別のスレッドで開始する
+    ///
+    /// `think` はイベント処理とは別のスレッドで呼び出され、返した関数は思考の完了後にイベント処理のスレッドで呼び出される。
+    /// 思考中に試合状況が変わった場合は思考が取り消され、他の通知は思考が戻るまで待たされる。
+    /// `OnNextEnd()` から呼び出した場合、そのイベントでは `OnOpponentTurn()` を通知しない。
+    /// 期限までに思考が終わらなかった場合は `fallback` で暫定の結果を送信し、思考を取り消す。
+    /// @param[in] event_data イベントデータ (残り思考時間から期限を決める)
+    /// @param[in] think 思考を行い、結果を送信する関数を返す関数
+    /// @param[in] fallback 期限を過ぎた際にイベント処理のスレッドで暫定の結果を送信する関数 (送信できなければ `false` を返し、思考の完了を待つ)
+    void StartThinking(
+        StateUpdateEventData const& event_data,
+        std::function<std::function<void()>()> think,
+        std::function<bool(ThinkingContext const&)> fallback);
+
 private:
+    /// @brief 実行中の自チームのターンの思考
+    struct PendingTurn {
+        /// @brief 思考の状態
+        std::shared_ptr<ThinkingContext> context;
+        /// @brief 思考の結果を送信する関数
+        std::future<std::function<void()>> future;
+        /// @brief 期限を過ぎた際に暫定の結果を送信する関数
+        std::function<bool(ThinkingContext const&)> fallback;
+        /// @brief 思考の開始時刻
+        std::chrono::steady_clock::time_point start;
+        /// @brief 暫定の最善手を投げる期限 (処理済みなら `std::nullopt`)
+        std::optional<std::chrono::steady_clock::time_point> deadline;
+        /// @brief 行動を送信済みなら `true`
+        bool is_submitted;
+    };
+
     httplib::Headers sse_headers_;
 
     digitalcurling::GameRuleType rule_type_;
@@ -117,9 +166,21 @@ private:
     nlohmann::json players_;
     Team current_hammer_;
 
-    bool is_first_update_ = true;
+    std::atomic<bool> is_first_update_ = true;
     std::vector<std::pair<digitalcurling::GameState, std::optional<moves::Shot>>> states_;
 
+    /// @brief 処理済みの `latest_state_update` イベントの位置
+    EventCursorFilter latest_filter_;
+    /// @brief 処理済みの `state_update` イベントの位置
+    EventCursorFilter history_filter_;
+
+    /// @brief 実行中の思考 (イベント処理スレッドのみが操作する)
+    std::optional<PendingTurn> pending_turn_;
+    /// @brief 着手の期限を決める際の余裕
+    std::chrono::milliseconds think_time_margin_ {};
+    /// @brief イベント処理スレッドにイベントを追加する関数 (接続中のみ有効)
+    std::function<void(std::string, std::function<void()>)> push_event_;
+
     /// @brief SSEの `latest_state_update` イベントを処理する
     /// @param[in] message メッセージ
     void OnReceiveLatestStateUpdateEvent(StateUpdateEventData const& event_data);
@@ -128,6 +189,24 @@ private:
     /// @param[in] message メッセージ
     void OnReceiveStateUpdateEvent(StateUpdateEventData const& event_data);
 
+    /// @brief 自チームのターンの思考を別のスレッドで開始する
+    /// @param[in] event_data イベントデータ
+    void StartTurn(StateUpdateEventData const& event_data);
+
+    /// @brief 思考の完了を処理し、送信していなければ行動を送信する
+    /// @param[in] context 完了した思考の状態
+    void FinishTurn(std::shared_ptr<ThinkingContext> const& context);
+
+    /// @brief 期限を過ぎた思考を打ち切り、暫定の結果を送信する
+    void OnTurnDeadline();
+
+    /// @brief 実行中の思考を取り消し、終了を待つ
+    void CancelTurn();
+
+    /// @brief 行動をサーバーに送信する
+    /// @param[in] move 行動
+    void PostMove(moves::Move const& move);
+
     StateUpdateEventData ParseStateUpdateEventData(httplib::sse::SSEMessage const& message);
 };
 
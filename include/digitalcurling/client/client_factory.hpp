@@ -3,16 +3,55 @@
 
 #pragma once
 
+#include <filesystem>
 #include <memory>
+#include <optional>
 #include <string>
 #include "digitalcurling/client/client_base.hpp"
 #include "digitalcurling/client/i_factory_creator.hpp"
 #include "digitalcurling/client/i_thinking_engine.hpp"
+#include "digitalcurling/client/protocol_models.hpp"
 
 namespace digitalcurling::client {
 
+/// @brief 接続先の試合
+struct MatchEndpoint {
+    /// @brief スキームを含むホスト
+    std::string host;
+    /// @brief ゲームID
+    std::string id;
+    /// @brief 試合情報
+    MatchInfo match_info;
+};
+
 class ClientFactory {
 public:
+    /// @brief サーバーから試合情報を取得する
+    ///
+    /// スキームを省略した場合は https と http を同時に試し、最初に応答した方を採用する。
+    /// キャッシュファイルを指定した場合は、ホストごとに解決したスキームを記録し、
+    /// 次回以降はそのスキームを先に試す。
+    /// @param host サーバーのホスト名
+    /// @param id ゲームID
+    /// @param cache_path 解決したスキームを記録するファイルのパス
+    /// @return 接続先の試合
+    static MatchEndpoint GetMatch(
+        std::string const& host,
+        std::string const& id,
+        std::optional<std::filesystem::path> const& cache_path = std::nullopt
+    );
+
+    /// @brief 取得済みの試合情報からクライアントを生成する
+    /// @param endpoint 接続先の試合
+    /// @param engine 思考エンジン
+    /// @param factory_creator プレイヤーとシミュレータの変換を行うオブジェクト
+    /// @return クライアントのインスタンス
+    static std::unique_ptr<ClientBase> CreateClient(
+        MatchEndpoint endpoint,
+        std::unique_ptr<IThinkingEngine> engine,
+        std::unique_ptr<IFactoryCreator> factory_creator
+    );
+
     /// @brief 思考エンジンを生成する
     /// @return 思考エンジンのインスタンス
     static std::unique_ptr<ClientBase> CreateClient(
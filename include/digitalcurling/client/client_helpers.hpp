@@ -12,6 +12,7 @@
 #include <digitalcurling/moves/shot.hpp>
 #include <digitalcurling/rules/i_additional_rule.hpp>
 #include <digitalcurling/simulators/i_simulator.hpp>
+#include "digitalcurling/client/profiler.hpp"
 
 namespace digitalcurling::client {
 
@@ -24,6 +25,14 @@ struct ShotInfo {
     digitalcurling::moves::Shot shot;
 };
 
+/// @brief 1エンドのショット数を返す
+/// @param rule_type 試合ルールの種類
+/// @return 1エンドのショット数
+inline std::uint8_t GetShotsPerEnd(GameRuleType rule_type) {
+    // ミックスダブルスは配置済みのストーンを除き、各チーム5投
+    return rule_type == GameRuleType::kMixedDoubles ? 10 : 16;
+}
+
 /// @brief 盤面をシミュレータ用のストーン配列に変換する
 /// @param stone_coordinate 変換元の盤面
 /// @return シミュレータ用のストーン配列
@@ -65,6 +74,7 @@ inline bool IsVaildStone(Stone const& stone, float sheet_width) {
 /// @param simulator シミュレーター
 /// @param sheet_width シートの幅
 inline void SimulateFull(simulators::ISimulator* simulator, float sheet_width) {
+    PROFILE_ZONE("SimulateFull");
     do {
         simulator->Step();
 
@@ -0,0 +1,121 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: Unlicense
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <type_traits>
+#include <digitalcurling/stone_coordinate.hpp>
+#include <digitalcurling/simulators/i_simulator.hpp>
+
+namespace digitalcurling::client {
+
+/// @brief 固定長の盤面
+///
+/// ストーンの有無と位置のみを保持する。トリビアルにコピー可能であり、
+/// 共有メモリやネットワーク越しにそのまま受け渡すことができる。
+/// ストーンのインデックスは `StoneCoordinate::GetAllStones()` と同じ (チーム0の8個、チーム1の8個の順)。
+struct CompactBoard {
+    static constexpr std::size_t kStoneCount = 16;
+
+    /// @brief ストーンが存在するかのビットマスク
+    std::uint16_t occupied = 0;
+    /// @brief ストーンのx座標
+    std::array<float, kStoneCount> x {};
+    /// @brief ストーンのy座標
+    std::array<float, kStoneCount> y {};
+
+    /// @brief ストーンが存在するかを返す
+    /// @param index ストーンのインデックス
+    /// @return 存在するなら `true`
+    bool HasStone(std::size_t index) const { return (occupied >> index) & 1u; }
+
+    /// @brief ストーンの位置を返す
+    /// @param index ストーンのインデックス
+    /// @return ストーンの位置
+    Vector2 GetPosition(std::size_t index) const { return Vector2 { x[index], y[index] }; }
+
+    /// @brief ストーンを置く
+    /// @param index ストーンのインデックス
+    /// @param position ストーンの位置
+    void SetStone(std::size_t index, Vector2 const& position) {
+        occupied |= static_cast<std::uint16_t>(1u << index);
+        x[index] = position.x;
+        y[index] = position.y;
+    }
+
+    /// @brief ストーンを取り除く
+    /// @param index ストーンのインデックス
+    void RemoveStone(std::size_t index) {
+        occupied &= static_cast<std::uint16_t>(~(1u << index));
+        x[index] = 0.f;
+        y[index] = 0.f;
+    }
+
+    /// @brief 次に投げるストーンのインデックスを返す
+    /// @param team チーム
+    /// @return 盤面にない最初のストーンのインデックス (全て盤面にある場合は `std::nullopt`)
+    std::optional<std::uint8_t> FindFreeStoneIndex(Team team) const {
+        auto const begin = static_cast<std::size_t>(team) * 8;
+        for (auto i = begin; i < begin + 8; ++i) {
+            if (!HasStone(i)) return static_cast<std::uint8_t>(i);
+        }
+        return std::nullopt;
+    }
+
+    /// @brief 盤面から変換する
+    /// @param stone_coordinate 盤面
+    /// @return 変換した盤面
+    static CompactBoard FromStoneCoordinate(StoneCoordinate const& stone_coordinate) {
+        CompactBoard board;
+        auto const stones = stone_coordinate.GetAllStones();
+        for (std::size_t i = 0; i < kStoneCount; ++i) {
+            if (stones[i].has_value()) board.SetStone(i, stones[i]->position);
+        }
+        return board;
+    }
+
+    /// @brief シミュレータのストーン配列から変換する
+    /// @param stones シミュレータのストーン配列
+    /// @return 変換した盤面
+    static CompactBoard FromSimulatorStones(simulators::ISimulator::AllStones const& stones) {
+        CompactBoard board;
+        for (std::size_t i = 0; i < kStoneCount; ++i) {
+            if (stones[i].has_value()) board.SetStone(i, stones[i]->position);
+        }
+        return board;
+    }
+
+    /// @brief シミュレータ用の静止したストーン配列に変換する
+    /// @return シミュレータ用のストーン配列
+    simulators::ISimulator::AllStones ToSimulatorStones() const {
+        simulators::ISimulator::AllStones stones;
+        for (std::size_t i = 0; i < kStoneCount; ++i) {
+            if (HasStone(i)) {
+                stones[i] = simulators::ISimulator::StoneState(GetPosition(i), 0.f, Vector2 { 0.f, 0.f }, 0.f);
+            }
+        }
+        return stones;
+    }
+
+    /// @brief 盤面に変換する
+    /// @return 盤面
+    StoneCoordinate ToStoneCoordinate() const {
+        std::array<std::optional<Stone>, kStoneCount> stones;
+        for (std::size_t i = 0; i < kStoneCount; ++i) {
+            if (HasStone(i)) stones[i] = Stone { GetPosition(i), 0.f };
+        }
+        return StoneCoordinate(stones);
+    }
+
+    bool operator==(CompactBoard const& other) const {
+        return occupied == other.occupied && x == other.x && y == other.y;
+    }
+    bool operator!=(CompactBoard const& other) const { return !(*this == other); }
+};
+
+static_assert(std::is_trivially_copyable_v<CompactBoard>);
+
+} // namespace digitalcurling::client
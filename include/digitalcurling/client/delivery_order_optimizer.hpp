@@ -0,0 +1,117 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: Unlicense
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+#include <digitalcurling/digitalcurling.hpp>
+#include "digitalcurling/client/playout.hpp"
+#include "digitalcurling/client/simulation_evaluator.hpp"
+
+namespace digitalcurling::client {
+
+/// @brief プレイヤーの誤差の特性
+struct PlayerProfile {
+    /// @brief 性別
+    players::Gender gender = players::Gender::kUnknown;
+    /// @brief 初速の誤差の標準偏差
+    float speed_stddev = 0.f;
+    /// @brief リリース角度の誤差の標準偏差
+    float angle_stddev = 0.f;
+
+    /// @brief プレイヤーにショットを繰り返させて特性を測定する
+    /// @param factory プレイヤーのファクトリー
+    /// @param samples ショットの回数
+    /// @return 特性
+    static PlayerProfile Measure(players::IPlayerFactory const& factory, std::size_t samples);
+};
+
+/// @brief 投球順の探索の設定
+struct DeliveryOrderSearchSetting {
+    /// @brief 1回にまとめて評価する投球順ごとのエンド数
+    std::uint32_t ends_per_round = 16;
+    /// @brief 投球順ごとのエンド数の上限
+    std::uint32_t max_ends = 1024;
+    /// @brief 探索時間の上限
+    std::chrono::milliseconds time_budget { 5000 };
+    /// @brief プレイヤーの特性の測定に用いるショットの回数
+    std::size_t profile_samples = 4096;
+};
+
+/// @brief 投球順を最適化する
+///
+/// ルールで許される全ての投球順 (ミックスでは男女が交互になる順) について、
+/// 空の盤面から1エンドをプレイアウトし、自チームの平均得点が最も高い投球順を選ぶ。
+/// 相手チームは同じプレイヤーを既定の順で用い、ハンマーは交互に持たせる。
+/// 明らかに劣る投球順は途中で打ち切り、結果はプレイヤーの特性の組み合わせごとにキャッシュする。
+class DeliveryOrderOptimizer {
+public:
+    using Setting = DeliveryOrderSearchSetting;
+
+    /// @brief 最適化の結果
+    struct Result {
+        /// @brief 投球順 (プレイヤーのインデックス)
+        std::vector<std::uint8_t> order;
+        /// @brief 1エンドあたりの自チームの平均得点
+        float value = 0.f;
+        /// @brief 評価に用いたエンド数
+        std::uint32_t ends = 0;
+        /// @brief キャッシュから答えたなら `true`
+        bool from_cache = false;
+    };
+
+    /// @brief コンストラクタ
+    /// @param game_rule 試合ルール
+    /// @param evaluator 評価器
+    /// @param simulator 候補ショットの計算に用いるシミュレーター
+    /// @param cache_path キャッシュのファイルのパス (空なら保存しない)
+    /// @param setting 探索の設定
+    DeliveryOrderOptimizer(
+        GameRule const& game_rule,
+        ISimulationEvaluator& evaluator,
+        simulators::IInvertibleSimulator& simulator,
+        std::filesystem::path cache_path = {},
+        Setting const& setting = {}
+    );
+
+    /// @brief 投球順を最適化する
+    /// @param players プレイヤーのファクトリー
+    /// @return 最適化の結果
+    /// @exception std::runtime_error ルールを満たす投球順がない場合
+    Result Optimize(std::vector<std::unique_ptr<players::IPlayerFactory>> const& players);
+
+    /// @brief ルールで許される投球順を列挙する
+    /// @param rule_type 試合ルールの種類
+    /// @param genders 各プレイヤーの性別
+    /// @return 投球順
+    static std::vector<std::vector<std::uint8_t>> EnumerateOrders(GameRuleType rule_type, std::vector<players::Gender> const& genders);
+
+private:
+    GameRule game_rule_;
+    ISimulationEvaluator& evaluator_;
+    std::filesystem::path cache_path_;
+    Setting setting_;
+    PlayoutRunner playout_runner_;
+
+    std::string GetCacheKey(std::vector<PlayerProfile> const& profiles) const;
+};
+
+/// @brief 投球順の最適化の設定
+struct DeliveryOrderSetting {
+    /// @brief キャッシュのファイルのパス
+    std::filesystem::path cache_path;
+
+    /// @brief インスタンスを返す
+    /// @return インスタンス
+    static DeliveryOrderSetting& GetInstance() {
+        static DeliveryOrderSetting instance;
+        return instance;
+    }
+};
+
+} // namespace digitalcurling::client
@@ -0,0 +1,246 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: Unlicense
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+#include <digitalcurling/digitalcurling.hpp>
+#include "digitalcurling/client/canonical_board.hpp"
+#include "digitalcurling/client/compact_board.hpp"
+#include "digitalcurling/client/metrics.hpp"
+#include "digitalcurling/client/multi_fidelity_evaluator.hpp"
+#include "digitalcurling/client/search_tree.hpp"
+#include "digitalcurling/client/simulation_evaluator.hpp"
+#include "digitalcurling/client/turn_arena.hpp"
+#include "digitalcurling/client/win_probability_table.hpp"
+
+namespace digitalcurling::client {
+
+/// @brief エンドゲームの盤面以外のキー
+struct EndgameKey {
+    /// @brief 期待得点を最大化する場合の `objective`
+    static constexpr std::int8_t kExpectedScore = -128;
+
+    /// @brief エンド内のショット番号
+    std::uint8_t shot = 0;
+    /// @brief エンドの残りショット数 (このショットを含む)
+    std::uint8_t shots_remaining = 0;
+    /// @brief 目的 (`kExpectedScore` または勝率を最大化する場合の手番のチームから見た得点差)
+    std::int8_t objective = kExpectedScore;
+    /// @brief 勝率を最大化する場合の規定の残りエンド数 (ハンマーは残りショット数から決まる)
+    std::uint8_t ends_remaining = 0;
+
+    auto Tie() const { return std::tie(shot, shots_remaining, objective, ends_remaining); }
+    bool operator==(EndgameKey const& other) const { return Tie() == other.Tie(); }
+};
+
+/// @brief エンドゲームのテーブルのエントリ (ファイル上の形式)
+struct EndgameTableEntry {
+    /// @brief 盤面のハッシュ値
+    std::uint64_t board_hash = 0;
+    /// @brief ショットの初速
+    float translational_velocity = 0.f;
+    /// @brief ショットの角速度
+    float angular_velocity = 0.f;
+    /// @brief ショットのリリース角度
+    float release_angle = 0.f;
+    /// @brief 手番のチームから見た評価値
+    float value = 0.f;
+    /// @brief 評価に用いた試行回数
+    std::uint32_t trials = 0;
+    /// @brief キー
+    EndgameKey key;
+    /// @brief 盤面
+    CanonicalBoard board;
+    std::uint8_t reserved[6] {};
+
+    /// @brief ショットを返す
+    /// @return ショット
+    moves::Shot GetShot() const {
+        return moves::Shot(translational_velocity, angular_velocity, release_angle);
+    }
+};
+
+static_assert(std::is_trivially_copyable_v<EndgameTableEntry>);
+static_assert(sizeof(EndgameTableEntry) == 104);
+
+/// @brief 解いた盤面を保存するテーブル
+///
+/// 起動時にファイルの全エントリを読み込み、以降に解いた盤面はファイルの末尾に追記する。
+/// 追記中に終了して末尾が欠けている場合、欠けたエントリは無視する。スレッドセーフである。
+class EndgameTable {
+public:
+    EndgameTable() = default;
+
+    /// @brief テーブルのファイルを開く (存在しない場合は作成する)
+    /// @param path ファイルのパス
+    /// @param sheet_width シートの幅
+    /// @exception std::runtime_error ファイルを開けない場合や、形式やシートの幅が異なる場合
+    EndgameTable(std::filesystem::path const& path, float sheet_width);
+
+    /// @brief ファイルを開いているかを返す
+    /// @return 開いているなら `true`
+    bool IsOpen() const { return is_open_; }
+
+    /// @brief エントリ数を返す
+    /// @return エントリ数
+    std::size_t GetEntryCount() const;
+
+    /// @brief エントリを検索する
+    /// @param key キー
+    /// @param board 正規化した盤面
+    /// @return エントリ (見つからない場合は `std::nullopt`)
+    std::optional<EndgameTableEntry> Find(EndgameKey const& key, CanonicalBoard const& board) const;
+
+    /// @brief エントリを追加してファイルに追記する
+    /// @param entry エントリ
+    void Add(EndgameTableEntry const& entry);
+
+private:
+    mutable std::mutex mutex_;
+    bool is_open_ = false;
+    std::ofstream ofs_;
+    std::unordered_map<std::uint64_t, std::vector<EndgameTableEntry>> entries_;
+    std::size_t entry_count_ = 0;
+};
+
+/// @brief エンドゲームの探索の設定
+struct EndgameSearchSetting {
+    /// @brief ドローの格子の間隔 [m]
+    float grid_step = 0.15f;
+    /// @brief 全候補の試行回数
+    std::uint32_t coarse_trials = 16;
+    /// @brief 再評価する候補数
+    std::uint32_t refine_count = 32;
+    /// @brief 再評価の試行回数
+    std::uint32_t refine_trials = 256;
+    /// @brief 残り2投の場合のドローの格子の間隔 [m] (自分と相手の両方)
+    float two_shot_grid_step = 0.6f;
+    /// @brief 残り2投の場合の全候補の試行回数
+    std::uint32_t two_shot_coarse_trials = 4;
+    /// @brief 残り2投の場合の再評価の試行回数
+    std::uint32_t two_shot_refine_trials = 16;
+    /// @brief 残り2投の場合の相手の候補ごとの試行回数
+    std::uint32_t reply_trials = 2;
+    /// @brief 粗いシミュレーターで絞り込む場合のドローの格子の間隔の倍率
+    float screening_grid_scale = 0.5f;
+    /// @brief 粗いシミュレーターで絞り込む場合に再評価する候補数の上限
+    std::uint32_t screening_max_refine_count = 64;
+};
+
+/// @brief エンドの最後の1投または2投を解く
+///
+/// ハウス内を密に覆うドローの格子と、各ストーンへのヒットを候補とし、全ての候補を誤差付きでまとめて評価する。
+/// 評価値の高い候補は試行回数を増やして再評価し、最善のショットを選ぶ。
+/// 粗いシミュレーターがある場合は、格子を細かくした全候補をそれで評価し、誤差の範囲内の候補のみを通常のシミュレーターで再評価する。
+/// 残り2投の場合は、各試行の盤面について相手の最後の1投を粗い格子で解き、その最善手を前提に評価する。
+/// 解いた盤面はテーブルに保存し、同じ盤面には探索せずに答える。
+class EndgameSolver {
+public:
+    /// @brief 解くことのできる残りショット数の上限
+    static constexpr std::uint8_t kMaxShotsRemaining = 2;
+
+    using Setting = EndgameSearchSetting;
+
+    /// @brief 解の情報
+    struct Result {
+        /// @brief 最善のショット
+        moves::Shot shot;
+        /// @brief 手番のチームから見た評価値 (期待得点または勝率)
+        float value = 0.f;
+        /// @brief 評価に用いた試行回数
+        std::uint32_t trials = 0;
+        /// @brief テーブルから答えたなら `true`
+        bool from_table = false;
+    };
+
+    /// @brief コンストラクタ
+    /// @param game_rule 試合ルール
+    /// @param evaluator 評価器
+    /// @param simulator 候補ショットの計算に用いるシミュレーター
+    /// @param table 解を保存するテーブル (`nullptr` なら保存しない)
+    /// @param win_probability 試合の勝率表 (`nullptr` なら常に期待得点を最大化する)
+    /// @param multi_fidelity 粗いシミュレーターによる絞り込み (`nullptr` なら全候補を評価器で評価する)
+    /// @param setting 探索の設定
+    EndgameSolver(
+        GameRule const& game_rule,
+        ISimulationEvaluator& evaluator,
+        simulators::IInvertibleSimulator& simulator,
+        EndgameTable* table = nullptr,
+        WinProbabilityTable const* win_probability = nullptr,
+        MultiFidelityEvaluator* multi_fidelity = nullptr,
+        Setting const& setting = {}
+    );
+
+    /// @brief 盤面を解く
+    ///
+    /// `situation` を指定した場合は、エンドの得点を勝率表で試合の勝率に変換して最大化する。
+    /// 指定しないか勝率表がない場合は、このエンドの期待得点を最大化する。
+    /// @param board 盤面
+    /// @param team 手番のチーム
+    /// @param end エンド
+    /// @param shot エンド内のショット番号
+    /// @param shots_remaining エンドの残りショット数 (このショットを含む)
+    /// @param player ショットを行うプレイヤー (相手のショットにも用いる)
+    /// @param situation 手番のチームから見た試合状況
+    /// @param tree 残り2投の場合に、ショットの各試行の盤面と相手の応手を前提とした評価値を子ノードとして記録する探索木
+    ///             (ルートが `board` でなければ作り直す。`nullptr` なら記録しない)
+    /// @return 解 (`shots_remaining` が範囲外の場合や、思考が取り消された場合は `std::nullopt`)
+    std::optional<Result> Solve(
+        CompactBoard const& board,
+        Team team,
+        std::uint8_t end,
+        std::uint8_t shot,
+        std::uint8_t shots_remaining,
+        players::IPlayer& player,
+        std::optional<WinProbabilityKey> situation = std::nullopt,
+        SearchTree<>* tree = nullptr
+    );
+
+private:
+    struct Objective;
+
+    GameRule game_rule_;
+    ISimulationEvaluator& evaluator_;
+    simulators::IInvertibleSimulator& simulator_;
+    EndgameTable* table_;
+    WinProbabilityTable const* win_probability_;
+    MultiFidelityEvaluator* multi_fidelity_;
+    Setting setting_;
+    CacheMetrics& table_metrics_;
+
+    // 探索の一時的な配列は全てターンのアリーナから確保する
+    ArenaVector<moves::Shot> GenerateCandidates(CompactBoard const& board, float grid_step) const;
+    ArenaVector<double> EvaluateCandidates(
+        ISimulationEvaluator& evaluator,
+        CompactBoard const& board, Team team, std::uint8_t end, std::uint8_t shots_remaining,
+        ArenaVector<moves::Shot> const& candidates, std::uint32_t trials, players::IPlayer& player,
+        Objective const& objective, SearchTree<>* tree);
+    ArenaVector<CompactBoard> Simulate(
+        ISimulationEvaluator& evaluator,
+        ArenaVector<CompactBoard> const& boards, Team team, std::uint8_t end,
+        ArenaVector<ArenaVector<moves::Shot>> const& candidates, std::uint32_t trials, players::IPlayer& player);
+};
+
+/// @brief エンドゲームの設定
+struct EndgameSolverSetting {
+    /// @brief テーブルのファイルのパス
+    std::filesystem::path table_path;
+
+    /// @brief インスタンスを返す
+    /// @return インスタンス
+    static EndgameSolverSetting& GetInstance() {
+        static EndgameSolverSetting instance;
+        return instance;
+    }
+};
+
+} // namespace digitalcurling::client
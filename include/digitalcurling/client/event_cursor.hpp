@@ -0,0 +1,78 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: Unlicense
+
+#pragma once
+
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <tuple>
+#include <digitalcurling/digitalcurling.hpp>
+
+namespace digitalcurling::client {
+
+/// @brief 試合状況の更新イベントの位置
+struct EventCursor {
+    /// @brief エンド番号
+    int end;
+    /// @brief エンド内の通算ショット数
+    int total_shot;
+    /// @brief 次の手番のチームが決まっているか (ミックスダブルスのエンド開始前は `false`)
+    bool has_next_team;
+
+    bool operator<=(EventCursor const& other) const {
+        return std::tie(end, total_shot, has_next_team) <= std::tie(other.end, other.total_shot, other.has_next_team);
+    }
+    bool operator==(EventCursor const& other) const {
+        return std::tie(end, total_shot, has_next_team) == std::tie(other.end, other.total_shot, other.has_next_team);
+    }
+};
+
+/// @brief イベントデータを解析せずに読み取った、イベントの位置と手番
+struct EventHeader {
+    /// @brief イベントの位置 (読み取れなかった場合は `std::nullopt`)
+    std::optional<EventCursor> cursor;
+    /// @brief 次の手番のチーム (決まっていなければ `Team::kInvalid`)
+    Team next_team = Team::kInvalid;
+    /// @brief 試合終了のイベントなら `true`
+    bool is_game_over = false;
+
+    /// @brief イベントデータ (JSON文字列) の最上位のキーから位置と手番を読み取る
+    /// @param[in] data イベントデータ
+    /// @return 読み取った結果
+    static EventHeader Peek(std::string_view data);
+};
+
+/// @brief 再接続時に再送された処理済みのイベントを判定する
+///
+/// 位置はイベントの処理が成功した後に `Commit()` で進める。処理に失敗したイベントは
+/// 再送されたときに再び処理される。自チームの手番のイベントは、行動を送信するまで
+/// 同じ位置でも処理済みとみなさない (行動の送信に失敗した後の再送で、手番を失わないため)。
+/// `IsProcessed()` と他の関数は別のスレッドから呼び出せる。
+class EventCursorFilter {
+public:
+    /// @brief 処理済みのイベントかを返す
+    /// @param[in] header イベントの位置と手番
+    /// @param[in] own_team 自チーム (手番の例外を設けない場合は `Team::kInvalid`)
+    /// @return 破棄すべきイベントなら `true`
+    bool IsProcessed(EventHeader const& header, Team own_team = Team::kInvalid) const;
+
+    /// @brief 最後に処理したイベントと同じ位置かを返す
+    /// @param[in] header イベントの位置と手番
+    /// @return 同じ位置なら `true`
+    bool IsLatest(EventHeader const& header) const;
+
+    /// @brief イベントの処理の成功を記録し、位置を進める
+    /// @param[in] header イベントの位置と手番
+    void Commit(EventHeader const& header);
+
+    /// @brief 最後に処理したイベントの手番の行動を送信したことを記録する
+    void MarkMovePosted();
+
+private:
+    mutable std::mutex mutex_;
+    std::optional<EventCursor> cursor_;
+    bool is_move_posted_ = false;
+};
+
+} // namespace digitalcurling::client
@@ -0,0 +1,232 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: Unlicense
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+#include <digitalcurling/moves/shot.hpp>
+#include <digitalcurling/simulators/i_simulator_factory.hpp>
+#include "digitalcurling/client/compact_board.hpp"
+#include "digitalcurling/client/object_pool.hpp"
+#include "digitalcurling/client/thread_pool.hpp"
+
+namespace digitalcurling::client {
+
+/// @brief 他のストーンに触れないショットの軌跡のモデルの設定
+struct FreePathSetting {
+    /// @brief 表に含める初速の下限 [m/s]
+    float min_speed = 0.5f;
+    /// @brief 表に含める初速の上限 [m/s]
+    float max_speed = 4.5f;
+    /// @brief 表の初速の間隔 [m/s]
+    float speed_step = 0.02f;
+    /// @brief 表に含める角速度 [rad/s] (これ以外の角速度のショットはシミュレーションする)
+    std::vector<float> angular_velocities { -1.57f, 1.57f };
+    /// @brief 軌跡を記録する間隔 [フレーム]
+    std::uint32_t sample_frames = 10;
+    /// @brief 軌跡と他のストーンやシートの境界との間に空ける余裕 [m]
+    float clearance = 0.02f;
+    /// @brief 他のストーンに触れないショットの結果を表から予測するなら `true`
+    ///
+    /// 予測した停止位置は補間の誤差だけ変わるため、既定では用いない。
+    /// 用いない場合も、動きうるストーンの判定と途中の状態には表を用いる。
+    bool use_prediction = false;
+    /// @brief 精度の検証に用いるショットの数
+    std::size_t validation_count = 512;
+    /// @brief 許容する停止位置の誤差 [m] (検証での最大誤差がこれを超えた場合はモデルを使わない)
+    float tolerance = 0.01f;
+    /// @brief 動きうるストーンを求める際に、止まるまでの距離に加える余裕 (距離に対する割合)
+    float reach_margin = 0.1f;
+    /// @brief 動きうるストーンのみのシミュレーションの検証に用いる盤面の数
+    std::size_t active_validation_count = 256;
+    /// @brief 投げたストーンの途中の状態からシミュレーションを始めるなら `true`
+    ///
+    /// 途中の状態は表の補間で求めるため、結果が補間の誤差だけ変わる。既定では用いない。
+    bool use_checkpoints = false;
+    /// @brief 途中の状態の検証に用いるショットの数
+    std::size_t checkpoint_validation_count = 256;
+    /// @brief 許容する途中の状態の速度の誤差 [m/s] (検証での最大誤差がこれを超えた場合は途中から始めない)
+    float velocity_tolerance = 0.002f;
+};
+
+/// @brief 精度の検証の結果
+struct FreePathValidation {
+    /// @brief 予測できたショットの数
+    std::size_t predicted_count = 0;
+    /// @brief 停止位置の誤差の最大値 [m] (盤面に残るかの予測を誤った場合は無限大)
+    float max_error = 0.f;
+    /// @brief 停止位置の誤差の二乗平均平方根 [m]
+    float rms_error = 0.f;
+};
+
+/// @brief 動きうるストーンのみのシミュレーションの検証の結果
+struct ActiveStonesValidation {
+    /// @brief 全てのストーンでのシミュレーションと結果が一致しなかった盤面の数
+    std::size_t mismatch_count = 0;
+    /// @brief 投げるストーン以外のストーン数ごとの盤面の数
+    std::array<std::size_t, CompactBoard::kStoneCount> counts {};
+    /// @brief ストーン数ごとの、全てのストーンでのシミュレーションの時間の合計 [s]
+    std::array<double, CompactBoard::kStoneCount> full_seconds {};
+    /// @brief ストーン数ごとの、動きうるストーンのみのシミュレーションの時間の合計 [s]
+    std::array<double, CompactBoard::kStoneCount> active_seconds {};
+};
+
+/// @brief 途中の状態の検証の結果
+struct CheckpointValidation {
+    /// @brief 比較した状態の数
+    std::size_t count = 0;
+    /// @brief 位置の誤差の最大値 [m]
+    float max_position_error = 0.f;
+    /// @brief 速度の誤差の最大値 [m/s]
+    float max_velocity_error = 0.f;
+};
+
+/// @brief 他のストーンに触れないショットの結果をシミュレーションせずに求めるモデル
+///
+/// 何もないシートで初速ごとにシミュレーションした軌跡を表として持ち、初速で線形補間する。
+/// ストーンの運動はリリース角度について回転対称であるため、表は基準の向きの1方向のみを持ち、
+/// ショットの向きに回転して用いる。
+/// 補間に用いる両側の軌跡が他のストーンから十分に離れている場合のみ予測し、
+/// それ以外の場合はシミュレーションに任せる。
+/// シミュレーションする場合も、軌跡と止まるまでの距離から動きうるストーンを求め、それ以外のストーンを省ける。
+/// 予測、動きうるストーン、途中の状態はそれぞれ独立に検証し、検証に失敗したもののみを用いない。
+/// また、表の軌跡を最初に触れうる位置の手前の状態 (チェックポイント) として用い、そこからシミュレーションを始められる。
+/// 誤差を加えたショットは初速とリリース角度のみが異なるため、表の補間と回転でその時点の状態に写せる。
+/// 生成後は変更しないため、複数のスレッドから同時に予測できる。
+class FreePathModel {
+public:
+    using Setting = FreePathSetting;
+
+    /// @brief 表を作成し、精度を検証する
+    /// @param factory シミュレーターのファクトリー
+    /// @param simulator_pool `factory` のシミュレーターのプール
+    /// @param thread_pool 表の作成に用いるスレッドプール
+    /// @param sheet_width シートの幅
+    /// @param setting 設定
+    /// @return モデル (検証で全ての用途が無効になった場合は `nullptr`)
+    static std::unique_ptr<FreePathModel> Fit(
+        simulators::ISimulatorFactory const& factory,
+        SimulatorPool& simulator_pool,
+        ThreadPool& thread_pool,
+        float sheet_width,
+        Setting const& setting = {}
+    );
+
+    /// @brief ショット後の盤面を予測する
+    /// @param board ショット前の盤面
+    /// @param stone_index 投げるストーンのインデックス
+    /// @param shot ショット (誤差を加えた後のもの)
+    /// `Setting::use_prediction` が `false` の場合や、作成時の検証で誤差が許容範囲を超えた場合は予測しない。
+    /// @return ショット後の盤面 (他のストーンに触れうる場合など、予測できない場合は `std::nullopt`)
+    std::optional<CompactBoard> Predict(CompactBoard const& board, std::uint8_t stone_index, moves::Shot const& shot) const;
+
+    /// @brief `Predict()` で予測するかを返す
+    /// @return 予測するなら `true`
+    bool IsPredictionEnabled() const { return use_prediction_; }
+
+    /// @brief ショットで動きうるストーンを求める
+    ///
+    /// 投げたストーンが最初に触れうる位置での速さから止まるまでの距離を求め、
+    /// 動きうるストーンからその距離の範囲内にあるストーンを順に加える。
+    /// 作成時の検証で全てのストーンでのシミュレーションと結果が一致しなかった場合は求めない。
+    /// @param board ショット前の盤面
+    /// @param stone_index 投げるストーンのインデックス
+    /// @param shot ショット (誤差を加えた後のもの)
+    /// @return 動きうるストーンのビットマスク (投げるストーンを含む。求められない場合は `std::nullopt`)
+    std::optional<std::uint16_t> FindActiveStones(CompactBoard const& board, std::uint8_t stone_index, moves::Shot const& shot) const;
+
+    /// @brief 投げたストーンが他のストーンに最初に触れうる位置の手前の状態を求める
+    ///
+    /// 投げた位置からこの状態までの間は他のストーンにもシートの境界にも触れないため、
+    /// この状態からシミュレーションを始めても結果は (補間の誤差を除き) 変わらない。
+    /// `Setting::use_checkpoints` が `false` の場合や、作成時の検証で誤差が許容範囲を超えた場合は求めない。
+    /// @param board ショット前の盤面
+    /// @param stone_index 投げるストーンのインデックス
+    /// @param shot ショット (誤差を加えた後のもの)
+    /// @return 投げたストーンの状態 (求められない場合は `std::nullopt`)
+    std::optional<simulators::ISimulator::StoneState> FindCheckpoint(
+        CompactBoard const& board,
+        std::uint8_t stone_index,
+        moves::Shot const& shot
+    ) const;
+
+    /// @brief 何もないシートへのショットで、予測とシミュレーションの結果を比較する
+    /// @param simulator シミュレーター
+    /// @param count 比較するショットの数
+    /// @param seed 乱数のシード
+    /// @return 検証の結果
+    FreePathValidation Validate(simulators::ISimulator& simulator, std::size_t count, std::uint32_t seed) const;
+
+    /// @brief ランダムな盤面へのショットで、動きうるストーンのみのシミュレーションと全てのストーンでのシミュレーションを比較する
+    /// @param simulator シミュレーター
+    /// @param count 比較する盤面の数
+    /// @param seed 乱数のシード
+    /// @return 検証の結果
+    ActiveStonesValidation ValidateActiveStones(simulators::ISimulator& simulator, std::size_t count, std::uint32_t seed) const;
+
+    /// @brief 何もないシートへのショットで、途中の状態を投げた位置からのシミュレーションと比較する
+    /// @param simulator シミュレーター
+    /// @param count 比較するショットの数
+    /// @param seed 乱数のシード
+    /// @return 検証の結果
+    CheckpointValidation ValidateCheckpoints(simulators::ISimulator& simulator, std::size_t count, std::uint32_t seed) const;
+
+private:
+    /// @brief 1つの初速の軌跡 (基準の向きに投げた場合の、投げた位置からの相対位置)
+    struct Trajectory {
+        /// @brief `Setting::sample_frames` ごとのストーンの状態 (停止した場合、最後の状態は停止したフレームのもの)
+        std::vector<simulators::ISimulator::StoneState> states;
+        /// @brief 記録した軌跡の長さ
+        float length = 0.f;
+        bool is_stopped = false;
+    };
+
+    /// @brief ショットの初速を挟む2つの軌跡と、ショットの向きへの回転
+    struct Bracket {
+        Trajectory const* lower;
+        Trajectory const* upper;
+        float weight;
+        float cos;
+        float sin;
+    };
+
+    enum class PathResult { kUncertain, kContact, kStopped, kRemoved };
+
+    Setting setting_;
+    float sheet_width_;
+    /// @brief 角速度ごと、初速ごとの軌跡
+    std::vector<std::vector<Trajectory>> trajectories_;
+    /// @brief 初速ごとの、その初速以下で止まるまでに動く距離の最大値 (止まらない軌跡があれば無限大)
+    std::vector<float> reach_lengths_;
+    bool use_prediction_;
+    bool use_active_stones_;
+    bool use_checkpoints_;
+
+    FreePathModel(Setting const& setting, float sheet_width);
+
+    /// @brief 予測を検証し、誤差が許容範囲を超えた場合は無効にする
+    void VerifyPrediction(simulators::ISimulatorFactory const& factory, SimulatorPool& simulator_pool, ThreadPool& thread_pool);
+
+    /// @brief 動きうるストーンのみのシミュレーションを検証し、結果が一致しない場合は無効にする
+    void VerifyActiveStones(simulators::ISimulatorFactory const& factory, SimulatorPool& simulator_pool, ThreadPool& thread_pool);
+
+    /// @brief 途中の状態を検証し、誤差が許容範囲を超えた場合は無効にする
+    void VerifyCheckpoints(simulators::ISimulatorFactory const& factory, SimulatorPool& simulator_pool, ThreadPool& thread_pool);
+
+    static Trajectory Record(simulators::ISimulator& simulator, float speed, float angular_velocity, std::uint32_t sample_frames, float max_distance);
+
+    std::optional<Bracket> Locate(moves::Shot const& shot) const;
+
+    PathResult Trace(Trajectory const& trajectory, float cos, float sin, CompactBoard const& board, std::uint8_t stone_index,
+        std::size_t* contact = nullptr) const;
+
+    std::optional<float> GetReachLength(float speed) const;
+
+    simulators::ISimulator::StoneState Interpolate(Bracket const& bracket, std::size_t sample) const;
+};
+
+} // namespace digitalcurling::client
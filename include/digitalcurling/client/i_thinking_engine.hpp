@@ -31,6 +31,13 @@ public:
         std::vector<std::unique_ptr<players::IPlayerFactory>> const& players
     ) = 0;
 
+    /// @brief 思考エンジンの準備処理
+    ///
+    /// `OnInit()` の後、試合への参加やサーバーへの接続と並行して呼び出される。
+    /// テーブルの読み込みやキャッシュのウォームアップなどの重い処理はここで行う。
+    /// 最初のイベントはこの関数の完了後に通知される。
+    virtual void OnWarmUp() {}
+
     /// @brief ゲーム開始の通知
     /// @param team 自チーム
     /// @param states これまでの試合状況とショットの履歴
@@ -78,6 +85,8 @@ public:
     };
 
     /// @brief 次のエンドの開始ストーン位置を決定する
+    ///
+    /// `OnMyTurn()` と同じく、イベント処理とは別のスレッドで呼び出される。
     /// @param game_state 現在の試合状況
     /// @return ストーン位置の選択肢
     virtual PositionedStoneOptions OnDecidePositionedStone(GameState const& game_state) = 0;
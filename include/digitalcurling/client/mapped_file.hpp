@@ -0,0 +1,53 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: Unlicense
+
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+
+namespace digitalcurling::client {
+
+/// @brief 読み取り専用でメモリにマップしたファイル
+///
+/// 事前計算したテーブルを読み込み時間なしで参照するために使用する。
+/// ページはアクセス時に読み込まれ、同じファイルを開いた複数のプロセス間で共有される。
+class MappedFile {
+public:
+    MappedFile() = default;
+
+    /// @brief ファイルをマップする
+    /// @param path ファイルのパス
+    /// @exception std::runtime_error ファイルを開けない場合
+    explicit MappedFile(std::filesystem::path const& path);
+    MappedFile(MappedFile const&) = delete;
+    MappedFile& operator=(MappedFile const&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    ~MappedFile();
+
+    /// @brief ファイルをマップしているかを返す
+    /// @return マップしているなら `true`
+    bool IsOpen() const { return data_ != nullptr; }
+
+    /// @brief 先頭のアドレスを返す
+    /// @return 先頭のアドレス (マップしていない場合は `nullptr`)
+    void const* GetData() const { return data_; }
+
+    /// @brief ファイルのサイズを返す
+    /// @return ファイルのサイズ
+    std::size_t GetSize() const { return size_; }
+
+    /// @brief マップを解除する
+    void Close();
+
+private:
+    void const* data_ = nullptr;
+    std::size_t size_ = 0;
+#ifdef _WIN32
+    void* file_handle_ = nullptr;
+    void* mapping_handle_ = nullptr;
+#endif
+};
+
+} // namespace digitalcurling::client
@@ -0,0 +1,188 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: Unlicense
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace httplib {
+class Server;
+}
+
+namespace digitalcurling::client {
+
+/// @brief 単調増加するカウンター
+///
+/// 加算はスレッドごとに割り当てたシャードへの relaxed な `fetch_add` のみで行うため、
+/// 探索スレッドから頻繁に呼び出しても競合しない。
+class MetricCounter {
+public:
+    /// @brief 値を加算する
+    /// @param value 加算する値
+    void Add(std::uint64_t value = 1) {
+        shards_[GetShardIndex()].value.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    /// @brief 現在の値を返す
+    /// @return 全シャードの合計
+    std::uint64_t Get() const {
+        std::uint64_t sum = 0;
+        for (auto const& shard : shards_) sum += shard.value.load(std::memory_order_relaxed);
+        return sum;
+    }
+
+private:
+    static constexpr std::size_t kShardCount = 16;
+
+    struct alignas(64) Shard {
+        std::atomic<std::uint64_t> value = 0;
+    };
+    std::array<Shard, kShardCount> shards_;
+
+    static std::size_t GetShardIndex() {
+        static std::atomic<std::size_t> next_index = 0;
+        thread_local std::size_t const index = next_index.fetch_add(1, std::memory_order_relaxed) % kShardCount;
+        return index;
+    }
+};
+
+/// @brief 任意の値を取るゲージ
+class MetricGauge {
+public:
+    static_assert(std::atomic<double>::is_always_lock_free);
+
+    /// @brief 値を設定する
+    /// @param value 値
+    void Set(double value) { value_.store(value, std::memory_order_relaxed); }
+
+    /// @brief 現在の値を返す
+    /// @return 値
+    double Get() const { return value_.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<double> value_ = 0.;
+};
+
+/// @brief 所要時間の合計と回数
+class MetricTimer {
+public:
+    /// @brief 所要時間を記録する
+    /// @param duration 所要時間
+    void Observe(std::chrono::nanoseconds duration) {
+        sum_.Add(static_cast<std::uint64_t>(duration.count()));
+        count_.Add();
+        last_.Set(std::chrono::duration<double>(duration).count());
+    }
+
+    /// @brief 所要時間の合計 [s] を返す
+    double GetSum() const { return static_cast<double>(sum_.Get()) * 1e-9; }
+    /// @brief 記録した回数を返す
+    std::uint64_t GetCount() const { return count_.Get(); }
+    /// @brief 最後に記録した所要時間 [s] を返す
+    double GetLast() const { return last_.Get(); }
+
+private:
+    MetricCounter sum_;
+    MetricCounter count_;
+    MetricGauge last_;
+};
+
+/// @brief キャッシュのヒット数とミス数
+struct CacheMetrics {
+    MetricCounter hits;
+    MetricCounter misses;
+
+    /// @brief 参照結果を記録する
+    /// @param hit ヒットしたなら `true`
+    void Record(bool hit) { (hit ? hits : misses).Add(); }
+};
+
+/// @brief クライアントのメトリクス
+///
+/// 全ての値はロックなしで更新できる。`Render()` で Prometheus のテキスト形式に変換する。
+class Metrics {
+public:
+    /// @brief インスタンスを返す
+    /// @return インスタンス
+    static Metrics& GetInstance();
+
+    /// @brief 受信したイベント数
+    MetricCounter events_received;
+    /// @brief 処理したイベント数
+    MetricCounter events_processed;
+    /// @brief 処理待ちのイベント数
+    MetricGauge event_queue_depth;
+    /// @brief イベントの解析時間
+    MetricTimer parse_time;
+    /// @brief 自チームのターンの思考時間
+    MetricTimer think_time;
+    /// @brief 評価器で評価したシミュレーションのジョブ数
+    MetricCounter simulations;
+    /// @brief 直前の評価のスループット [ジョブ/s]
+    MetricGauge simulations_per_second;
+    /// @brief 探索木から次のターンに引き継いだプレイアウト数
+    MetricCounter carried_playouts;
+    /// @brief 粗いシミュレーターによる絞り込みの評価値の誤差の標準偏差
+    MetricGauge screening_error;
+    /// @brief チーム0の残り思考時間 [s]
+    MetricGauge remaining_time_team0;
+    /// @brief チーム1の残り思考時間 [s]
+    MetricGauge remaining_time_team1;
+    /// @brief 再接続回数
+    MetricCounter reconnects;
+    /// @brief 再接続時に破棄した処理済みのイベント数
+    MetricCounter events_discarded;
+    /// @brief 切断から再接続後に最新の状態を受信するまでの時間
+    MetricTimer reconnect_ready_time;
+
+    /// @brief 名前付きのキャッシュのメトリクスを返す
+    ///
+    /// 初回の呼び出しのみロックを取るため、呼び出し側で参照を保持しておくこと。
+    /// @param name キャッシュ名
+    /// @return キャッシュのメトリクス
+    CacheMetrics& GetCache(std::string const& name);
+
+    /// @brief Prometheus のテキスト形式に変換する
+    /// @return テキスト
+    std::string Render() const;
+
+private:
+    static constexpr std::size_t kMaxCaches = 16;
+
+    mutable std::mutex caches_mutex_;
+    std::array<std::string, kMaxCaches> cache_names_;
+    std::array<CacheMetrics, kMaxCaches> caches_;
+    std::size_t cache_count_ = 0;
+
+    Metrics() = default;
+};
+
+/// @brief メトリクスを公開するローカルの HTTP サーバー
+class MetricsServer {
+public:
+    MetricsServer();
+    MetricsServer(MetricsServer const&) = delete;
+    MetricsServer& operator=(MetricsServer const&) = delete;
+    ~MetricsServer();
+
+    /// @brief サーバーを起動し、`/metrics` でメトリクスを公開する
+    /// @param host 待ち受けるアドレス
+    /// @param port 待ち受けるポート
+    void Start(std::string const& host, int port);
+
+    /// @brief サーバーを停止する
+    void Stop();
+
+private:
+    std::unique_ptr<httplib::Server> server_;
+    std::thread thread_;
+};
+
+} // namespace digitalcurling::client
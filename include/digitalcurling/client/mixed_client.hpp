@@ -36,6 +36,8 @@ public:
 protected:
     virtual std::vector<std::uint8_t> GetPlayersIndex() const override;
 
+    virtual void OnWarmUp() override;
+
     virtual void OnGameStart(
         Team const& team,
         std::vector<std::pair<GameState, std::optional<moves::Shot>>> states
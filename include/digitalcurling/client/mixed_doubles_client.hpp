@@ -36,6 +36,8 @@ public:
 protected:
     virtual std::vector<std::uint8_t> GetPlayersIndex() const override;
 
+    virtual void OnWarmUp() override;
+
     virtual void OnGameStart(
         Team const& team,
         std::vector<std::pair<GameState, std::optional<moves::Shot>>> states
@@ -65,6 +67,10 @@ private:
         players_(std::move(players)),
         players_index_(std::move(players_index))
     {}
+
+    /// @brief 配置済みストーンの配置をサーバーに送信する
+    /// @param[in] option 配置
+    void PostPositionedStone(IMixedDoublesThinkingEngine::PositionedStoneOptions option);
 };
 
 } // namespace digitalcurling::client
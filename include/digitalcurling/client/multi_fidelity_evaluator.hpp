@@ -0,0 +1,82 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: Unlicense
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "digitalcurling/client/simulation_evaluator.hpp"
+#include "digitalcurling/client/turn_arena.hpp"
+
+namespace digitalcurling::client {
+
+/// @brief 2段階の精度の評価の設定
+struct MultiFidelitySetting {
+    /// @brief 絞り込みで残す範囲 (最善の候補の評価値から、誤差の標準偏差の何倍までを残すか)
+    double margin_sigmas = 2.;
+    /// @brief 誤差の移動平均の減衰率 (1回の観測の重み)
+    double error_decay = 0.05;
+    /// @brief 誤差の推定に必要な観測数 (それまでは上限まで候補を残す)
+    std::uint32_t min_observations = 16;
+};
+
+/// @brief 粗いシミュレーターで候補を絞り込み、残った候補のみを通常のシミュレーターで評価する
+///
+/// 絞り込みでの評価値と通常の評価値の差を観測し続け、その標準偏差に応じて残す候補の範囲を調整する。
+/// 全ての候補に共通するずれは順位に影響しないため、差の平均を除いたばらつきのみを用いる。
+/// スレッドセーフではない。
+class MultiFidelityEvaluator {
+public:
+    using Setting = MultiFidelitySetting;
+
+    /// @brief コンストラクタ
+    /// @param fine 通常の評価器
+    /// @param screening 絞り込みに用いる評価器 (`nullptr` なら絞り込みを行わない)
+    /// @param setting 設定
+    MultiFidelityEvaluator(
+        ISimulationEvaluator& fine,
+        std::unique_ptr<ISimulationEvaluator> screening,
+        Setting const& setting = {}
+    );
+
+    /// @brief 絞り込みを行うかを返す
+    /// @return 絞り込み用の評価器があるなら `true`
+    bool HasScreening() const { return screening_ != nullptr; }
+
+    /// @brief 通常の評価器を返す
+    /// @return 評価器
+    ISimulationEvaluator& GetFine() const { return fine_; }
+
+    /// @brief 絞り込みに用いる評価器を返す
+    /// @return 評価器 (絞り込みを行わない場合は通常の評価器)
+    ISimulationEvaluator& GetScreening() const { return screening_ != nullptr ? *screening_ : fine_; }
+
+    /// @brief 絞り込みの評価値から、通常の評価器で再評価する候補を選ぶ
+    ///
+    /// 上位 `min_count` 個に加え、最善の候補との差が誤差の範囲内の候補を `max_count` 個まで選ぶ。
+    /// @param values 絞り込みでの各候補の評価値 (大きいほど良い)
+    /// @param min_count 選ぶ候補数の下限
+    /// @param max_count 選ぶ候補数の上限
+    /// @return 選んだ候補のインデックス (評価値の降順、ターンのアリーナから確保する)
+    ArenaVector<std::size_t> Select(ArenaVector<double> const& values, std::size_t min_count, std::size_t max_count) const;
+
+    /// @brief 同じ候補の絞り込みでの評価値と通常の評価値を観測する
+    /// @param screening 絞り込みでの評価値
+    /// @param fine 通常の評価値
+    void Observe(double screening, double fine);
+
+    /// @brief 絞り込みでの評価値の誤差の標準偏差を返す
+    /// @return 標準偏差 (観測が足りない場合は無限大)
+    double GetErrorStddev() const;
+
+private:
+    ISimulationEvaluator& fine_;
+    std::unique_ptr<ISimulationEvaluator> screening_;
+    Setting setting_;
+    double error_mean_ = 0.;
+    double error_square_mean_ = 0.;
+    std::uint32_t observations_ = 0;
+};
+
+} // namespace digitalcurling::client
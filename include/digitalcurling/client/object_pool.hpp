@@ -0,0 +1,196 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: Unlicense
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <digitalcurling/players/i_player.hpp>
+#include <digitalcurling/players/i_player_factory.hpp>
+#include <digitalcurling/simulators/i_simulator.hpp>
+#include <digitalcurling/simulators/i_simulator_factory.hpp>
+
+namespace digitalcurling::client {
+
+/// @brief ファクトリーごとに生成済みのオブジェクトを貸し出すプール
+///
+/// `Register()` で事前にオブジェクトを生成しておき、`Acquire()` で貸し出す。
+/// 貸し出したオブジェクトは `Lease` の破棄時に状態をリセットしてプールへ返却されるため、
+/// 前の貸し出しでの状態が次の貸し出しに引き継がれることはない。
+/// 空きがない場合のみ新たに生成する。全てのメンバ関数はスレッドセーフである。
+/// プールは貸し出した全ての `Lease` より長く存在しなければならない。
+/// @tparam TFactory キーとなるファクトリーの型
+/// @tparam TObject 貸し出すオブジェクトの型
+template <typename TFactory, typename TObject>
+class ObjectPool {
+public:
+    using Creator = std::function<std::unique_ptr<TObject>(TFactory&)>;
+    /// @brief 返却時にオブジェクトの状態をリセットする関数
+    ///
+    /// 状態を直接戻せないオブジェクトは、ファクトリーから生成し直したもので置き換えてよい。
+    using Resetter = std::function<void(TFactory&, std::unique_ptr<TObject>&)>;
+
+    /// @brief 貸し出し中のオブジェクト
+    class Lease {
+    public:
+        Lease() = default;
+        Lease(Lease&& other) noexcept
+          : pool_(std::exchange(other.pool_, nullptr)),
+            key_(other.key_),
+            object_(std::move(other.object_))
+        {}
+        Lease& operator=(Lease&& other) noexcept {
+            if (this != &other) {
+                Release();
+                pool_ = std::exchange(other.pool_, nullptr);
+                key_ = other.key_;
+                object_ = std::move(other.object_);
+            }
+            return *this;
+        }
+        ~Lease() { Release(); }
+
+        TObject* get() const { return object_.get(); }
+        TObject* operator->() const { return object_.get(); }
+        TObject& operator*() const { return *object_; }
+        explicit operator bool() const { return object_ != nullptr; }
+
+    private:
+        friend class ObjectPool;
+
+        ObjectPool* pool_ = nullptr;
+        TFactory const* key_ = nullptr;
+        std::unique_ptr<TObject> object_;
+
+        Lease(ObjectPool* pool, TFactory const* key, std::unique_ptr<TObject> object)
+          : pool_(pool), key_(key), object_(std::move(object)) {}
+
+        void Release() {
+            if (pool_ != nullptr && object_ != nullptr) pool_->Return(key_, std::move(object_));
+            pool_ = nullptr;
+        }
+    };
+
+    /// @brief コンストラクタ
+    /// @param creator ファクトリーからオブジェクトを生成する関数
+    /// @param resetter 返却時にオブジェクトの状態をリセットする関数
+    explicit ObjectPool(Creator creator, Resetter resetter = nullptr)
+      : creator_(std::move(creator)), resetter_(std::move(resetter)) {}
+
+    /// @brief ファクトリーを登録し、オブジェクトを事前に生成する
+    /// @param factory ファクトリー (プールより長く存在すること)
+    /// @param count 事前に生成するオブジェクトの数
+    void Register(TFactory& factory, std::size_t count) {
+        std::vector<std::unique_ptr<TObject>> objects;
+        objects.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) objects.push_back(creator_(factory));
+
+        std::lock_guard lock(mutex_);
+        auto& entry = entries_[&factory];
+        entry.factory = &factory;
+        for (auto& object : objects) entry.idle.push_back(std::move(object));
+    }
+
+    /// @brief オブジェクトを借りる
+    /// @param factory 登録済みのファクトリー
+    /// @return 貸し出したオブジェクト
+    Lease Acquire(TFactory const& factory) {
+        TFactory* source = nullptr;
+        {
+            std::lock_guard lock(mutex_);
+            auto it = entries_.find(&factory);
+            if (it == entries_.end()) {
+                throw std::runtime_error("ObjectPool: factory is not registered.");
+            }
+            auto& idle = it->second.idle;
+            if (!idle.empty()) {
+                auto object = std::move(idle.back());
+                idle.pop_back();
+                return Lease(this, &factory, std::move(object));
+            }
+            source = it->second.factory;
+        }
+        // 空きがない場合はロックの外で生成する
+        return Lease(this, &factory, creator_(*source));
+    }
+
+    /// @brief 登録を全て解除し、保持しているオブジェクトを破棄する
+    void Clear() {
+        std::lock_guard lock(mutex_);
+        entries_.clear();
+    }
+
+private:
+    struct Entry {
+        TFactory* factory = nullptr;
+        std::vector<std::unique_ptr<TObject>> idle;
+    };
+
+    Creator creator_;
+    Resetter resetter_;
+    std::mutex mutex_;
+    std::unordered_map<TFactory const*, Entry> entries_;
+
+    void Return(TFactory const* key, std::unique_ptr<TObject> object) {
+        TFactory* factory = nullptr;
+        {
+            // 登録が解除されていれば破棄する
+            std::lock_guard lock(mutex_);
+            auto it = entries_.find(key);
+            if (it == entries_.end()) return;
+            factory = it->second.factory;
+        }
+        // リセットは生成を伴いうるため、ロックの外で行う
+        if (resetter_) resetter_(*factory, object);
+
+        std::lock_guard lock(mutex_);
+        auto it = entries_.find(key);
+        if (it != entries_.end() && object != nullptr) it->second.idle.push_back(std::move(object));
+    }
+};
+
+/// @brief シミュレーターのプール
+///
+/// シミュレーターは `IInvertibleSimulator` として貸し出し、返却時にストーンを全て取り除く。
+class SimulatorPool : public ObjectPool<simulators::ISimulatorFactory, simulators::IInvertibleSimulator> {
+public:
+    SimulatorPool() : ObjectPool(CreateSimulator, ResetSimulator) {}
+
+private:
+    static std::unique_ptr<simulators::IInvertibleSimulator> CreateSimulator(simulators::ISimulatorFactory& factory) {
+        auto sim = factory.CreateSimulator();
+        auto inv_sim = dynamic_cast<simulators::IInvertibleSimulator*>(sim.get());
+        if (inv_sim == nullptr) {
+            throw std::runtime_error("SimulatorPool: simulator is not invertible simulator.");
+        }
+        sim.release();
+        return std::unique_ptr<simulators::IInvertibleSimulator>(inv_sim);
+    }
+    static void ResetSimulator(simulators::ISimulatorFactory&, std::unique_ptr<simulators::IInvertibleSimulator>& simulator) {
+        simulator->SetStones(simulators::ISimulator::AllStones{});
+    }
+};
+
+/// @brief プレイヤーのプール
+///
+/// プレイヤーの乱数の状態などは外から戻せないため、返却時にファクトリーから生成し直したものと置き換える。
+/// 生成は返却時に行うため、`Acquire()` は事前に生成したプレイヤーを貸し出すのみとなる。
+class PlayerPool : public ObjectPool<players::IPlayerFactory, players::IPlayer> {
+public:
+    PlayerPool() : ObjectPool(CreatePlayer, ResetPlayer) {}
+
+private:
+    static std::unique_ptr<players::IPlayer> CreatePlayer(players::IPlayerFactory& factory) {
+        return factory.CreatePlayer();
+    }
+    static void ResetPlayer(players::IPlayerFactory& factory, std::unique_ptr<players::IPlayer>& player) {
+        player = factory.CreatePlayer();
+    }
+};
+
+} // namespace digitalcurling::client
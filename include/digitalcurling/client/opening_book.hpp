@@ -0,0 +1,274 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: Unlicense
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+#include <digitalcurling/digitalcurling.hpp>
+#include "digitalcurling/client/canonical_board.hpp"
+#include "digitalcurling/client/compact_board.hpp"
+#include "digitalcurling/client/i_factory_creator.hpp"
+#include "digitalcurling/client/mapped_file.hpp"
+#include "digitalcurling/client/metrics.hpp"
+#include "digitalcurling/client/protocol_models.hpp"
+#include "digitalcurling/client/simulation_evaluator.hpp"
+
+namespace digitalcurling::client {
+
+/// @brief 定石の盤面以外のキー
+///
+/// 定石はそのエンドの得点の期待値で探索するため、エンドや得点差によらず同じ手を返す。
+/// 試合状況に応じた手が必要な終盤は、エンドゲームの探索で扱う。
+struct OpeningBookKey {
+    /// @brief エンド内のショット番号
+    std::uint8_t shot = 0;
+    /// @brief 手番のチームがハンマーを持つなら1
+    std::uint8_t has_hammer = 0;
+
+    /// @brief 試合状況からキーを生成する
+    /// @param game_state 試合状況
+    /// @param team 手番のチーム
+    /// @return キー
+    static OpeningBookKey Create(GameState const& game_state, Team team);
+
+    auto Tie() const { return std::tie(shot, has_hammer); }
+    bool operator==(OpeningBookKey const& other) const { return Tie() == other.Tie(); }
+    bool operator<(OpeningBookKey const& other) const { return Tie() < other.Tie(); }
+};
+
+/// @brief 定石のエントリ (ファイル上の形式)
+struct OpeningBookEntry {
+    /// @brief 盤面のハッシュ値
+    std::uint64_t board_hash = 0;
+    /// @brief ショットの初速
+    float translational_velocity = 0.f;
+    /// @brief ショットの角速度
+    float angular_velocity = 0.f;
+    /// @brief ショットのリリース角度
+    float release_angle = 0.f;
+    /// @brief 手番のチームから見た評価値
+    float value = 0.f;
+    /// @brief 評価に用いた試行回数
+    std::uint32_t trials = 0;
+    /// @brief キー
+    OpeningBookKey key;
+    /// @brief 盤面
+    CanonicalBoard board;
+    std::uint8_t reserved[8] {};
+
+    /// @brief ショットを返す
+    /// @return ショット
+    moves::Shot GetShot() const {
+        return moves::Shot(translational_velocity, angular_velocity, release_angle);
+    }
+};
+
+static_assert(std::is_trivially_copyable_v<OpeningBookEntry>);
+static_assert(sizeof(OpeningBookEntry) == 104);
+
+/// @brief 定石を参照する
+///
+/// ファイルをメモリにマップし、整列済みのエントリを二分探索する。
+/// 読み込み処理がないため、起動直後から探索より先に参照できる。
+class OpeningBook {
+public:
+    /// @brief 盤面を同一とみなす距離の既定値 [m]
+    static constexpr float kDefaultTolerance = 0.05f;
+
+    OpeningBook() = default;
+
+    /// @brief 定石のファイルを開く
+    /// @param path ファイルのパス
+    /// @exception std::runtime_error ファイルを開けない場合や形式が不正な場合
+    explicit OpeningBook(std::filesystem::path const& path);
+
+    /// @brief 定石を開いているかを返す
+    /// @return 開いているなら `true`
+    bool IsOpen() const { return entries_ != nullptr; }
+
+    /// @brief エントリ数を返す
+    /// @return エントリ数
+    std::size_t GetEntryCount() const { return entry_count_; }
+
+    /// @brief 定石を作成したシートの幅を返す
+    /// @return シートの幅
+    float GetSheetWidth() const { return sheet_width_; }
+
+    /// @brief エントリを検索する
+    ///
+    /// 盤面が完全に一致するエントリがなければ、距離が `tolerance` 以下で最も近いエントリを返す。
+    /// @param key キー
+    /// @param board 正規化した盤面
+    /// @param tolerance 盤面を同一とみなす距離 [m]
+    /// @return エントリ (見つからない場合は `std::nullopt`)
+    std::optional<OpeningBookEntry> Find(OpeningBookKey const& key, CanonicalBoard const& board, float tolerance = kDefaultTolerance) const;
+
+    /// @brief 試合状況に対応するエントリを検索する
+    ///
+    /// 盤面とそれを反転した盤面の両方で検索する。反転した盤面で見つかった場合は、エントリのショットを反転して返す。
+    /// @param game_state 試合状況
+    /// @param team 手番のチーム
+    /// @param tolerance 盤面を同一とみなす距離 [m]
+    /// @return エントリ (見つからない場合は `std::nullopt`)
+    std::optional<OpeningBookEntry> Find(GameState const& game_state, Team team, float tolerance = kDefaultTolerance) const;
+
+private:
+    MappedFile file_;
+    OpeningBookEntry const* entries_ = nullptr;
+    std::size_t entry_count_ = 0;
+    float sheet_width_ = 0.f;
+    CacheMetrics* metrics_ = nullptr;
+};
+
+/// @brief 定石の局面を探索する
+///
+/// 各局面について候補ショットを誤差付きでシミュレーションし、相手の応手を含めて数手先まで探索する。
+/// 探索の末端は、その盤面でエンドが終了した場合の得点で評価する。
+class OpeningBookBuilder {
+public:
+    /// @brief 探索の設定
+    struct SearchSetting {
+        /// @brief 探索する手数 (1なら自分のショットのみ)
+        std::uint32_t depth = 2;
+        /// @brief 最初のショットの試行回数
+        std::uint32_t trials = 32;
+        /// @brief 2手目以降の試行回数
+        std::uint32_t reply_trials = 8;
+    };
+
+    /// @brief 探索の結果
+    struct SearchResult {
+        /// @brief 最善のショット
+        moves::Shot shot;
+        /// @brief 手番のチームから見た評価値
+        float value = 0.f;
+        /// @brief 評価に用いた試行回数
+        std::uint32_t trials = 0;
+    };
+
+    /// @brief コンストラクタ
+    /// @param game_rule 試合ルール
+    /// @param evaluator 評価器
+    /// @param simulator 候補ショットの計算に用いるシミュレーター
+    OpeningBookBuilder(
+        GameRule const& game_rule,
+        ISimulationEvaluator& evaluator,
+        simulators::IInvertibleSimulator& simulator
+    );
+
+    /// @brief 局面を探索する
+    /// @param board 盤面
+    /// @param team 手番のチーム
+    /// @param end エンド
+    /// @param shot エンド内のショット番号
+    /// @param player ショットを行うプレイヤー
+    /// @param setting 探索の設定
+    /// @return 探索の結果
+    SearchResult Search(
+        CompactBoard const& board,
+        Team team,
+        std::uint8_t end,
+        std::uint8_t shot,
+        players::IPlayer& player,
+        SearchSetting const& setting
+    ) const;
+
+private:
+    GameRule game_rule_;
+    ISimulationEvaluator& evaluator_;
+    simulators::IInvertibleSimulator& simulator_;
+
+    double SearchValue(CompactBoard const& board, Team team, std::uint8_t end, std::uint8_t shot,
+        players::IPlayer& player, std::uint32_t depth, std::uint32_t trials, std::uint32_t reply_trials,
+        moves::Shot* best_shot) const;
+};
+
+/// @brief 定石のエントリを集めてファイルに書き出す
+class OpeningBookWriter {
+public:
+    /// @brief コンストラクタ
+    /// @param sheet_width シートの幅
+    explicit OpeningBookWriter(float sheet_width) : sheet_width_(sheet_width) {}
+
+    /// @brief エントリを追加する
+    ///
+    /// 同じキーと盤面のエントリがある場合は、試行回数の多い方を残す。
+    /// @param key キー
+    /// @param board 正規化した盤面
+    /// @param result 探索の結果
+    void Add(OpeningBookKey const& key, CanonicalBoard const& board, OpeningBookBuilder::SearchResult const& result);
+
+    /// @brief エントリ数を返す
+    /// @return エントリ数
+    std::size_t GetEntryCount() const { return entries_.size(); }
+
+    /// @brief ファイルに保存する
+    ///
+    /// 一時ファイルに書き込んでから置き換えるため、他のプロセスが参照中でも安全に更新できる。
+    /// @param path ファイルのパス
+    /// @exception std::runtime_error 書き込みに失敗した場合
+    void Save(std::filesystem::path const& path) const;
+
+private:
+    float sheet_width_;
+    std::vector<OpeningBookEntry> entries_;
+};
+
+/// @brief 定石を作成する局面
+struct OpeningBookPosition {
+    /// @brief 盤面 (手番のチームをチーム0とする)
+    CompactBoard board;
+    /// @brief エンド内のショット番号
+    std::uint8_t shot = 0;
+};
+
+/// @brief 試合ルールに応じた既定の局面を返す
+///
+/// 通常ルールではハウスが空の局面と、相手のセンターガードが1つある局面を返す。
+/// ミックスダブルスの配置済みストーンの位置はサーバーが決めるため、局面のファイルで指定すること。
+/// @param rule_type 試合ルールの種類
+/// @return 局面
+std::vector<OpeningBookPosition> GetDefaultOpeningBookPositions(GameRuleType rule_type);
+
+/// @brief 局面をファイルから読み込む
+///
+/// `[{ "shot": 0, "own": [[x, y], ...], "opponent": [[x, y], ...] }, ...]` の形式の JSON を読み込む。
+/// @param path ファイルのパス
+/// @return 局面
+/// @exception std::runtime_error 読み込みに失敗した場合
+std::vector<OpeningBookPosition> LoadOpeningBookPositions(std::filesystem::path const& path);
+
+/// @brief 試合の設定で定石を作成して保存する
+/// @param match_info 試合情報 (ルール、シート、シミュレーター、プレイヤー)
+/// @param factory_creator ファクトリーの生成
+/// @param positions 局面
+/// @param path 保存先のパス
+/// @param setting 探索の設定
+void BuildOpeningBook(
+    MatchInfo const& match_info,
+    IFactoryCreator& factory_creator,
+    std::vector<OpeningBookPosition> const& positions,
+    std::filesystem::path const& path,
+    OpeningBookBuilder::SearchSetting const& setting = {}
+);
+
+/// @brief 定石の設定
+struct OpeningBookSetting {
+    /// @brief 定石のファイルのパス
+    std::filesystem::path path;
+
+    /// @brief インスタンスを返す
+    /// @return インスタンス
+    static OpeningBookSetting& GetInstance() {
+        static OpeningBookSetting instance;
+        return instance;
+    }
+};
+
+} // namespace digitalcurling::client
@@ -0,0 +1,64 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: Unlicense
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <random>
+#include <vector>
+#include <digitalcurling/digitalcurling.hpp>
+#include "digitalcurling/client/compact_board.hpp"
+#include "digitalcurling/client/simulation_evaluator.hpp"
+
+namespace digitalcurling::client {
+
+/// @brief ハウス内で最もティーに近いストーンのインデックスを返す
+/// @param board 盤面
+/// @return インデックス (ハウス内にストーンがない場合は `std::nullopt`)
+std::optional<std::size_t> FindShotStone(CompactBoard const& board);
+
+/// @brief 軽量な方策でエンドを最後までプレイアウトする
+///
+/// 相手がNo.1ならヒット、それ以外はハウスへのドローを主体にガードを混ぜる乱択の方策で投げる。
+/// 全てのプレイアウトの同じ手番のショットをまとめて評価器に渡す。
+class PlayoutRunner {
+public:
+    /// @brief プレイアウト、手番のチーム、チーム内のストーン番号から投げるプレイヤーを返す関数
+    using PlayerSelector = std::function<players::IPlayer&(std::size_t playout, Team team, int stone)>;
+
+    /// @brief コンストラクタ
+    /// @param game_rule 試合ルール
+    /// @param evaluator 評価器
+    /// @param simulator 候補ショットの計算に用いるシミュレーター
+    PlayoutRunner(GameRule const& game_rule, ISimulationEvaluator& evaluator, simulators::IInvertibleSimulator& simulator);
+
+    /// @brief 方策に従ってショットを選ぶ
+    /// @param board 盤面
+    /// @param team 手番のチーム
+    /// @return ショット (誤差を加える前のもの)
+    moves::Shot ChooseShot(CompactBoard const& board, Team team);
+
+    /// @brief プレイアウトを行う
+    /// @param boards 各プレイアウトの初期盤面 (終了時の盤面で上書きされる)
+    /// @param first_teams 各プレイアウトで先に投げるチーム
+    /// @param end エンド (ルールの判定に用いる)
+    /// @param stones_per_team 各チームが投げるストーン数
+    /// @param select_player 投げるプレイヤーを返す関数
+    void Run(
+        std::vector<CompactBoard>& boards,
+        std::vector<Team> const& first_teams,
+        std::uint8_t end,
+        int stones_per_team,
+        PlayerSelector const& select_player
+    );
+
+private:
+    GameRule game_rule_;
+    ISimulationEvaluator& evaluator_;
+    simulators::IInvertibleSimulator& simulator_;
+    std::mt19937 random_;
+};
+
+} // namespace digitalcurling::client
@@ -0,0 +1,74 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: Unlicense
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <digitalcurling/digitalcurling.hpp>
+#include "digitalcurling/client/compact_board.hpp"
+
+namespace digitalcurling::client {
+
+/// @brief 解析する局面
+struct AnalysisPosition {
+    /// @brief 局面の識別子 (ファイルで指定されない場合は行番号またはレコード番号)
+    std::string id;
+    /// @brief 手番のチーム
+    Team team = Team::k0;
+    /// @brief 試合状況
+    GameState game_state;
+    /// @brief 直前のショット
+    std::optional<moves::Shot> last_shot;
+};
+
+/// @brief 局面のレコード (バイナリ形式のファイル上の形式)
+///
+/// 得点はエンドごとではなく合計のみを持つ。読み込み時は第1エンドの得点として復元する。
+struct PositionRecord {
+    /// @brief 盤面
+    CompactBoard board;
+    /// @brief エンド
+    std::uint8_t end = 0;
+    /// @brief エンド内のショット番号
+    std::uint8_t shot = 0;
+    /// @brief 手番のチーム
+    std::uint8_t team = 0;
+    /// @brief ハンマーを持つチーム
+    std::uint8_t hammer = 1;
+    /// @brief チームごとの合計得点
+    std::array<std::uint8_t, 2> total_scores {};
+    std::uint8_t reserved[2] {};
+    /// @brief チームごとの残り思考時間 [ms] (0なら期限なし)
+    std::array<std::uint32_t, 2> thinking_time_remaining {};
+};
+
+static_assert(std::is_trivially_copyable_v<PositionRecord>);
+static_assert(sizeof(PositionRecord) == 148);
+
+/// @brief 局面をファイルから読み込む
+///
+/// ファイルの先頭が `SavePositions()` で保存したバイナリ形式のヘッダなら、バイナリ形式として読み込む。
+/// それ以外は1行に1局面の JSONL として読み込む。各行は
+/// `{ "id": "...", "team": "team0", "game_state": { ... }, "last_shot": { "translational_velocity": ..., "angular_velocity": ..., "release_angle": ... } }`
+/// の形式で、`id` と `last_shot` は省略できる。空行は無視する。
+/// @param path ファイルのパス
+/// @param setting 試合設定 (バイナリ形式から試合状況を復元する際に用いる)
+/// @return 局面
+/// @exception std::runtime_error 読み込みに失敗した場合
+std::vector<AnalysisPosition> LoadPositions(std::filesystem::path const& path, GameSetting const& setting);
+
+/// @brief 局面をバイナリ形式で保存する
+///
+/// 直前のショットとエンドごとの得点は保存しない。
+/// @param path ファイルのパス
+/// @param positions 局面
+/// @exception std::runtime_error 書き込みに失敗した場合
+void SavePositions(std::filesystem::path const& path, std::vector<AnalysisPosition> const& positions);
+
+} // namespace digitalcurling::client
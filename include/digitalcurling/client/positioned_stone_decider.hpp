@@ -0,0 +1,134 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: Unlicense
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <tuple>
+#include <vector>
+#include <digitalcurling/digitalcurling.hpp>
+#include "digitalcurling/client/compact_board.hpp"
+#include "digitalcurling/client/i_thinking_engine.hpp"
+#include "digitalcurling/client/object_pool.hpp"
+#include "digitalcurling/client/playout.hpp"
+#include "digitalcurling/client/simulation_evaluator.hpp"
+#include "digitalcurling/client/win_probability_table.hpp"
+
+namespace digitalcurling::client {
+
+/// @brief 配置済みストーンの選択の探索の設定
+struct PositionedStoneSearchSetting {
+    /// @brief 1回にまとめて評価する選択肢ごとのプレイアウト数
+    std::uint32_t batch_playouts = 32;
+    /// @brief 選択肢ごとのプレイアウト数の上限
+    std::uint32_t max_playouts = 512;
+    /// @brief 選択をキャッシュするのに必要な選択肢ごとのプレイアウト数
+    std::uint32_t min_cached_playouts = 128;
+    /// @brief 思考時間の上限
+    std::chrono::milliseconds max_time { 3000 };
+    /// @brief 残りエンドあたりの残り思考時間のうち、選択に用いる割合
+    double time_fraction = 0.25;
+};
+
+/// @brief ミックスダブルスの配置済みストーンを選ぶ
+///
+/// 4つの選択肢それぞれについて、配置済みストーンの盤面からエンドの最後まで
+/// 自チームの2人のプレイヤーで誤差付きのプレイアウトを行い、エンドの得点を勝率表で勝率に変換して比較する。
+/// 全てのプレイアウトの各ショットはまとめて評価器に渡し、残り思考時間に応じた時間内で打ち切る。
+/// 十分なプレイアウトで決めた選択は得点差と残りエンド数ごとにキャッシュし、ファイルに保存する。
+class PositionedStoneDecider {
+public:
+    using Option = IMixedDoublesThinkingEngine::PositionedStoneOptions;
+    using Setting = PositionedStoneSearchSetting;
+
+    /// @brief 選択肢の数
+    static constexpr std::size_t kOptionCount = 4;
+
+    /// @brief 選択の結果
+    struct Result {
+        /// @brief 選んだ選択肢
+        Option option = Option::kCenterHouse;
+        /// @brief 各選択肢の勝率 (選べない選択肢は負の値)
+        std::array<float, kOptionCount> values {};
+        /// @brief 選択肢ごとのプレイアウト数
+        std::uint32_t playouts = 0;
+        /// @brief キャッシュから答えたなら `true`
+        bool from_cache = false;
+    };
+
+    /// @brief コンストラクタ
+    /// @param game_rule 試合ルール
+    /// @param game_setting 試合設定
+    /// @param evaluator 評価器
+    /// @param simulator 候補ショットの計算に用いるシミュレーター
+    /// @param win_probability 試合の勝率表
+    /// @param players プールから借りた自チームのプレイヤー (投球順)
+    /// @param cache_path キャッシュのファイルのパス (空なら保存しない)
+    /// @param setting 探索の設定
+    PositionedStoneDecider(
+        GameRule const& game_rule,
+        GameSetting const& game_setting,
+        ISimulationEvaluator& evaluator,
+        simulators::IInvertibleSimulator& simulator,
+        WinProbabilityTable const& win_probability,
+        std::vector<PlayerPool::Lease> players,
+        std::filesystem::path cache_path = {},
+        Setting const& setting = {}
+    );
+
+    /// @brief 配置済みストーンを選ぶ
+    /// @param game_state 現在の試合状況
+    /// @param team 選択するチーム
+    /// @param power_play_available パワープレイを選べるなら `true`
+    /// @return 選択の結果
+    Result Decide(GameState const& game_state, Team team, bool power_play_available);
+
+    /// @brief 選択肢に対応する配置済みストーンの盤面を返す
+    /// @param option 選択肢
+    /// @param team 選択するチーム
+    /// @return 盤面 (各チームのインデックス0のストーンを配置する)
+    static CompactBoard GetInitialBoard(Option option, Team team);
+
+    /// @brief 選択したチームがハンマーを持つかを返す
+    /// @param option 選択肢
+    /// @return ハンマーを持つなら `true`
+    static bool HasHammer(Option option) { return option != Option::kCenterGuard; }
+
+private:
+    using CacheKey = std::tuple<int, int, bool>;
+
+    GameRule game_rule_;
+    GameSetting game_setting_;
+    ISimulationEvaluator& evaluator_;
+    simulators::IInvertibleSimulator& simulator_;
+    WinProbabilityTable const& win_probability_;
+    std::vector<PlayerPool::Lease> players_;
+    std::filesystem::path cache_path_;
+    Setting setting_;
+    PlayoutRunner playout_runner_;
+    std::map<CacheKey, Result> cache_;
+
+    std::chrono::steady_clock::time_point GetDeadline(GameState const& game_state, Team team) const;
+    void LoadCache();
+    void SaveCache() const;
+};
+
+/// @brief 配置済みストーンの選択の設定
+struct PositionedStoneSetting {
+    /// @brief キャッシュのファイルのパス
+    std::filesystem::path cache_path;
+
+    /// @brief インスタンスを返す
+    /// @return インスタンス
+    static PositionedStoneSetting& GetInstance() {
+        static PositionedStoneSetting instance;
+        return instance;
+    }
+};
+
+} // namespace digitalcurling::client
@@ -0,0 +1,94 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: Unlicense
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "digitalcurling/client/simulation_evaluator.hpp"
+
+namespace digitalcurling::client {
+
+/// @brief ワーカープロセスで評価する
+///
+/// 自身の実行ファイルを `--simulation-worker` 付きで起動し、各ワーカーがシミュレーターのプラグインを読み込む。
+/// ジョブは共有メモリ上のリングバッファで受け渡し、結果は同じスロットに書き戻される。
+/// プラグインがスレッドセーフでない場合や、プラグインのクラッシュからクライアントを保護したい場合に使用する。
+/// クラッシュしたワーカーは自動で再起動し、処理中だったジョブは再投入する。
+/// 処理中のジョブが一定時間 (期限を過ぎた後は短い時間) 完了しないワーカーは、応答しないとみなして停止させ、同様に再起動する。
+/// 現在は Linux のみ対応している。
+class ProcessSimulationEvaluator : public ISimulationEvaluator {
+public:
+    /// @brief ワーカーでシミュレーターのファクトリーを生成する関数
+    using FactoryCreator = std::function<std::unique_ptr<simulators::ISimulatorFactory>(nlohmann::json const&)>;
+    /// @brief ワーカーでジョブを1つ実行する関数
+    using JobRunner = std::function<void(SimulationJob&)>;
+
+    /// @brief コンストラクタ
+    /// @param simulator_json シミュレーターのファクトリーの JSON
+    /// @param sheet_width シートの幅
+    /// @param worker_count ワーカープロセス数
+    /// @param worker_arguments ワーカープロセスに渡す追加の引数
+    /// @exception std::runtime_error 共有メモリの作成やワーカーの起動に失敗した場合
+    ProcessSimulationEvaluator(
+        nlohmann::json const& simulator_json,
+        float sheet_width,
+        std::size_t worker_count,
+        std::vector<std::string> worker_arguments = {}
+    );
+    ~ProcessSimulationEvaluator() override;
+
+    void Evaluate(std::pmr::vector<SimulationJob>& jobs) override;
+    void SetDeadline(std::optional<std::chrono::steady_clock::time_point> deadline) override;
+
+    /// @brief ワーカープロセスの処理を実行する
+    ///
+    /// 親プロセスが評価器を破棄するまで戻らない。
+    /// @param shm_name 共有メモリの名前
+    /// @param worker_index ワーカーのインデックス
+    /// @param create_factory シミュレーターのファクトリーを生成する関数
+    /// @return 終了コード
+    static int RunWorker(std::string const& shm_name, std::size_t worker_index, FactoryCreator const& create_factory);
+
+    /// @brief ジョブを実行する関数を指定して、ワーカープロセスの処理を実行する
+    ///
+    /// シミュレーターを用いずにワーカーを動かす場合 (テストなど) に用いる。
+    /// @param shm_name 共有メモリの名前
+    /// @param worker_index ワーカーのインデックス
+    /// @param run_job ジョブを実行する関数
+    /// @return 終了コード
+    static int RunWorker(std::string const& shm_name, std::size_t worker_index, JobRunner const& run_job);
+
+private:
+    struct SharedMemory;
+
+    static constexpr std::chrono::steady_clock::rep kNoDeadline = std::numeric_limits<std::chrono::steady_clock::rep>::max();
+
+    std::string shm_name_;
+    SharedMemory* shared_ = nullptr;
+    std::vector<std::string> worker_arguments_;
+    std::vector<int> worker_pids_;
+    std::mutex mutex_;
+    /// @brief 評価の期限 (`steady_clock` のエポックからの時間、期限なしなら `kNoDeadline`)
+    std::atomic<std::chrono::steady_clock::rep> deadline_ = kNoDeadline;
+
+    static int RunWorker(
+        std::string const& shm_name,
+        std::size_t worker_index,
+        std::function<void(nlohmann::json const&, float)> const& initialize,
+        JobRunner const& run_job
+    );
+
+    void StartWorker(std::size_t worker_index);
+    std::vector<std::size_t> CollectCrashedWorkers();
+};
+
+} // namespace digitalcurling::client
@@ -0,0 +1,91 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: Unlicense
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+
+/// @def PROFILE_ZONE(name)
+/// @brief スコープの開始から終了までをゾーンとして計測する
+///
+/// `name` は文字列リテラルなど、プログラムの終了まで有効な文字列でなければならない。
+/// `DIGITALCURLING_CLIENT_ENABLE_PROFILER` が定義されていない場合は何も生成しない。
+#ifdef DIGITALCURLING_CLIENT_ENABLE_PROFILER
+    #define DIGITALCURLING_CLIENT_PROFILE_CONCAT_IMPL(a, b) a##b
+    #define DIGITALCURLING_CLIENT_PROFILE_CONCAT(a, b) DIGITALCURLING_CLIENT_PROFILE_CONCAT_IMPL(a, b)
+    #define PROFILE_ZONE(name) \
+        ::digitalcurling::client::ProfileZone DIGITALCURLING_CLIENT_PROFILE_CONCAT(profile_zone_, __LINE__)(name)
+#else
+    #define PROFILE_ZONE(name) static_cast<void>(0)
+#endif
+
+namespace digitalcurling::client {
+
+/// @brief ゾーンの計測結果を記録するプロファイラー
+///
+/// 各スレッドは自スレッド専用のバッファにロックなしで記録し、`WriteChromeTrace()` で全スレッドの記録を
+/// Chrome のトレース形式 (Perfetto で表示可能) のJSONに書き出す。
+/// `Start()` を呼び出すまでは記録しない。
+/// ハードウェアカウンターは Linux の `perf_event_open` で計測し、使用できない環境では記録しない。
+class Profiler {
+public:
+    Profiler() = delete;
+
+    /// @brief ハードウェアカウンターの数 (CPUサイクル、キャッシュミス、分岐予測ミス)
+    static constexpr std::size_t kCounterCount = 3;
+
+    /// @brief 記録を開始する
+    /// @param hardware_counters ハードウェアカウンターも計測するなら `true`
+    static void Start(bool hardware_counters = false);
+
+    /// @brief 記録中かを返す
+    /// @return 記録中なら `true`
+    static bool IsEnabled();
+
+    /// @brief 呼び出したスレッドの名前を設定する (トレースの表示に用いる)
+    ///
+    /// 記録の開始前に呼び出した場合は何もしない。
+    /// @param name スレッドの名前 (プログラムの終了まで有効な文字列)
+    static void SetThreadName(char const* name);
+
+    /// @brief 全スレッドの記録を Chrome のトレース形式で書き出す
+    ///
+    /// 記録中のスレッドがあっても呼び出せる。書き出し時点で完了しているゾーンのみを含む。
+    /// @param path 出力先のパス
+    /// @exception std::runtime_error 書き込みに失敗した場合
+    static void WriteChromeTrace(std::filesystem::path const& path);
+
+private:
+    friend class ProfileZone;
+
+    static bool BeginZone(std::int64_t& start, std::array<std::uint64_t, kCounterCount>& counters);
+    static void EndZone(char const* name, std::int64_t start, std::array<std::uint64_t, kCounterCount> const& counters, bool has_counters);
+};
+
+/// @brief スコープの開始から終了までを計測するゾーン
+///
+/// 通常は `PROFILE_ZONE()` マクロを用いる。
+class ProfileZone {
+public:
+    /// @brief コンストラクタ
+    /// @param name ゾーンの名前 (プログラムの終了まで有効な文字列)
+    explicit ProfileZone(char const* name) : name_(name), active_(Profiler::IsEnabled()) {
+        if (active_) has_counters_ = Profiler::BeginZone(start_, counters_);
+    }
+    ProfileZone(ProfileZone const&) = delete;
+    ProfileZone& operator=(ProfileZone const&) = delete;
+    ~ProfileZone() {
+        if (active_) Profiler::EndZone(name_, start_, counters_, has_counters_);
+    }
+
+private:
+    char const* name_;
+    bool active_;
+    bool has_counters_ = false;
+    std::int64_t start_ = 0;
+    std::array<std::uint64_t, Profiler::kCounterCount> counters_ {};
+};
+
+} // namespace digitalcurling::client
@@ -0,0 +1,126 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: Unlicense
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "digitalcurling/client/simulation_evaluator.hpp"
+
+namespace digitalcurling::client {
+
+/// @brief 外部の評価ノードに処理を分散して評価する
+///
+/// ジョブを一定数ごとのチャンクに分け、各ノードとローカルの評価器がチャンクを取り合って処理する。
+/// ノードは自身の実行ファイルを `--simulation-node` 付きで起動したもので、`RunNode()` が処理を行う。
+/// 応答のないノードは一定時間使用せず、そのチャンクはローカルで処理する。
+/// 期限を過ぎた場合は、ノードで処理中のチャンクもローカルで引き継ぎ、先に完了した結果を使用する。
+class RemoteSimulationEvaluator : public ISimulationEvaluator {
+public:
+    /// @brief ノードでシミュレーターのファクトリーを生成する関数
+    using FactoryCreator = std::function<std::unique_ptr<simulators::ISimulatorFactory>(nlohmann::json const&)>;
+    /// @brief ノードでジョブを1つ実行する関数
+    using JobRunner = std::function<void(SimulationJob&)>;
+
+    /// @brief コンストラクタ
+    /// @param simulator_json シミュレーターのファクトリーの JSON
+    /// @param sheet_width シートの幅
+    /// @param nodes 評価ノードのURL (例: `http://192.168.0.10:10000`)
+    /// @param local ローカルの評価器
+    RemoteSimulationEvaluator(
+        nlohmann::json const& simulator_json,
+        float sheet_width,
+        std::vector<std::string> const& nodes,
+        std::unique_ptr<ISimulationEvaluator> local
+    );
+    ~RemoteSimulationEvaluator() override;
+
+    void Evaluate(std::pmr::vector<SimulationJob>& jobs) override;
+    void SetDeadline(std::optional<std::chrono::steady_clock::time_point> deadline) override;
+    void WarmUp() override;
+
+    /// @brief 評価ノードへのリクエスト
+    struct Request {
+        /// @brief シートの幅
+        float sheet_width = 0.f;
+        /// @brief シミュレーターのファクトリーの JSON
+        std::string simulator_json;
+        /// @brief ジョブ
+        std::pmr::vector<SimulationJob> jobs;
+    };
+
+    /// @brief リクエストをバイト列に変換する
+    /// @param simulator_json シミュレーターのファクトリーの JSON
+    /// @param sheet_width シートの幅
+    /// @param jobs ジョブの先頭
+    /// @param count ジョブ数
+    /// @return バイト列
+    static std::string EncodeRequest(std::string const& simulator_json, float sheet_width, SimulationJob const* jobs, std::size_t count);
+
+    /// @brief バイト列からリクエストを復元する
+    ///
+    /// ノードは認証なしでリクエストを受け付けるため、シミュレーションの前に全てのジョブを検証する。
+    /// @param body バイト列
+    /// @return リクエスト
+    /// @exception std::invalid_argument 形式が不正な場合や、投げるストーンのインデックスや初速などが範囲外の場合
+    static Request DecodeRequest(std::string const& body);
+
+    /// @brief 評価ノードとして待ち受ける
+    ///
+    /// サーバーが停止するまで戻らない。
+    /// シミュレーターの設定ごとに評価器を作成し、最近使用した `kMaxNodeEvaluators` 個まで保持する。
+    /// 評価器は `SimulationEvaluatorSetting` に従い、クライアントのローカルの評価器と同じ方法で評価する。
+    /// @param host 待ち受けるアドレス
+    /// @param port 待ち受けるポート
+    /// @param create_factory シミュレーターのファクトリーを生成する関数
+    /// @param thread_count 評価に使用するスレッド数 (0ならハードウェアのスレッド数)
+    /// @return 終了コード
+    static int RunNode(std::string const& host, int port, FactoryCreator const& create_factory, std::size_t thread_count = 0);
+
+    /// @brief ジョブを実行する関数を指定して、評価ノードとして待ち受ける
+    ///
+    /// シミュレーターを用いずにノードを動かす場合 (テストなど) に用いる。リクエストのジョブは順に実行する。
+    /// @param host 待ち受けるアドレス
+    /// @param port 待ち受けるポート
+    /// @param run_job ジョブを実行する関数
+    /// @return 終了コード
+    static int RunNode(std::string const& host, int port, JobRunner const& run_job);
+
+    /// @brief ノードが保持する評価器の最大数
+    static constexpr std::size_t kMaxNodeEvaluators = 4;
+
+private:
+    struct Batch;
+    struct Node;
+
+    std::string simulator_json_;
+    float sheet_width_;
+    std::unique_ptr<ISimulationEvaluator> local_;
+    std::vector<std::unique_ptr<Node>> nodes_;
+    std::optional<std::chrono::steady_clock::time_point> deadline_;
+
+    std::mutex mutex_;
+    std::condition_variable cond_var_;
+    std::shared_ptr<Batch> batch_;
+    std::uint64_t batch_generation_ = 0;
+    bool is_stopped_ = false;
+
+    std::uint64_t total_jobs_ = 0;
+    std::uint64_t total_local_jobs_ = 0;
+    std::chrono::nanoseconds total_time_ {};
+
+    void RunNodeThread(Node& node);
+
+    static int ServeNode(std::string const& host, int port, std::function<void(Request&)> const& evaluate);
+};
+
+} // namespace digitalcurling::client
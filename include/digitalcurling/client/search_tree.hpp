@@ -0,0 +1,233 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: Unlicense
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+#include <digitalcurling/moves/shot.hpp>
+#include "digitalcurling/client/compact_board.hpp"
+
+namespace digitalcurling::client {
+
+/// @brief 2つの盤面の距離を計算する
+/// @param a 盤面
+/// @param b 盤面
+/// @return 各ストーンの位置ずれの最大値 [m] (ストーンの有無が異なる場合は無限大)
+inline float GetBoardDistance(CompactBoard const& a, CompactBoard const& b) {
+    if (a.occupied != b.occupied) return std::numeric_limits<float>::infinity();
+
+    float distance = 0.f;
+    for (std::size_t i = 0; i < CompactBoard::kStoneCount; ++i) {
+        if (!a.HasStone(i)) continue;
+        distance = std::max(distance, std::hypot(a.x[i] - b.x[i], a.y[i] - b.y[i]));
+    }
+    return distance;
+}
+
+/// @brief ターンをまたいで部分木を再利用する探索木
+///
+/// ノードは配列上に確保し、インデックスで参照する。ノードの統計 (プレイアウト数と評価値の合計) は祖先にも加算する。
+/// `Advance()` は実際の盤面に最も近い子ノードを新しいルートに昇格させ、その部分木のみを予備の配列へ詰め直す。
+/// ノードはトリビアルに破棄できるため、残りのノードは配列の長さを戻すだけで O(1) で解放される。
+/// スレッドセーフではないため、並列探索を行う場合は呼び出し側で排他制御を行うこと。
+/// @tparam TData ノードごとに思考エンジンが保持する追加データ (トリビアルに破棄できること)
+template <typename TData = std::monostate>
+class SearchTree {
+public:
+    using NodeIndex = std::uint32_t;
+    static constexpr NodeIndex kNullIndex = std::numeric_limits<NodeIndex>::max();
+
+    /// @brief 探索木のノード
+    struct Node {
+        /// @brief このノードの盤面
+        CompactBoard board;
+        /// @brief このノードに至ったショット (ルートは `std::nullopt`)
+        std::optional<moves::Shot> shot;
+        /// @brief 親ノード
+        NodeIndex parent = kNullIndex;
+        /// @brief 最初の子ノード
+        NodeIndex first_child = kNullIndex;
+        /// @brief 次の兄弟ノード
+        NodeIndex next_sibling = kNullIndex;
+        /// @brief このノード以下のプレイアウト数
+        std::uint64_t playouts = 0;
+        /// @brief このノード以下のプレイアウトの評価値の合計
+        double value_sum = 0.;
+        /// @brief 思考エンジンの追加データ
+        TData data {};
+    };
+
+    static_assert(std::is_trivially_destructible_v<Node>);
+
+    /// @brief `Advance()` の結果
+    struct AdvanceResult {
+        /// @brief 部分木を再利用したなら `true`
+        bool reused = false;
+        /// @brief 新しいルートと実際の盤面の距離 [m]
+        float distance = std::numeric_limits<float>::infinity();
+        /// @brief 引き継いだノード数
+        std::size_t carried_nodes = 0;
+        /// @brief 引き継いだプレイアウト数
+        std::uint64_t carried_playouts = 0;
+    };
+
+    /// @brief コンストラクタ
+    /// @param tolerance 子ノードを実際の盤面とみなす距離の上限 [m]
+    explicit SearchTree(float tolerance = 0.05f) : tolerance_(tolerance) {}
+
+    /// @brief 探索木を破棄し、指定した盤面をルートとする
+    /// @param board ルートの盤面
+    void Reset(CompactBoard const& board) {
+        nodes_.clear();
+        nodes_.push_back(Node { board });
+    }
+
+    /// @brief 探索木を破棄し、ルートもなくす
+    void Clear() { nodes_.clear(); }
+
+    /// @brief ルートが存在するかを返す
+    /// @return ルートが存在するなら `true`
+    bool HasRoot() const { return !nodes_.empty(); }
+
+    /// @brief ルートのインデックスを返す
+    /// @return ルートのインデックス
+    NodeIndex GetRoot() const { return 0; }
+
+    /// @brief ノードを返す
+    /// @param index ノードのインデックス
+    /// @return ノード
+    Node& GetNode(NodeIndex index) { return nodes_[index]; }
+    Node const& GetNode(NodeIndex index) const { return nodes_[index]; }
+
+    /// @brief 子ノードを追加する
+    /// @param parent 親ノードのインデックス
+    /// @param board 子ノードの盤面
+    /// @param shot 子ノードに至るショット
+    /// @return 追加した子ノードのインデックス
+    NodeIndex AddChild(NodeIndex parent, CompactBoard const& board, moves::Shot const& shot) {
+        auto const index = static_cast<NodeIndex>(nodes_.size());
+        Node node { board, shot };
+        node.parent = parent;
+        node.next_sibling = nodes_[parent].first_child;
+        nodes_.push_back(node);
+        nodes_[parent].first_child = index;
+        return index;
+    }
+
+    /// @brief ノードとその祖先にプレイアウトの結果を加算する
+    /// @param index ノードのインデックス
+    /// @param value プレイアウトの評価値の平均
+    /// @param playouts プレイアウト数
+    void AddResult(NodeIndex index, double value, std::uint64_t playouts = 1) {
+        for (auto i = index; i != kNullIndex; i = nodes_[i].parent) {
+            nodes_[i].playouts += playouts;
+            nodes_[i].value_sum += value * static_cast<double>(playouts);
+        }
+    }
+
+    /// @brief 子ノードを列挙する
+    /// @param parent 親ノードのインデックス
+    /// @param func 子ノードのインデックスを受け取る関数
+    template <typename TFunc>
+    void ForEachChild(NodeIndex parent, TFunc&& func) const {
+        for (auto i = nodes_[parent].first_child; i != kNullIndex; i = nodes_[i].next_sibling) {
+            func(i);
+        }
+    }
+
+    /// @brief 保持しているノード数を返す
+    /// @return ノード数
+    std::size_t GetNodeCount() const { return nodes_.size(); }
+
+    /// @brief 実際の盤面に合わせてルートを進める
+    ///
+    /// ルートの子ノードから実際の盤面に最も近いものを探し、許容誤差以内であれば新しいルートに昇格させる。
+    /// 見つからない場合は探索木を破棄し、実際の盤面を新しいルートとする。
+    /// @param board 実際の盤面
+    /// @param last_shot 実際に行われたショット (距離が等しい子ノードの選択に用いる)
+    /// @return 結果
+    AdvanceResult Advance(CompactBoard const& board, std::optional<moves::Shot> const& last_shot) {
+        AdvanceResult result;
+        if (!HasRoot()) {
+            Reset(board);
+            return result;
+        }
+
+        NodeIndex best = kNullIndex;
+        float best_shot_distance = std::numeric_limits<float>::infinity();
+        ForEachChild(GetRoot(), [&](NodeIndex i) {
+            float const distance = GetBoardDistance(nodes_[i].board, board);
+            float const shot_distance = GetShotDistance(nodes_[i].shot, last_shot);
+            if (distance < result.distance
+                || (distance == result.distance && shot_distance < best_shot_distance)) {
+                best = i;
+                result.distance = distance;
+                best_shot_distance = shot_distance;
+            }
+        });
+
+        if (best == kNullIndex || result.distance > tolerance_) {
+            Reset(board);
+            return result;
+        }
+
+        // 新しいルートの部分木を幅優先で予備の配列に詰め直す
+        spare_.clear();
+        spare_.push_back(nodes_[best]);
+        spare_[0].board = board;
+        spare_[0].shot = std::nullopt;
+        spare_[0].parent = kNullIndex;
+        spare_[0].next_sibling = kNullIndex;
+        for (NodeIndex i = 0; i < spare_.size(); ++i) {
+            NodeIndex prev = kNullIndex;
+            for (auto source = spare_[i].first_child; source != kNullIndex; source = nodes_[source].next_sibling) {
+                auto const index = static_cast<NodeIndex>(spare_.size());
+                spare_.push_back(nodes_[source]);
+                spare_[index].parent = i;
+                if (prev == kNullIndex) {
+                    spare_[i].first_child = index;
+                } else {
+                    spare_[prev].next_sibling = index;
+                }
+                prev = index;
+            }
+            if (prev != kNullIndex) spare_[prev].next_sibling = kNullIndex;
+        }
+        // 残りのノードは破棄処理を伴わないため、配列を入れ替えて長さを戻すだけでよい
+        std::swap(nodes_, spare_);
+        spare_.clear();
+
+        result.reused = true;
+        result.carried_nodes = nodes_.size();
+        result.carried_playouts = nodes_[GetRoot()].playouts;
+        total_carried_playouts_ += result.carried_playouts;
+        return result;
+    }
+
+    /// @brief これまでに引き継いだプレイアウト数の合計を返す
+    /// @return プレイアウト数
+    std::uint64_t GetTotalCarriedPlayouts() const { return total_carried_playouts_; }
+
+private:
+    float tolerance_;
+    std::vector<Node> nodes_;
+    std::vector<Node> spare_;
+    std::uint64_t total_carried_playouts_ = 0;
+
+    static float GetShotDistance(std::optional<moves::Shot> const& a, std::optional<moves::Shot> const& b) {
+        if (!a.has_value() || !b.has_value()) return std::numeric_limits<float>::infinity();
+        return std::abs(a->translational_velocity - b->translational_velocity)
+            + std::abs(a->release_angle - b->release_angle)
+            + (std::signbit(a->angular_velocity) != std::signbit(b->angular_velocity) ? 1.f : 0.f);
+    }
+};
+
+} // namespace digitalcurling::client
@@ -0,0 +1,209 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: Unlicense
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <digitalcurling/moves/shot.hpp>
+#include <digitalcurling/simulators/i_simulator.hpp>
+#include <digitalcurling/simulators/i_simulator_factory.hpp>
+#include "digitalcurling/client/compact_board.hpp"
+#include "digitalcurling/client/metrics.hpp"
+#include "digitalcurling/client/object_pool.hpp"
+#include "digitalcurling/client/thread_pool.hpp"
+
+namespace digitalcurling::client {
+
+class FreePathModel;
+
+/// @brief 1投のシミュレーション
+///
+/// 評価後、`board` はショット後の盤面で上書きされる。
+struct SimulationJob {
+    /// @brief 盤面 (評価前はショット前、評価後はショット後)
+    CompactBoard board;
+    /// @brief ショットの初速
+    float translational_velocity = 0.f;
+    /// @brief ショットの角速度
+    float angular_velocity = 0.f;
+    /// @brief ショットのリリース角度
+    float release_angle = 0.f;
+    /// @brief 投げるストーンのインデックス
+    std::uint8_t stone_index = 0;
+
+    /// @brief ジョブを生成する
+    /// @param board ショット前の盤面
+    /// @param stone_index 投げるストーンのインデックス
+    /// @param shot ショット (誤差を加えた後のもの)
+    /// @return ジョブ
+    static SimulationJob Create(CompactBoard const& board, std::uint8_t stone_index, moves::Shot const& shot) {
+        SimulationJob job;
+        job.board = board;
+        job.translational_velocity = shot.translational_velocity;
+        job.angular_velocity = shot.angular_velocity;
+        job.release_angle = shot.release_angle;
+        job.stone_index = stone_index;
+        return job;
+    }
+
+    /// @brief ショットを返す
+    /// @return ショット
+    moves::Shot GetShot() const {
+        return moves::Shot(translational_velocity, angular_velocity, release_angle);
+    }
+};
+
+static_assert(std::is_trivially_copyable_v<SimulationJob>);
+
+/// @brief シミュレータでジョブを1つ実行する
+///
+/// `active_stones` に含まれないストーンはシミュレーターに置かず、ショット前の位置のまま結果に残す。
+/// @param simulator シミュレーター
+/// @param job ジョブ (結果で上書きされる)
+/// @param sheet_width シートの幅
+/// @param active_stones シミュレーションするストーンのビットマスク (投げるストーンを含むこと)
+/// @param checkpoint 投げたストーンの途中の状態 (`std::nullopt` なら投げた時点から始める)
+void RunSimulationJob(
+    simulators::ISimulator& simulator,
+    SimulationJob& job,
+    float sheet_width,
+    std::uint16_t active_stones = 0xFFFF,
+    std::optional<simulators::ISimulator::StoneState> const& checkpoint = std::nullopt
+);
+
+/// @brief シミュレーションをまとめて評価する
+class ISimulationEvaluator {
+public:
+    virtual ~ISimulationEvaluator() = default;
+
+    /// @brief ジョブをまとめて評価する
+    ///
+    /// 各ジョブの `board` をショット後の盤面で上書きする。ジョブの評価順は不定である。
+    /// 思考中は `MakeArenaVector()` でターンのアリーナから確保した配列を渡す。
+    /// 呼び出したスレッドの思考 (`ThinkingContext`) が取り消された場合は残りのジョブを評価せずに戻るため、
+    /// 呼び出し側は取り消しを確認してから結果を用いること。
+    /// @param jobs ジョブ
+    virtual void Evaluate(std::pmr::vector<SimulationJob>& jobs) = 0;
+
+    /// @brief 以降の評価の期限を設定する
+    ///
+    /// 期限を過ぎても応答のない外部のノードの処理は、ローカルで引き継ぐ。
+    /// 期限を扱わない評価器では何もしない。
+    /// @param deadline 期限 (`std::nullopt` なら期限なし)
+    virtual void SetDeadline(std::optional<std::chrono::steady_clock::time_point> deadline) {}
+
+    /// @brief 評価の前準備を行う
+    ///
+    /// 思考を始める前に1度呼び出す。準備を必要としない評価器では何もしない。
+    virtual void WarmUp() {}
+};
+
+/// @brief スコープ内で評価器の期限を設定する
+///
+/// 例外の場合も含め、スコープを抜ける際に期限を解除する。
+class DeadlineScope {
+public:
+    /// @brief コンストラクタ
+    /// @param evaluator 評価器
+    /// @param deadline 期限 (`std::nullopt` なら期限なし)
+    DeadlineScope(ISimulationEvaluator& evaluator, std::optional<std::chrono::steady_clock::time_point> deadline)
+        : evaluator_(evaluator) { evaluator_.SetDeadline(deadline); }
+    DeadlineScope(DeadlineScope const&) = delete;
+    DeadlineScope& operator=(DeadlineScope const&) = delete;
+    ~DeadlineScope() { evaluator_.SetDeadline(std::nullopt); }
+
+private:
+    ISimulationEvaluator& evaluator_;
+};
+
+/// @brief 同一プロセス内のスレッドで評価する
+class LocalSimulationEvaluator : public ISimulationEvaluator {
+public:
+    /// @brief コンストラクタ
+    /// @param factory シミュレーターのファクトリー (複製して保持する)
+    /// @param sheet_width シートの幅
+    /// @param thread_count スレッド数 (0ならハードウェアのスレッド数)
+    /// @param use_free_path 他のストーンに触れないショットのシミュレーションを `FreePathModel` の予測で省くなら `true`
+    /// @param use_checkpoints `FreePathModel` の途中の状態からシミュレーションを始めるなら `true`
+    LocalSimulationEvaluator(
+        simulators::ISimulatorFactory const& factory,
+        float sheet_width,
+        std::size_t thread_count = 0,
+        bool use_free_path = false,
+        bool use_checkpoints = false
+    );
+    ~LocalSimulationEvaluator() override;
+
+    void Evaluate(std::pmr::vector<SimulationJob>& jobs) override;
+    void WarmUp() override;
+
+private:
+    std::unique_ptr<simulators::ISimulatorFactory> factory_;
+    float sheet_width_;
+    SimulatorPool simulator_pool_;
+    ThreadPool thread_pool_;
+    bool use_free_path_;
+    bool use_checkpoints_;
+    /// @brief 評価中に作成されうるため、`std::atomic_load()` / `std::atomic_store()` で読み書きする
+    std::shared_ptr<FreePathModel const> free_path_;
+    CacheMetrics* free_path_metrics_ = nullptr;
+    CacheMetrics* active_stones_metrics_ = nullptr;
+    CacheMetrics* checkpoint_metrics_ = nullptr;
+};
+
+/// @brief 評価器の設定
+///
+/// 起動時にコマンドライン引数から設定し、思考エンジンは `CreateSimulationEvaluator()` で評価器を生成する。
+struct SimulationEvaluatorSetting {
+    /// @brief 同一プロセス内で評価する場合のスレッド数 (0ならハードウェアのスレッド数)
+    std::size_t thread_count = 0;
+    /// @brief ワーカープロセス数 (0ならワーカープロセスを使用しない)
+    std::size_t worker_process_count = 0;
+    /// @brief ワーカープロセスに渡す追加の引数 (プラグインのディレクトリなど)
+    std::vector<std::string> worker_arguments;
+    /// @brief 評価ノードのURL (空ならノードを使用しない)
+    std::vector<std::string> remote_nodes;
+    /// @brief 候補の絞り込みに用いる粗いシミュレーターの1フレームの時間 [s] (0なら絞り込みを行わない)
+    double screening_seconds_per_frame = 0.;
+    /// @brief 他のストーンに触れないショットのシミュレーションを `FreePathModel` で省くなら `true`
+    ///
+    /// 予測した停止位置は表の補間の誤差 (`FreePathSetting::tolerance` 以内) だけ変わるため、`checkpoints` と同じく明示的に有効にした場合のみ用いる。
+    bool free_path = false;
+    /// @brief 投げたストーンの途中の状態からシミュレーションを始めるなら `true`
+    ///
+    /// 結果が補間の誤差だけ変わるため、明示的に有効にした場合のみ用いる。
+    bool checkpoints = false;
+
+    /// @brief インスタンスを返す
+    /// @return インスタンス
+    static SimulationEvaluatorSetting& GetInstance() {
+        static SimulationEvaluatorSetting instance;
+        return instance;
+    }
+};
+
+/// @brief 設定に従って評価器を生成する
+///
+/// 評価したジョブ数とスループットは、返した評価器が `Metrics` に記録する。
+/// @param factory シミュレーターのファクトリー
+/// @param sheet_width シートの幅
+/// @return 評価器
+std::unique_ptr<ISimulationEvaluator> CreateSimulationEvaluator(simulators::ISimulatorFactory const& factory, float sheet_width);
+
+/// @brief 設定に従って候補の絞り込み用の評価器を生成する
+///
+/// シミュレーターのファクトリーを JSON に変換し、1フレームの時間を設定の値に置き換えて生成する。
+/// 絞り込み用の評価器は同一プロセス内のスレッドで評価し、`CreateSimulationEvaluator()` と同じくメトリクスを記録する。
+/// @param factory シミュレーターのファクトリー
+/// @param sheet_width シートの幅
+/// @return 評価器 (設定で無効な場合やプラグインローダーがない場合は `nullptr`)
+std::unique_ptr<ISimulationEvaluator> CreateScreeningSimulationEvaluator(simulators::ISimulatorFactory const& factory, float sheet_width);
+
+} // namespace digitalcurling::client
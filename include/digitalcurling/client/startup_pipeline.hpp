@@ -0,0 +1,75 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: Unlicense
+
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <future>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace digitalcurling::client {
+
+/// @brief 起動処理を依存関係に従って並行に実行する
+///
+/// 各ステップは依存する全てのステップが完了した時点で別スレッドで開始される。
+/// 依存するステップが例外を送出した場合、そのステップは実行されずに同じ例外で失敗する。
+/// ステップの関数が参照する変数は、このオブジェクトより先に宣言しておくこと
+/// (破棄時に全てのステップの完了を待つため)。
+class StartupPipeline {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /// @brief ステップの実行時間
+    struct StepTiming {
+        /// @brief ステップ名
+        std::string name;
+        /// @brief 基準時刻からステップ開始までの時間
+        std::chrono::milliseconds start;
+        /// @brief 基準時刻からステップ終了までの時間
+        std::chrono::milliseconds end;
+    };
+
+    /// @brief コンストラクタ
+    /// @param origin 時間計測の基準時刻 (通常はプロセスの開始時刻)
+    explicit StartupPipeline(Clock::time_point origin = Clock::now());
+    StartupPipeline(StartupPipeline const&) = delete;
+    StartupPipeline& operator=(StartupPipeline const&) = delete;
+    ~StartupPipeline();
+
+    /// @brief ステップを追加する
+    /// @param name ステップ名
+    /// @param dependencies 依存するステップ名 (先に追加されている必要がある)
+    /// @param func ステップの処理
+    void AddStep(std::string name, std::vector<std::string> const& dependencies, std::function<void()> func);
+
+    /// @brief ステップの完了を表す `std::shared_future` を返す
+    /// @param name ステップ名
+    /// @return ステップの完了
+    std::shared_future<void> GetFuture(std::string const& name) const;
+
+    /// @brief ステップの完了を待つ
+    /// @param name ステップ名
+    /// @exception ステップが例外を送出した場合はその例外
+    void Wait(std::string const& name) const;
+
+    /// @brief 基準時刻からの経過時間を返す
+    /// @return 経過時間
+    std::chrono::milliseconds GetElapsed() const;
+
+    /// @brief 完了したステップの実行時間を返す
+    /// @return 完了した順の実行時間
+    std::vector<StepTiming> GetTimings() const;
+
+private:
+    Clock::time_point origin_;
+    std::map<std::string, std::shared_future<void>> steps_;
+
+    mutable std::mutex timings_mutex_;
+    std::vector<StepTiming> timings_;
+};
+
+} // namespace digitalcurling::client
@@ -0,0 +1,96 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: Unlicense
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <optional>
+#include <digitalcurling/digitalcurling.hpp>
+
+namespace digitalcurling::client {
+
+/// @brief 自チームのターンの思考の状態
+///
+/// クライアントは思考をイベント処理とは別のスレッドで行い、このオブジェクトを通して思考と連絡する。
+/// 思考エンジンは暫定の最善手を `Publish()` で公開しておくと、期限までに思考が終わらなかった場合に
+/// クライアントがその手を投げる。試合状況が変わった場合や期限を過ぎた場合は思考が取り消されるため、
+/// 長い探索では `IsCancelled()` を確認して早めに戻ること。
+class ThinkingContext {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /// @brief コンストラクタ
+    /// @param deadline 着手の期限 (`std::nullopt` なら期限なし)
+    explicit ThinkingContext(std::optional<Clock::time_point> deadline = std::nullopt)
+        : deadline_(deadline) {}
+    ThinkingContext(ThinkingContext const&) = delete;
+    ThinkingContext& operator=(ThinkingContext const&) = delete;
+
+    /// @brief 着手の期限を返す
+    /// @return 期限 (`std::nullopt` なら期限なし)
+    std::optional<Clock::time_point> GetDeadline() const { return deadline_; }
+
+    /// @brief 暫定の最善手を公開する
+    /// @param move 行動
+    void Publish(moves::Move const& move);
+
+    /// @brief 公開された暫定の最善手を返す
+    /// @return 行動 (公開されていなければ `std::nullopt`)
+    std::optional<moves::Move> GetBest() const;
+
+    /// @brief 選んだ手の評価値を報告する
+    ///
+    /// クライアントは用いないが、局面の解析では手と合わせて出力する。
+    /// @param value 手番のチームから見た評価値 (期待得点または勝率)
+    void ReportEvaluation(double value);
+
+    /// @brief 報告された評価値を返す
+    /// @return 評価値 (報告されていなければ `std::nullopt`)
+    std::optional<double> GetEvaluation() const;
+
+    /// @brief 思考を取り消す
+    void Cancel() { cancelled_.store(true, std::memory_order_release); }
+
+    /// @brief 思考が取り消されたかを返す
+    /// @return 取り消されたなら `true`
+    bool IsCancelled() const { return cancelled_.load(std::memory_order_acquire); }
+
+    /// @brief 呼び出したスレッドで実行中の思考の状態を返す
+    ///
+    /// 思考エンジンの `OnMyTurn()` からは、インターフェイスを変えずにこの関数で状態を取得できる。
+    /// 思考エンジンが内部で用いる別のスレッドからは取得できない。
+    /// @return 思考の状態 (思考中でなければ `nullptr`)
+    static ThinkingContext* GetCurrent();
+
+    /// @brief 呼び出したスレッドで実行中の思考が取り消されたかを返す
+    /// @return 思考中で、取り消されたなら `true`
+    static bool IsCurrentCancelled() {
+        auto const* context = GetCurrent();
+        return context != nullptr && context->IsCancelled();
+    }
+
+    /// @brief スコープ内でスレッドの実行中の思考の状態を設定する
+    class Scope {
+    public:
+        /// @brief コンストラクタ
+        /// @param context 思考の状態
+        explicit Scope(ThinkingContext& context);
+        Scope(Scope const&) = delete;
+        Scope& operator=(Scope const&) = delete;
+        ~Scope();
+
+    private:
+        ThinkingContext* previous_;
+    };
+
+private:
+    std::optional<Clock::time_point> const deadline_;
+    std::atomic<bool> cancelled_ = false;
+    mutable std::mutex mutex_;
+    std::optional<moves::Move> best_;
+    std::optional<double> evaluation_;
+};
+
+} // namespace digitalcurling::client
@@ -0,0 +1,62 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: Unlicense
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace digitalcurling::client {
+
+/// @brief 固定数のスレッドでタスクを実行するスレッドプール
+class ThreadPool {
+public:
+    /// @brief コンストラクタ
+    /// @param thread_count スレッド数 (0ならハードウェアのスレッド数)
+    explicit ThreadPool(std::size_t thread_count = 0);
+    ThreadPool(ThreadPool const&) = delete;
+    ThreadPool& operator=(ThreadPool const&) = delete;
+    ~ThreadPool();
+
+    /// @brief スレッド数を返す
+    /// @return スレッド数
+    std::size_t GetThreadCount() const { return threads_.size(); }
+
+    /// @brief タスクを追加する
+    /// @param func タスク
+    /// @return タスクの結果
+    template <typename TFunc>
+    auto Submit(TFunc&& func) -> std::future<std::invoke_result_t<TFunc>> {
+        auto task = std::make_shared<std::packaged_task<std::invoke_result_t<TFunc>()>>(std::forward<TFunc>(func));
+        auto future = task->get_future();
+        Push([task]() { (*task)(); });
+        return future;
+    }
+
+    /// @brief `[0, count)` の各インデックスについて関数を並列に実行する
+    ///
+    /// 呼び出し元のスレッドも処理に参加するため、タスクの中から呼び出してもデッドロックしない。
+    /// @param count 要素数
+    /// @param func 各インデックスに対して実行する関数
+    /// @exception 関数が例外を送出した場合は最初の例外
+    void ParallelFor(std::size_t count, std::function<void(std::size_t)> const& func);
+
+private:
+    std::vector<std::thread> threads_;
+    std::mutex mutex_;
+    std::condition_variable cond_var_;
+    std::queue<std::function<void()>> tasks_;
+    bool is_stopped_ = false;
+
+    void Push(std::function<void()> task);
+};
+
+} // namespace digitalcurling::client
@@ -0,0 +1,157 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: Unlicense
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+namespace digitalcurling::client {
+
+/// @brief アリーナの統計情報
+struct ArenaStatistics {
+    /// @brief 確保要求の回数
+    std::uint64_t allocations = 0;
+    /// @brief 確保したバイト数
+    std::uint64_t allocated_bytes = 0;
+    /// @brief 上位のメモリリソース (ヒープ) からチャンクを確保した回数
+    std::uint64_t upstream_allocations = 0;
+
+    ArenaStatistics& operator+=(ArenaStatistics const& other) {
+        allocations += other.allocations;
+        allocated_bytes += other.allocated_bytes;
+        upstream_allocations += other.upstream_allocations;
+        return *this;
+    }
+};
+
+/// @brief バンプアロケータによるメモリリソース
+///
+/// 確保はチャンク内のポインタを進めるだけで行い、個別の解放は行わない。
+/// `Reset()` で全ての確保を一括で破棄するが、チャンク自体は保持して次回以降に再利用するため、
+/// 一度十分な大きさまで成長すれば、以降は上位のメモリリソースを呼び出さない。
+/// 世代のカウンタを指定した場合は、確保の際にカウンタが進んでいれば先に `Reset()` を行う。
+/// 他のスレッドは、アリーナに触れずにカウンタを進めるだけで破棄を依頼できる。
+/// 1つのアリーナは1つのスレッドからのみ使用すること。
+/// デバッグビルド (`NDEBUG` が未定義) では、破棄した領域を埋め、破棄の前に確保したメモリが破棄の後に
+/// 解放された場合 (配列をターンをまたいで保持した場合など) や2重に解放された場合は、エラーを出力して異常終了する。
+class Arena : public std::pmr::memory_resource {
+public:
+    /// @brief コンストラクタ
+    /// @param chunk_size チャンクの大きさ
+    /// @param upstream チャンクを確保するメモリリソース
+    /// @param generation 世代のカウンタ (`nullptr` なら `Reset()` でのみ破棄する)
+    explicit Arena(
+        std::size_t chunk_size = 1 << 20,
+        std::pmr::memory_resource* upstream = std::pmr::new_delete_resource(),
+        std::atomic<std::uint64_t> const* generation = nullptr
+    );
+    Arena(Arena const&) = delete;
+    Arena& operator=(Arena const&) = delete;
+    ~Arena() override;
+
+    /// @brief 全ての確保を破棄し、統計情報をリセットする
+    ///
+    /// アリーナを使用するスレッドから呼び出すこと。
+    void Reset();
+
+    /// @brief 前回の `Reset()` 以降の統計情報を返す
+    /// @return 統計情報
+    ArenaStatistics GetStatistics() const;
+
+    /// @brief 確保しているメモリの世代を返す
+    /// @return 最後に `Reset()` した時点の世代のカウンタの値
+    std::uint64_t GetGeneration() const { return generation_.load(std::memory_order_acquire); }
+
+protected:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+    bool do_is_equal(std::pmr::memory_resource const& other) const noexcept override;
+
+private:
+    struct Chunk {
+        std::byte* data;
+        std::size_t size;
+    };
+
+    std::size_t chunk_size_;
+    std::pmr::memory_resource* upstream_;
+    std::atomic<std::uint64_t> const* generation_source_;
+    std::atomic<std::uint64_t> generation_ = 0;
+    std::vector<Chunk> chunks_;
+    std::size_t current_chunk_ = 0;
+    std::size_t offset_ = 0;
+#ifndef NDEBUG
+    /// @brief `Reset()` の回数 (確保ごとに記録し、解放の際に照合する)
+    std::uint64_t reset_count_ = 0;
+#endif
+
+    // 他スレッドから統計情報を読むため atomic とする (書き込みは所有スレッドのみ)
+    std::atomic<std::uint64_t> allocations_ = 0;
+    std::atomic<std::uint64_t> allocated_bytes_ = 0;
+    std::atomic<std::uint64_t> upstream_allocations_ = 0;
+
+    /// @brief チャンクからポインタを進めて確保する
+    void* Bump(std::size_t bytes, std::size_t alignment);
+};
+
+/// @brief ターンごとに一括で破棄されるスレッドローカルなアリーナ
+///
+/// 思考エンジンの一時的なメモリ確保に用いる。
+/// 各スレッドは `Local()` で自スレッド専用のアリーナを取得し、ロックなしで確保を行う。
+/// クライアントは各ターンの開始時に `BeginTurn()` を呼び出してターンを進める。各スレッドのアリーナは、
+/// そのスレッドが次に確保する際に破棄されるため、`BeginTurn()` は他のスレッドのアリーナに触れない。
+/// アリーナから確保したメモリは、確保したターンの間のみ使用できる。
+/// `BeginTurn()` の後、そのスレッドが次に確保した時点で前のターンのメモリは再利用されるため、
+/// `ArenaVector` などはターンをまたいで保持せず、次のターンで確保を行う前に破棄すること。
+class TurnArena {
+public:
+    TurnArena() = delete;
+
+    /// @brief 呼び出したスレッドのアリーナを返す
+    /// @return アリーナ
+    static Arena& Local();
+
+    /// @brief 新しいターンを開始する
+    ///
+    /// 全スレッドのアリーナは、それぞれの次の確保の際に破棄される。
+    /// 前のターンに確保した配列は、各スレッドが次に確保するまでに破棄しておくこと
+    /// (デバッグビルドでは、破棄の後に解放された場合に異常終了する)。
+    /// @return 前のターンの統計情報
+    static ArenaStatistics BeginTurn();
+
+    /// @brief 呼び出したスレッドのアリーナのみを直ちに破棄する
+    ///
+    /// 局面の解析などで、スレッドごとに独立して局面を進める場合に用いる。
+    static void ResetLocal();
+
+    /// @brief 現在のターンの統計情報を返す
+    /// @return 現在のターンに確保を行った全スレッドの統計情報の合計
+    static ArenaStatistics GetStatistics();
+
+    /// @brief 前のターンの統計情報を返す
+    /// @return 最後の `BeginTurn()` の時点の統計情報
+    static ArenaStatistics GetPreviousTurnStatistics();
+};
+
+/// @brief アリーナから確保を行う配列
+template <typename T>
+using ArenaVector = std::pmr::vector<T>;
+
+/// @brief 呼び出したスレッドのアリーナから確保を行う配列を作成する
+///
+/// 配列は作成したターンの間のみ有効であり、メンバー変数などに保持してターンをまたいではならない。
+/// また、作成したスレッド以外で要素を追加してはならない (確保は作成したスレッドのアリーナから行われる)。
+/// @param capacity 予約する要素数
+/// @return 配列
+template <typename T>
+ArenaVector<T> MakeArenaVector(std::size_t capacity = 0) {
+    ArenaVector<T> vec(&TurnArena::Local());
+    vec.reserve(capacity);
+    return vec;
+}
+
+} // namespace digitalcurling::client
@@ -0,0 +1,170 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: Unlicense
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <tuple>
+#include <vector>
+#include <digitalcurling/digitalcurling.hpp>
+#include "digitalcurling/client/mapped_file.hpp"
+
+namespace digitalcurling::client {
+
+/// @brief 1エンドの得点の分布
+///
+/// 得点は基準のチームから見た値 (相手チームの得点は負) とする。
+struct EndScoreDistribution {
+    /// @brief 記録する得点の範囲 (範囲外は丸める)
+    static constexpr int kMaxScore = 8;
+
+    /// @brief 各得点の確率 (`kMaxScore` を足した値でインデックスする)
+    std::array<double, 2 * kMaxScore + 1> probabilities {};
+
+    /// @brief 得点の確率を返す
+    /// @param score 得点
+    /// @return 確率
+    double Get(int score) const { return probabilities[Index(score)]; }
+
+    /// @brief 得点の確率を設定する
+    /// @param score 得点
+    /// @param probability 確率
+    void Set(int score, double probability) { probabilities[Index(score)] = probability; }
+
+    /// @brief 得点を1回分加える (加えた後に `Normalize()` で確率にする)
+    /// @param score 得点
+    /// @param weight 重み
+    void Add(int score, double weight = 1.) { probabilities[Index(score)] += weight; }
+
+    /// @brief 確率の和が1となるように正規化する
+    void Normalize();
+
+    /// @brief ハンマーを持つチームから見た既定の分布を返す
+    ///
+    /// 公式戦の統計を元にした概算値であり、ミックスダブルスは得点が大きくなりやすい。
+    /// @param rule_type 試合ルールの種類
+    /// @return 分布
+    static EndScoreDistribution GetDefault(GameRuleType rule_type);
+
+private:
+    static std::size_t Index(int score) {
+        return static_cast<std::size_t>(std::clamp(score, -kMaxScore, kMaxScore) + kMaxScore);
+    }
+};
+
+/// @brief 勝率表のキー
+struct WinProbabilityKey {
+    /// @brief 得点差の記録範囲 (範囲外は丸める)
+    static constexpr int kMaxScoreDifference = 15;
+    /// @brief 残りエンド数の記録範囲 (範囲外は丸める)
+    static constexpr int kMaxEndsRemaining = 16;
+
+    /// @brief 現在のエンドを含む規定の残りエンド数 (0ならエキストラエンド)
+    std::uint8_t ends_remaining = 0;
+    /// @brief 基準のチームから見た得点差
+    std::int8_t score_difference = 0;
+    /// @brief 基準のチームがハンマーを持つなら1
+    std::uint8_t has_hammer = 0;
+
+    /// @brief 試合状況からキーを生成する
+    /// @param game_state 試合状況
+    /// @param team 基準のチーム
+    /// @param max_end 規定のエンド数
+    /// @return キー
+    static WinProbabilityKey Create(GameState const& game_state, Team team, std::uint8_t max_end);
+
+    auto Tie() const { return std::tie(ends_remaining, score_difference, has_hammer); }
+    bool operator==(WinProbabilityKey const& other) const { return Tie() == other.Tie(); }
+};
+
+/// @brief 試合の勝率表
+///
+/// 残りエンド数、得点差、ハンマーの有無ごとに、エンド開始時点の勝率を保持する。
+/// 規定のエンドを終えて同点の場合はエキストラエンドとし、決着するまで続ける。
+/// ファイルには勝率を16ビットに量子化して保存し、メモリにマップして参照する。
+class WinProbabilityTable {
+public:
+    WinProbabilityTable() = default;
+    WinProbabilityTable(WinProbabilityTable const&) = delete;
+    WinProbabilityTable& operator=(WinProbabilityTable const&) = delete;
+    WinProbabilityTable(WinProbabilityTable&&) = default;
+    WinProbabilityTable& operator=(WinProbabilityTable&&) = default;
+
+    /// @brief 勝率表のファイルを開く
+    /// @param path ファイルのパス
+    /// @exception std::runtime_error ファイルを開けない場合や形式が不正な場合
+    explicit WinProbabilityTable(std::filesystem::path const& path);
+
+    /// @brief エンドの得点の分布から動的計画法で勝率表を作成する
+    /// @param distribution ハンマーを持つチームから見たエンドの得点の分布
+    /// @param rule_type 試合ルールの種類 (ブランクエンド後のハンマーの扱いに用いる)
+    /// @return 勝率表
+    static WinProbabilityTable Build(EndScoreDistribution const& distribution, GameRuleType rule_type);
+
+    /// @brief 勝率表を開いているかを返す
+    /// @return 開いているなら `true`
+    bool IsOpen() const { return values_ != nullptr; }
+
+    /// @brief 作成時の試合ルールの種類を返す
+    /// @return 試合ルールの種類
+    GameRuleType GetRuleType() const { return rule_type_; }
+
+    /// @brief エンド開始時点の勝率を返す
+    /// @param key キー
+    /// @return 基準のチームの勝率
+    float Get(WinProbabilityKey const& key) const;
+
+    /// @brief 現在のエンドを終えた時点の勝率を返す
+    /// @param key 現在のエンドのキー
+    /// @param end_score 現在のエンドの基準のチームから見た得点
+    /// @return 基準のチームの勝率
+    float GetAfterEnd(WinProbabilityKey const& key, int end_score) const;
+
+    /// @brief 現在のエンドの得点の分布から勝率の期待値を返す
+    /// @param key 現在のエンドのキー
+    /// @param distribution 基準のチームから見た現在のエンドの得点の分布
+    /// @return 基準のチームの勝率
+    float GetExpected(WinProbabilityKey const& key, EndScoreDistribution const& distribution) const;
+
+    /// @brief ファイルに保存する
+    /// @param path ファイルのパス
+    /// @exception std::runtime_error 書き込みに失敗した場合
+    void Save(std::filesystem::path const& path) const;
+
+private:
+    static constexpr std::size_t kDifferenceCount = 2 * WinProbabilityKey::kMaxScoreDifference + 1;
+    static constexpr std::size_t kValueCount = (WinProbabilityKey::kMaxEndsRemaining + 1) * kDifferenceCount * 2;
+
+    MappedFile file_;
+    std::vector<std::uint16_t> storage_;
+    std::uint16_t const* values_ = nullptr;
+    GameRuleType rule_type_ = GameRuleType::kStandard;
+
+    static std::size_t Index(int ends_remaining, int score_difference, bool has_hammer);
+    static float Decode(std::uint16_t value) { return value / 65535.f; }
+    float GetValue(int ends_remaining, int score_difference, bool has_hammer) const;
+};
+
+/// @brief 勝率表をファイルから読み込み、ないか試合ルールが異なる場合は既定の分布から作成して保存する
+/// @param path ファイルのパス
+/// @param rule_type 試合ルールの種類
+/// @return 勝率表
+WinProbabilityTable LoadOrBuildWinProbabilityTable(std::filesystem::path const& path, GameRuleType rule_type);
+
+/// @brief 勝率表の設定
+struct WinProbabilitySetting {
+    /// @brief 勝率表のファイルのパス
+    std::filesystem::path path;
+
+    /// @brief インスタンスを返す
+    /// @return インスタンス
+    static WinProbabilitySetting& GetInstance() {
+        static WinProbabilitySetting instance;
+        return instance;
+    }
+};
+
+} // namespace digitalcurling::client
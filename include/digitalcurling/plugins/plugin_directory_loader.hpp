@@ -0,0 +1,85 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: Unlicense
+
+#pragma once
+
+#ifndef DIGITALCURLING_CLIENT_USE_LOADER
+    #error "PluginDirectoryLoader needs digitalcurling_plugin_loader."
+#endif
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+#include <digitalcurling/plugins/plugin_manager.hpp>
+#include "digitalcurling/client/protocol_models.hpp"
+
+namespace digitalcurling::plugins {
+
+/// @brief プラグインの種類と名前
+struct PluginEntry {
+    PluginType type;
+    std::string name;
+};
+
+/// @brief ディレクトリからプラグインを読み込む
+///
+/// ファイルの内容は複数スレッドで並行して読み込み、`PluginManager` への登録のみを逐次に行う。
+/// マニフェストファイルを指定した場合は、ファイルとプラグインの対応を記録し、
+/// 以降の `LoadRequired()` では必要なファイルのみを読み込む。
+class PluginDirectoryLoader {
+public:
+    /// @brief 読み込み結果
+    struct Result {
+        /// @brief 読み込んだプラグイン
+        std::vector<PluginEntry> loaded;
+        /// @brief 読み込みに失敗したファイルとエラーメッセージ
+        std::vector<std::pair<std::filesystem::path, std::string>> errors;
+    };
+
+    /// @brief コンストラクタ
+    /// @param plugin_dir プラグインのディレクトリ
+    /// @param manifest_path マニフェストファイルのパス (`std::nullopt` ならキャッシュしない)
+    PluginDirectoryLoader(
+        std::filesystem::path plugin_dir,
+        std::optional<std::filesystem::path> manifest_path = std::nullopt
+    );
+
+    /// @brief ディレクトリ内の全てのプラグインを読み込む
+    /// @return 読み込み結果
+    Result LoadAll();
+
+    /// @brief 指定したプラグインのみを読み込む
+    ///
+    /// 読み込み済みのプラグインは無視する。マニフェストで提供元が分からないプラグインがある場合に限り、
+    /// マニフェストに記録されていないファイルを読み込んで探索する。
+    /// @param required 必要なプラグイン
+    /// @return 読み込み結果
+    Result LoadRequired(std::vector<PluginEntry> const& required);
+
+    /// @brief 試合に必要なプラグインを返す
+    /// @param match_info 試合情報
+    /// @return 必要なプラグインのリスト
+    static std::vector<PluginEntry> GetRequiredPlugins(client::MatchInfo const& match_info);
+
+private:
+    struct ManifestEntry {
+        std::string file;
+        std::uintmax_t size;
+        std::int64_t mtime;
+        std::optional<PluginEntry> plugin;
+    };
+
+    std::filesystem::path plugin_dir_;
+    std::optional<std::filesystem::path> manifest_path_;
+    std::vector<ManifestEntry> manifest_;
+
+    void LoadManifest();
+    void SaveManifest() const;
+    ManifestEntry const* FindManifestEntry(std::filesystem::path const& path) const;
+    std::vector<std::filesystem::path> GetPluginFiles() const;
+    void LoadFiles(std::vector<std::filesystem::path> const& files, Result& result);
+};
+
+} // namespace digitalcurling::plugins
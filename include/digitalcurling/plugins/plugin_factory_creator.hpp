@@ -8,24 +8,54 @@
 #endif
 
 #include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 #include <digitalcurling/plugins/plugin_manager.hpp>
 #include "digitalcurling/client/i_factory_creator.hpp"
 
 namespace digitalcurling::plugins {
 
+/// @brief プラグインからプレイヤーとシミュレータのファクトリーを生成する
+///
+/// 生成したファクトリーは JSON ごとに保持し、同一の JSON に対しては複製を返す。
 class PluginFactoryCreator : public client::IFactoryCreator {
 public:
     virtual inline std::unique_ptr<players::IPlayerFactory> CreatePlayerFactory(nlohmann::json const& json) override {
-        auto& manager = digitalcurling::plugins::PluginManager::GetInstance();
-        if (!manager.IsPluginLoaded(digitalcurling::plugins::PluginType::player, json["type"]))
-            throw std::runtime_error("PluginFactoryCreator: player plugin not loaded: " + json["type"].get<std::string>());
-        return manager.CreatePlayerFactory(json);
+        return CreateCached(player_factories_, json, [&json]() {
+            auto& manager = digitalcurling::plugins::PluginManager::GetInstance();
+            if (!manager.IsPluginLoaded(digitalcurling::plugins::PluginType::player, json["type"]))
+                throw std::runtime_error("PluginFactoryCreator: player plugin not loaded: " + json["type"].get<std::string>());
+            return manager.CreatePlayerFactory(json);
+        });
     }
     virtual inline std::unique_ptr<simulators::ISimulatorFactory> CreateSimulatorFactory(nlohmann::json const& json) override {
-        auto& manager = digitalcurling::plugins::PluginManager::GetInstance();
-        if (!manager.IsPluginLoaded(digitalcurling::plugins::PluginType::simulator, json["type"]))
-            throw std::runtime_error("PluginFactoryCreator: simulator plugin not loaded: " + json["type"].get<std::string>());
-        return manager.CreateSimulatorFactory(json);
+        return CreateCached(simulator_factories_, json, [&json]() {
+            auto& manager = digitalcurling::plugins::PluginManager::GetInstance();
+            if (!manager.IsPluginLoaded(digitalcurling::plugins::PluginType::simulator, json["type"]))
+                throw std::runtime_error("PluginFactoryCreator: simulator plugin not loaded: " + json["type"].get<std::string>());
+            return manager.CreateSimulatorFactory(json);
+        });
+    }
+
+private:
+    std::mutex mutex_;
+    std::unordered_map<std::string, std::unique_ptr<players::IPlayerFactory>> player_factories_;
+    std::unordered_map<std::string, std::unique_ptr<simulators::ISimulatorFactory>> simulator_factories_;
+
+    template <typename TFactory, typename TCreate>
+    std::unique_ptr<TFactory> CreateCached(
+        std::unordered_map<std::string, std::unique_ptr<TFactory>>& cache,
+        nlohmann::json const& json,
+        TCreate&& create
+    ) {
+        auto key = json.dump();
+        std::lock_guard lock(mutex_);
+        auto it = cache.find(key);
+        if (it == cache.end()) {
+            it = cache.emplace(std::move(key), create()).first;
+        }
+        return it->second->Clone();
     }
 };
 
@@ -9,8 +9,10 @@
 
 #include <string>
 #include <sstream>
+#include <typeindex>
 #include <nlohmann/json.hpp>
 #include "digitalcurling/plugins/plugin_loader.hpp"
+#include "digitalcurling/plugins/plugin_registry.hpp"
 
 using nlohmann::json;
 
@@ -23,24 +25,13 @@ static_assert(std::is_base_of_v<JsonConverter<T>, TPlugin>);
 static_assert(std::is_base_of_v<IPlugin, TPlugin>);
 
 private:
-    static void Convert(
-        std::vector<std::shared_ptr<TPlugin>> (digitalcurling::plugins::PluginLoader::*plugin_func)(),
-        std::function<bool(JsonConverter<T> *)> func,
-        std::string const& target_name
-    ){
-        std::vector<std::shared_ptr<TPlugin>> plugins = (plugins::PluginLoader::GetInstance()->*plugin_func)();
-        bool found = false;
-        for (std::shared_ptr<TPlugin> plugin : plugins) {
-            auto converter = dynamic_cast<JsonConverter<T>*>(plugin.get());
-            if (converter && (found = func(converter))) break;
-        }
+    using Index = JsonConverterIndex<TPlugin, T>;
 
-        if (!found) {
-            std::ostringstream stream;
-            stream << "adl_serializer<" << typeid(T).name() << ">: no plugin found for " << target_name << ".";
-            throw std::runtime_error(stream.str());
-        }
-    };
+    [[noreturn]] static void ThrowNotFound(std::string const& target_name) {
+        std::ostringstream stream;
+        stream << "adl_serializer<" << typeid(T).name() << ">: no plugin found for " << target_name << ".";
+        throw std::runtime_error(stream.str());
+    }
 
 public:
     inline static void ToJson(
@@ -51,7 +42,9 @@ public:
         auto func = [&j, &v] (JsonConverter<T> *converter) {
             return converter->ToJson(j, v);
         };
-        Convert(plugin_func, func, "class:" + std::string(typeid(v).name()));
+        if (!Index::GetInstance().ConvertByTypeId(plugin_func, std::type_index(typeid(v)), func)) {
+            ThrowNotFound("class:" + std::string(typeid(v).name()));
+        }
     };
 
     inline static void FromJson(
@@ -63,7 +56,10 @@ public:
         auto func = [&j, &v] (JsonConverter<T> *converter) {
             return converter->FromJson(j, v);
         };
-        Convert(plugin_func, func, "json:" + j.at("type").get<std::string>());
+        auto const type = j.at("type").get<std::string>();
+        if (!Index::GetInstance().ConvertByType(plugin_func, type, func)) {
+            ThrowNotFound("json:" + type);
+        }
     };
 };
 
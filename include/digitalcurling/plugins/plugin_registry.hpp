@@ -0,0 +1,135 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: Unlicense
+
+#pragma once
+
+#ifndef DIGITALCURLING_CLIENT_USE_LOADER
+    #error "PluginRegistry needs digitalcurling_plugin_loader."
+#endif
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+#include "digitalcurling/plugins/plugin_loader.hpp"
+
+namespace digitalcurling::plugins {
+
+/// @brief 読み込み済みプラグインの索引の世代を管理する
+///
+/// プラグインを読み込んだ後に `Invalidate()` を呼び出すと、各索引は次回の検索時に一度だけ再構築される。
+class PluginRegistry {
+public:
+    PluginRegistry() = delete;
+
+    /// @brief 全ての索引を無効化する
+    static void Invalidate() {
+        GetGenerationCounter().fetch_add(1, std::memory_order_release);
+    }
+
+    /// @brief 現在の世代を返す
+    /// @return 世代
+    static std::uint64_t GetGeneration() {
+        return GetGenerationCounter().load(std::memory_order_acquire);
+    }
+
+private:
+    static std::atomic<std::uint64_t>& GetGenerationCounter() {
+        static std::atomic<std::uint64_t> generation = 0;
+        return generation;
+    }
+};
+
+/// @brief プラグインの `JsonConverter` の索引
+///
+/// 各プラグインの `dynamic_cast` は構築時に一度だけ行う。
+/// JSON の `type` 文字列と C++ の型 (`typeid`) それぞれについて、変換に成功したコンバーターを記録し、
+/// 以降は O(1) で検索する。
+/// @tparam TPlugin プラグインの基底クラス
+/// @tparam T 変換対象の型
+template <typename TPlugin, typename T>
+class JsonConverterIndex {
+public:
+    using PluginFunc = std::vector<std::shared_ptr<TPlugin>> (PluginLoader::*)();
+
+    /// @brief 索引を返す
+    /// @return 索引
+    static JsonConverterIndex& GetInstance() {
+        static JsonConverterIndex instance;
+        return instance;
+    }
+
+    /// @brief `type` 文字列をキーとしてコンバーターを検索し、変換を行う
+    /// @param plugin_func プラグインを取得する関数
+    /// @param type JSON の `type` 文字列
+    /// @param func 変換を行う関数 (成功したら `true` を返す)
+    /// @return 変換に成功したら `true`
+    template <typename TFunc>
+    bool ConvertByType(PluginFunc plugin_func, std::string const& type, TFunc&& func) {
+        return Convert(plugin_func, &JsonConverterIndex::by_type_, type, func);
+    }
+
+    /// @brief `typeid` をキーとしてコンバーターを検索し、変換を行う
+    /// @param plugin_func プラグインを取得する関数
+    /// @param type C++ の型
+    /// @param func 変換を行う関数 (成功したら `true` を返す)
+    /// @return 変換に成功したら `true`
+    template <typename TFunc>
+    bool ConvertByTypeId(PluginFunc plugin_func, std::type_index type, TFunc&& func) {
+        return Convert(plugin_func, &JsonConverterIndex::by_typeid_, type, func);
+    }
+
+private:
+    std::shared_mutex mutex_;
+    std::uint64_t generation_ = ~std::uint64_t(0);
+    std::vector<std::shared_ptr<TPlugin>> plugins_;
+    std::vector<JsonConverter<T>*> converters_;
+    std::unordered_map<std::string, JsonConverter<T>*> by_type_;
+    std::unordered_map<std::type_index, JsonConverter<T>*> by_typeid_;
+
+    JsonConverterIndex() = default;
+
+    template <typename TKey, typename TFunc>
+    bool Convert(
+        PluginFunc plugin_func,
+        std::unordered_map<TKey, JsonConverter<T>*> JsonConverterIndex::* map,
+        TKey const& key,
+        TFunc& func
+    ) {
+        auto const generation = PluginRegistry::GetGeneration();
+        {
+            std::shared_lock lock(mutex_);
+            if (generation_ == generation) {
+                auto it = (this->*map).find(key);
+                if (it != (this->*map).end() && func(it->second)) return true;
+            }
+        }
+
+        std::unique_lock lock(mutex_);
+        if (generation_ != generation) {
+            plugins_ = (PluginLoader::GetInstance()->*plugin_func)();
+            converters_.clear();
+            for (auto const& plugin : plugins_) {
+                if (auto converter = dynamic_cast<JsonConverter<T>*>(plugin.get())) converters_.push_back(converter);
+            }
+            by_type_.clear();
+            by_typeid_.clear();
+            generation_ = generation;
+        }
+
+        for (auto converter : converters_) {
+            if (func(converter)) {
+                (this->*map)[key] = converter;
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+} // namespace digitalcurling::plugins
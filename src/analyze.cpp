@@ -0,0 +1,361 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: Unlicense
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <variant>
+#include <vector>
+#include <CLI/CLI.hpp>
+#include <nlohmann/json.hpp>
+#include "digitalcurling/client/async_logger.hpp"
+#include "digitalcurling/client/delivery_order_optimizer.hpp"
+#include "digitalcurling/client/endgame_solver.hpp"
+#include "digitalcurling/client/i_factory_creator.hpp"
+#include "digitalcurling/client/i_thinking_engine.hpp"
+#include "digitalcurling/client/opening_book.hpp"
+#include "digitalcurling/client/position_file.hpp"
+#include "digitalcurling/client/positioned_stone_decider.hpp"
+#include "digitalcurling/client/protocol_models.hpp"
+#include "digitalcurling/client/simulation_evaluator.hpp"
+#include "digitalcurling/client/thinking_context.hpp"
+#include "digitalcurling/client/turn_arena.hpp"
+#include "digitalcurling/client/win_probability_table.hpp"
+
+#ifdef DIGITALCURLING_CLIENT_USE_LOADER
+    #include "digitalcurling/plugins/plugin_directory_loader.hpp"
+#endif
+
+using namespace digitalcurling::client;
+
+std::unique_ptr<IFactoryCreator> CreateFactoryCreator();
+std::unique_ptr<IThinkingEngine> CreateThinkingEngine();
+
+namespace {
+
+constexpr std::string_view CLIENT_NAME = DIGITALCURLING_CLIENT_NAME;
+
+/// @brief 1局面の解析結果
+struct AnalysisResult {
+    /// @brief 選んだ手 (失敗した場合は `std::nullopt`)
+    std::optional<digitalcurling::moves::Move> move;
+    /// @brief 思考エンジンが報告した評価値
+    std::optional<double> evaluation;
+    /// @brief 思考時間
+    std::chrono::milliseconds think_time { 0 };
+    /// @brief 期限を過ぎたなら `true`
+    bool timed_out = false;
+    /// @brief 失敗した場合のエラーメッセージ
+    std::string error;
+};
+
+/// @brief 局面を解析する思考エンジン
+///
+/// 試合の設定で思考エンジンを初期化し、局面ごとに新しい試合の途中として手を求める。
+/// スレッドセーフではないため、並列に解析する場合はエンジンごとにインスタンスを作成する。
+class AnalysisEngine {
+public:
+    AnalysisEngine(MatchInfo const& match_info, IFactoryCreator& factory_creator)
+      : engine_(CreateThinkingEngine()),
+        rule_type_(match_info.rule.type)
+    {
+        for (auto const& player : match_info.players) {
+            players_.push_back(factory_creator.CreatePlayerFactory(player));
+        }
+        players_index_ = engine_->OnInit(
+            match_info.rule,
+            match_info.setting,
+            factory_creator.CreateSimulatorFactory(match_info.simulator),
+            players_
+        );
+        if (players_index_.size() != players_.size()) {
+            throw std::runtime_error("AnalysisEngine: Number of players after OnInit is not " + std::to_string(players_.size()));
+        }
+        engine_->OnWarmUp();
+    }
+
+    /// @brief 局面の手を求める
+    /// @param position 局面
+    /// @param think_time 思考時間 (`std::nullopt` なら局面の残り思考時間)
+    /// @return 解析結果
+    AnalysisResult Analyze(AnalysisPosition const& position, std::optional<std::chrono::milliseconds> think_time) {
+        auto const& game_state = position.game_state;
+        if (!think_time.has_value() && game_state.thinking_time_remaining[position.team] > std::chrono::milliseconds(0)) {
+            think_time = game_state.thinking_time_remaining[position.team];
+        }
+
+        auto const start = ThinkingContext::Clock::now();
+        std::optional<ThinkingContext::Clock::time_point> deadline;
+        if (think_time.has_value()) deadline = start + think_time.value();
+
+        AnalysisResult result;
+        ThinkingContext context(deadline);
+        try {
+            engine_->OnGameStart(position.team, { { game_state, position.last_shot } });
+            if (game_state.shot == 0) engine_->OnNextEnd(game_state);
+
+            ThinkingContext::Scope scope(context);
+            result.move = engine_->OnMyTurn(GetPlayer(game_state), game_state, position.last_shot);
+        } catch (std::exception const& e) {
+            result.error = e.what();
+        }
+
+        auto const end = ThinkingContext::Clock::now();
+        result.evaluation = context.GetEvaluation();
+        result.think_time = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+        result.timed_out = deadline.has_value() && end > deadline.value();
+        return result;
+    }
+
+private:
+    std::unique_ptr<IThinkingEngine> engine_;
+    digitalcurling::GameRuleType rule_type_;
+    std::vector<std::unique_ptr<digitalcurling::players::IPlayerFactory>> players_;
+    std::vector<std::uint8_t> players_index_;
+
+    /// @brief 手番のプレイヤーを返す (各クライアントの `OnMyTurn()` と同じ対応)
+    std::unique_ptr<digitalcurling::players::IPlayerFactory> const& GetPlayer(digitalcurling::GameState const& game_state) const {
+        std::size_t index = game_state.shot / 2;
+        if (rule_type_ == digitalcurling::GameRuleType::kMixedDoubles) {
+            index = game_state.shot == 0 || game_state.shot == 4 ? 0 : 1;
+        }
+        return players_[players_index_[std::min(index, players_index_.size() - 1)]];
+    }
+};
+
+nlohmann::json ToJson(digitalcurling::moves::Move const& move) {
+    if (std::holds_alternative<digitalcurling::moves::Shot>(move)) {
+        auto const& shot = std::get<digitalcurling::moves::Shot>(move);
+        return {
+            { "type", "shot" },
+            { "translational_velocity", shot.translational_velocity },
+            { "angular_velocity", shot.angular_velocity },
+            { "release_angle", shot.release_angle }
+        };
+    }
+    return { { "type", "concede" } };
+}
+
+nlohmann::json ToJson(AnalysisPosition const& position, AnalysisResult const& result) {
+    nlohmann::json json = {
+        { "id", position.id },
+        { "team", position.team },
+        { "end", position.game_state.end },
+        { "shot", position.game_state.shot },
+        { "move", result.move.has_value() ? ToJson(result.move.value()) : nlohmann::json(nullptr) },
+        { "evaluation", result.evaluation.has_value() ? nlohmann::json(result.evaluation.value()) : nlohmann::json(nullptr) },
+        { "think_time_ms", result.think_time.count() },
+        { "timed_out", result.timed_out }
+    };
+    if (!result.error.empty()) json["error"] = result.error;
+    return json;
+}
+
+} // namespace
+
+int main(int argc, char const* argv[])
+{
+    /* Command line arguments */
+    const std::string app_text = "Digital Curling Position Analyzer: " + std::string(CLIENT_NAME);
+
+    CLI::App app{app_text};
+    app.set_version_flag("-v,--version",
+        app_text + "\n"
+        "Library Version: " + digitalcurling::LibraryVersion.ToString()
+    );
+
+    bool is_debug;
+    app.add_flag("-d,--debug", is_debug, "Enable debug mode")->default_val(false)->force_callback();
+
+    std::string match_file, positions_file, output_file, save_positions;
+    app.add_option("--match", match_file, "The JSON file of the match information (rule, simulator) in the server format")->required()->check(CLI::ExistingFile);
+    app.add_option("--positions", positions_file, "The file of positions to analyze (JSONL of game states or the binary position format)")->required()->check(CLI::ExistingFile);
+    app.add_option("-o,--output", output_file, "The JSONL file to write the results to (default: standard output)");
+    app.add_option("--save-positions", save_positions, "Convert the positions to the binary position format and exit");
+
+    std::size_t engine_count;
+    app.add_option("--engines", engine_count, "The number of engines to analyze positions in parallel")->default_val(1)->check(CLI::Range(1, 256))->force_callback();
+    std::size_t threads_per_engine;
+    app.add_option("--threads-per-engine", threads_per_engine, "The number of simulation threads per engine (0 to divide the hardware threads)")->default_val(0)->force_callback();
+    std::uint32_t think_time_ms;
+    app.add_option("--think-time", think_time_ms, "The thinking time per position in milliseconds (0 to use the remaining time of the position)")->default_val(0)->force_callback();
+
+#ifdef DIGITALCURLING_CLIENT_USE_LOADER
+    std::string plugin_dir;
+    app.add_option("--plugin-dir", plugin_dir, "The directory to load plugins from")->check(CLI::ExistingDirectory);
+    double screening_seconds_per_frame;
+    app.add_option("--screening-seconds-per-frame", screening_seconds_per_frame, "The timestep of the coarse simulator used to screen candidates (0 to disable)")->default_val(0.)->check(CLI::Range(0., 0.1))->force_callback();
+#endif
+    std::string cache_dir;
+    app.add_option("--cache-dir", cache_dir, "The directory to store cache files")->default_str("./cache")->force_callback();
+    std::string opening_book;
+    app.add_option("--opening-book", opening_book, "The opening book file (default: <cache-dir>/opening_book.bin)");
+    bool is_free_path;
+    app.add_flag("--free-path", is_free_path, "Predict shots that cannot touch another stone from a trajectory table instead of simulating them (slightly changes results)")->default_val(false)->force_callback();
+    bool is_checkpoints;
+    app.add_flag("--checkpoints", is_checkpoints, "Start simulations from the interpolated state just before the first possible contact (slightly changes results)")->default_val(false)->force_callback();
+
+    CLI11_PARSE(app, argc, argv);
+
+    auto& logger = AsyncLogger::GetInstance();
+    logger.SetConsoleLevel(is_debug ? LogLevel::kDebug : LogLevel::kWarning);
+
+    MatchInfo match_info;
+    std::vector<AnalysisPosition> positions;
+    try {
+        std::ifstream ifs(match_file);
+        if (!ifs) {
+            throw std::runtime_error("Failed to open " + match_file);
+        }
+        match_info = nlohmann::json::parse(ifs).get<MatchInfo>();
+        positions = LoadPositions(positions_file, match_info.setting);
+
+        if (!save_positions.empty()) {
+            SavePositions(save_positions, positions);
+            std::cerr << "Saved " << positions.size() << " positions to " << save_positions << std::endl;
+            return 0;
+        }
+        if (positions.empty()) {
+            throw std::runtime_error("No positions in " + positions_file);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "[Error] " << e.what() << std::endl;
+        return 1;
+    }
+
+    /* Settings */
+    // 以降はエンジン数で割るため、局面数で制限した後も1以上に保つ (局面が空の場合は上で終了している)
+    engine_count = std::max<std::size_t>(1, std::min(engine_count, positions.size()));
+    // 各エンジンの評価器のスレッドが、合わせてハードウェアのスレッド数になるようにする
+    auto& evaluator_setting = SimulationEvaluatorSetting::GetInstance();
+    evaluator_setting.thread_count = threads_per_engine != 0
+        ? threads_per_engine
+        : std::max<std::size_t>(1, std::thread::hardware_concurrency() / engine_count);
+    evaluator_setting.free_path = is_free_path;
+    evaluator_setting.checkpoints = is_checkpoints;
+#ifdef DIGITALCURLING_CLIENT_USE_LOADER
+    evaluator_setting.screening_seconds_per_frame = screening_seconds_per_frame;
+#endif
+    OpeningBookSetting::GetInstance().path = opening_book.empty()
+        ? std::filesystem::path(cache_dir) / "opening_book.bin"
+        : std::filesystem::path(opening_book);
+    // 解いた盤面を共有すると結果が局面の順序に依存するため、エンドゲームのテーブルは用いない
+    EndgameSolverSetting::GetInstance().table_path.clear();
+    WinProbabilitySetting::GetInstance().path = std::filesystem::path(cache_dir) / "win_probability.bin";
+    PositionedStoneSetting::GetInstance().cache_path = std::filesystem::path(cache_dir) / "positioned_stone.json";
+    DeliveryOrderSetting::GetInstance().cache_path = std::filesystem::path(cache_dir) / "delivery_order.json";
+
+    std::optional<std::chrono::milliseconds> think_time;
+    if (think_time_ms != 0) think_time = std::chrono::milliseconds(think_time_ms);
+
+    std::ofstream output_stream;
+    if (!output_file.empty()) {
+        output_stream.open(output_file, std::ios::trunc);
+        if (!output_stream) {
+            std::cerr << "[Error] Failed to open " << output_file << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& output = output_file.empty() ? std::cout : output_stream;
+
+    /* Analysis */
+    std::vector<AnalysisResult> results(positions.size());
+    std::chrono::steady_clock::duration analysis_time {};
+    try {
+#ifdef DIGITALCURLING_CLIENT_USE_LOADER
+        if (app.count("--plugin-dir") == 0 && std::filesystem::is_directory("./plugins")) {
+            plugin_dir = "./plugins";
+        }
+        if (!plugin_dir.empty()) {
+            using digitalcurling::plugins::PluginDirectoryLoader;
+            PluginDirectoryLoader loader(plugin_dir, std::filesystem::path(cache_dir) / "plugin_manifest.json");
+            loader.LoadRequired(PluginDirectoryLoader::GetRequiredPlugins(match_info));
+        }
+#endif
+        auto const factory_creator = CreateFactoryCreator();
+
+        // 最初のエンジンが投球順などのキャッシュを作成してから、残りのエンジンを並行して準備する
+        std::cerr << "Preparing " << engine_count << " engine(s) ... " << std::flush;
+        std::vector<std::unique_ptr<AnalysisEngine>> engines(engine_count);
+        engines[0] = std::make_unique<AnalysisEngine>(match_info, *factory_creator);
+        {
+            std::vector<std::future<void>> futures;
+            for (std::size_t i = 1; i < engine_count; ++i) {
+                futures.push_back(std::async(std::launch::async, [&engines, &match_info, i]() {
+                    engines[i] = std::make_unique<AnalysisEngine>(match_info, *CreateFactoryCreator());
+                }));
+            }
+            for (auto& future : futures) future.get();
+        }
+        std::cerr << "OK" << std::endl;
+
+        // 各エンジンは共有の待ち行列から次の局面を取り出し、他のエンジンを待たずに解析する
+        std::atomic<std::size_t> next_position = 0;
+        std::mutex output_mutex;
+        std::vector<bool> is_analyzed(positions.size(), false);
+        std::size_t output_count = 0;
+
+        auto const start = std::chrono::steady_clock::now();
+        std::vector<std::future<void>> futures;
+        for (auto& engine : engines) {
+            futures.push_back(std::async(std::launch::async, [&, &engine = *engine]() {
+                for (std::size_t i; (i = next_position.fetch_add(1)) < positions.size();) {
+                    // 局面ごとに独立して思考するため、このスレッドのアリーナのみを破棄する
+                    TurnArena::ResetLocal();
+                    auto result = engine.Analyze(positions[i], think_time);
+
+                    // 結果は局面の順に出力する
+                    std::lock_guard lock(output_mutex);
+                    results[i] = std::move(result);
+                    is_analyzed[i] = true;
+                    for (; output_count < positions.size() && is_analyzed[output_count]; ++output_count) {
+                        output << ToJson(positions[output_count], results[output_count]).dump() << '\n';
+                    }
+                    output.flush();
+                    std::cerr << "\rAnalyzed " << output_count << " / " << positions.size() << std::flush;
+                }
+            }));
+        }
+        for (auto& future : futures) future.get();
+        analysis_time = std::chrono::steady_clock::now() - start;
+        std::cerr << std::endl;
+    } catch (const std::exception& e) {
+        logger.Flush();
+        std::cerr << "[Error] " << e.what() << std::endl;
+        return 1;
+    }
+    logger.Flush();
+
+    /* Summary */
+    std::size_t error_count = 0, timed_out_count = 0;
+    std::chrono::milliseconds total_think_time { 0 };
+    for (auto const& result : results) {
+        if (!result.error.empty()) error_count++;
+        if (result.timed_out) timed_out_count++;
+        total_think_time += result.think_time;
+    }
+    double const seconds = std::chrono::duration<double>(analysis_time).count();
+    std::fprintf(stderr,
+        "[Summary]\n"
+        "  Positions: %zu (errors: %zu, timed out: %zu)\n"
+        "  Engines: %zu x %zu threads\n"
+        "  Wall time: %.2f s (%.2f positions/s)\n"
+        "  Mean think time: %.1f ms\n",
+        positions.size(), error_count, timed_out_count,
+        engine_count, evaluator_setting.thread_count,
+        seconds, seconds > 0. ? positions.size() / seconds : 0.,
+        static_cast<double>(total_think_time.count()) / positions.size()
+    );
+    return error_count == 0 ? 0 : 1;
+}
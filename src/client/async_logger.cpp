@@ -0,0 +1,185 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: Unlicense
+
+#include <algorithm>
+#include <cstdarg>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+#include "digitalcurling/client/async_logger.hpp"
+
+namespace digitalcurling::client {
+
+namespace {
+
+constexpr char const* kLevelNames[] = { "DEBUG", "INFO", "WARN", "ERROR" };
+constexpr char const* kConsolePrefixes[] = { "[Debug] ", "", "[Warning] ", "[Error] " };
+constexpr std::string_view kTruncationMarker = "...";
+
+} // namespace
+
+AsyncLogger& AsyncLogger::GetInstance() {
+    static AsyncLogger instance;
+    return instance;
+}
+
+AsyncLogger::AsyncLogger()
+  : origin_(std::chrono::steady_clock::now()),
+    slots_(std::make_unique<Slot[]>(kCapacity))
+{
+    for (std::size_t i = 0; i < kCapacity; ++i) {
+        slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    writer_thread_ = std::thread([this]() { Run(); });
+}
+
+AsyncLogger::~AsyncLogger() {
+    {
+        std::lock_guard lock(wake_mutex_);
+        is_stopped_.store(true, std::memory_order_release);
+    }
+    wake_cond_.notify_one();
+    if (writer_thread_.joinable()) writer_thread_.join();
+    if (file_ != nullptr) std::fclose(file_);
+}
+
+void AsyncLogger::OpenFile(std::filesystem::path const& path) {
+    std::FILE* file = std::fopen(path.string().c_str(), "a");
+    if (file == nullptr) {
+        throw std::runtime_error("AsyncLogger: failed to open log file: " + path.string());
+    }
+
+    std::lock_guard lock(file_mutex_);
+    if (file_ != nullptr) std::fclose(file_);
+    file_ = file;
+}
+
+void AsyncLogger::Log(LogLevel level, char const* tag, char const* format, ...) {
+    // 有界 MPMC キュー (Vyukov) の追加処理。スロットを予約した後、その場でレコードを書き込む
+    auto position = enqueue_position_.load(std::memory_order_relaxed);
+    Slot* slot;
+    while (true) {
+        slot = &slots_[position % kCapacity];
+        auto const sequence = slot->sequence.load(std::memory_order_acquire);
+        auto const diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+        if (diff == 0) {
+            if (enqueue_position_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+        } else if (diff < 0) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        } else {
+            position = enqueue_position_.load(std::memory_order_relaxed);
+        }
+    }
+
+    auto& record = slot->record;
+    record.timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - origin_).count();
+    record.level = level;
+    std::strncpy(record.tag, tag, LogRecord::kTagSize - 1);
+    record.tag[LogRecord::kTagSize - 1] = '\0';
+
+    std::va_list args;
+    va_start(args, format);
+    auto const length = std::vsnprintf(record.message, LogRecord::kMessageSize, format, args);
+    va_end(args);
+
+    record.length = static_cast<std::uint32_t>(std::clamp<int>(length, 0, LogRecord::kMessageSize - 1));
+    if (length >= static_cast<int>(LogRecord::kMessageSize)) {
+        // 収まらない部分は切り捨て、切り捨てたことが分かるよう末尾を置き換える
+        std::memcpy(record.message + record.length - kTruncationMarker.size(), kTruncationMarker.data(), kTruncationMarker.size());
+    }
+
+    slot->sequence.store(position + 1, std::memory_order_release);
+    Wake();
+}
+
+void AsyncLogger::Flush() {
+    auto const target = enqueue_position_.load(std::memory_order_acquire);
+    std::unique_lock lock(wake_mutex_);
+    flushed_cond_.wait(lock, [this, target]() {
+        return dequeue_position_.load(std::memory_order_acquire) >= target;
+    });
+}
+
+bool AsyncLogger::HasRecord() const {
+    auto const position = dequeue_position_.load(std::memory_order_relaxed);
+    return slots_[position % kCapacity].sequence.load(std::memory_order_acquire) == position + 1;
+}
+
+void AsyncLogger::Wake() {
+    // 書き込みスレッドの待機の開始との順序を保証し、待機中の場合のみロックを取って起こす
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!is_writer_waiting_.load(std::memory_order_relaxed)) return;
+    std::lock_guard lock(wake_mutex_);
+    wake_cond_.notify_one();
+}
+
+bool AsyncLogger::TryPop(LogRecord& record) {
+    auto const position = dequeue_position_.load(std::memory_order_relaxed);
+    auto& slot = slots_[position % kCapacity];
+    if (slot.sequence.load(std::memory_order_acquire) != position + 1) return false;
+
+    record = slot.record;
+    slot.sequence.store(position + kCapacity, std::memory_order_release);
+    return true;
+}
+
+void AsyncLogger::Write(LogRecord const& record) {
+    auto const level = static_cast<std::size_t>(record.level);
+    if (record.level >= console_level_.load(std::memory_order_relaxed)) {
+        std::FILE* stream = record.level == LogLevel::kError ? stderr : stdout;
+        auto const message = record.GetMessage();
+        std::fputs(kConsolePrefixes[level], stream);
+        std::fwrite(message.data(), 1, message.size(), stream);
+        std::fputc('\n', stream);
+    }
+
+    std::lock_guard lock(file_mutex_);
+    if (file_ != nullptr) {
+        // 進捗表示用のエスケープシーケンスはファイルには出力しない
+        auto message = record.GetMessage();
+        while (!message.empty() && message.front() == '\033') {
+            auto const end = message.find_first_of("ABCDGHJK");
+            message.remove_prefix(end == std::string_view::npos ? message.size() : end + 1);
+        }
+        std::fprintf(file_, "[%12.6f] %-5s %-*s %.*s\n",
+            static_cast<double>(record.timestamp) * 1e-9,
+            kLevelNames[level],
+            static_cast<int>(LogRecord::kTagSize - 1), record.tag,
+            static_cast<int>(message.size()), message.data());
+    }
+}
+
+void AsyncLogger::Run() {
+    LogRecord record;
+    while (true) {
+        bool written = false;
+        while (TryPop(record)) {
+            Write(record);
+            written = true;
+            dequeue_position_.fetch_add(1, std::memory_order_release);
+        }
+
+        if (written) {
+            std::fflush(stdout);
+            {
+                std::lock_guard lock(file_mutex_);
+                if (file_ != nullptr) std::fflush(file_);
+            }
+            std::lock_guard lock(wake_mutex_);
+            flushed_cond_.notify_all();
+            continue;
+        }
+        if (is_stopped_.load(std::memory_order_acquire)) break;
+
+        // 待機を公開してからリングバッファを確認し直すことで、追加の通知を取りこぼさない
+        std::unique_lock lock(wake_mutex_);
+        is_writer_waiting_.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        wake_cond_.wait(lock, [this]() { return HasRecord() || is_stopped_.load(std::memory_order_acquire); });
+        is_writer_waiting_.store(false, std::memory_order_relaxed);
+    }
+}
+
+} // namespace digitalcurling::client
@@ -8,13 +8,19 @@
     #error "DIGITALCURLING_CLIENT_VERSION_MAJOR is not defined"
 #endif
 
+#include <algorithm>
+#include <future>
 #include <iostream>
 #include <memory>
 #include <thread>
 #include <mutex>
 #include <queue>
 #include <nlohmann/json.hpp>
+#include "digitalcurling/client/async_logger.hpp"
 #include "digitalcurling/client/client_base.hpp"
+#include "digitalcurling/client/metrics.hpp"
+#include "digitalcurling/client/profiler.hpp"
+#include "digitalcurling/client/turn_arena.hpp"
 
 using json = nlohmann::json;
 
@@ -106,6 +112,10 @@ Team ClientBase::JoinGame(Team const& team, std::string const& auth_id, std::str
     return team_;
 };
 
+void ClientBase::WarmUp() {
+    OnWarmUp();
+}
+
 void ClientBase::Connect(ClientConnectSetting const& setting) {
     if (team_ == Team::kInvalid) {
         throw std::runtime_error("ClientBase::Connect: team is not set. Call JoinGame() first.");
@@ -119,6 +129,30 @@ void ClientBase::Connect(ClientConnectSetting const& setting) {
 
     std::optional<std::exception> error;
     std::atomic<bool> is_sse_stopped = false;
+    bool is_first_open = true;
+    auto& metrics = Metrics::GetInstance();
+
+    // 再接続時、サーバーは履歴を最初から再送するため、処理済みのイベントは解析前に破棄する。
+    // サーバーがイベントIDを付与していれば、SSEClient は再接続時に Last-Event-ID を送信する
+    using Clock = std::chrono::steady_clock;
+    std::optional<Clock::time_point> disconnected_at;
+    std::optional<Clock::time_point> reconnecting_since;
+    std::atomic<std::uint64_t> discarded_since_reconnect = 0;
+
+    auto discard_event = [&]() {
+        metrics.events_discarded.Add();
+        discarded_since_reconnect++;
+    };
+    auto on_caught_up = [&]() {
+        if (!reconnecting_since.has_value()) return;
+        auto const elapsed = Clock::now() - reconnecting_since.value();
+        metrics.reconnect_ready_time.Observe(elapsed);
+        AsyncLogger::GetInstance().Log(LogLevel::kInfo, "sse",
+            "Reconnected: ready in %lld ms, %llu processed events discarded",
+            static_cast<long long>(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count()),
+            static_cast<unsigned long long>(discarded_since_reconnect.load()));
+        reconnecting_since = std::nullopt;
+    };
 
     std::mutex queue_mutex;
     std::condition_variable cond_var;
@@ -127,11 +161,19 @@ void ClientBase::Connect(ClientConnectSetting const& setting) {
     auto push_event = [&](std::string event_name, std::function<void()> handler) {
         std::lock_guard lock(queue_mutex);
         event_queue.push({std::move(event_name), std::move(handler)});
+        metrics.event_queue_depth.Set(static_cast<double>(event_queue.size()));
         cond_var.notify_one();
     };
 
     sse_client.on_open([&]() {
         error = std::nullopt;
+        if (!is_first_open) {
+            metrics.reconnects.Add();
+            reconnecting_since = disconnected_at.value_or(Clock::now());
+            discarded_since_reconnect = 0;
+        }
+        is_first_open = false;
+        disconnected_at = std::nullopt;
         push_event("on_connected", [&setting]() {
             if (setting.callback.on_connected)
                 setting.callback.on_connected();
@@ -139,43 +181,100 @@ void ClientBase::Connect(ClientConnectSetting const& setting) {
     });
     sse_client.on_error([&](httplib::Error err) {
         error = std::runtime_error("SSE connection error: " + httplib::to_string(err));
+        if (!disconnected_at.has_value()) disconnected_at = Clock::now();
     });
     sse_client.on_event("latest_state_update", [&](const httplib::sse::SSEMessage &msg) {
-        push_event("latest_state_update event", [this, &setting, &sse_client, msg]() {
+        metrics.events_received.Add();
+        // 履歴の再送の後に最新の状態が送られるため、ここで再接続の処理が完了する
+        auto const header = EventHeader::Peek(msg.data);
+        bool const is_processed = latest_filter_.IsProcessed(header, team_);
+        if (is_processed) discard_event();
+        on_caught_up();
+        if (is_processed) return;
+
+        push_event("latest_state_update event", [this, &setting, &sse_client, &discard_event, msg, header]() {
+            // 待ち行列に入っている間に同じ位置のイベントが処理された場合や、その手番を思考中の場合は破棄する
+            if (latest_filter_.IsProcessed(header, team_) || (pending_turn_.has_value() && latest_filter_.IsLatest(header))) {
+                discard_event();
+                return;
+            }
+
             StateUpdateEventData event_data = ParseStateUpdateEventData(msg);
             OnReceiveLatestStateUpdateEvent(event_data);
             if (setting.callback.on_latest_state_update)
                 setting.callback.on_latest_state_update(event_data);
 
+            // 処理に失敗したイベントは、再送されたときに再び処理する
+            latest_filter_.Commit(header);
             if (event_data.game_state.IsGameOver()) sse_client.stop();
         });
     });
     sse_client.on_event("state_update", [&](const httplib::sse::SSEMessage &msg) {
-        push_event("state_update event", [this, &setting, &sse_client, msg]() {
+        metrics.events_received.Add();
+        // 履歴はゲーム開始前にのみ使用する
+        auto const header = EventHeader::Peek(msg.data);
+        if (!is_first_update_ || history_filter_.IsProcessed(header)) {
+            discard_event();
+            return;
+        }
+
+        push_event("state_update event", [this, &setting, &discard_event, msg, header]() {
+            if (history_filter_.IsProcessed(header)) {
+                discard_event();
+                return;
+            }
+
             StateUpdateEventData event_data = ParseStateUpdateEventData(msg);
             OnReceiveStateUpdateEvent(event_data);
             if (setting.callback.on_state_update)
                 setting.callback.on_state_update(event_data);
+            history_filter_.Commit(header);
         });
     });
 
+    // 思考は別のスレッドで行い、完了はイベントとして通知させる
+    think_time_margin_ = setting.think_time_margin;
+    push_event_ = push_event;
+
     std::thread processing_thread = std::thread([&]() {
+        Profiler::SetThreadName("event processing");
+        bool is_ready = !setting.ready.valid();
         while (true) {
             std::pair<std::string, std::function<void()>> event;
             {
                 std::unique_lock lock(queue_mutex);
-                cond_var.wait(lock, [&]{
+                auto const has_event = [&]{
                     return !event_queue.empty() || is_sse_stopped;
-                });
+                };
+                // pending_turn_ はこのスレッドのみが操作するため、ロックなしで参照できる
+                auto const deadline = pending_turn_.has_value() ? pending_turn_->deadline : std::nullopt;
+                if (deadline.has_value()) {
+                    cond_var.wait_until(lock, deadline.value(), has_event);
+                } else {
+                    cond_var.wait(lock, has_event);
+                }
 
                 if (is_sse_stopped && event_queue.empty()) break;
-                if (event_queue.empty()) continue;
-
-                event = std::move(event_queue.front());
-                event_queue.pop();
+                if (deadline.has_value() && Clock::now() >= deadline.value()) {
+                    // 思考の期限を過ぎた場合は、待ち行列のイベントより先に暫定の最善手を投げる
+                    event = { "thinking deadline", [this]() { OnTurnDeadline(); } };
+                } else if (event_queue.empty()) {
+                    continue;
+                } else {
+                    event = std::move(event_queue.front());
+                    event_queue.pop();
+                    metrics.event_queue_depth.Set(static_cast<double>(event_queue.size()));
+                }
             }
             try {
+                // 接続は準備処理と並行して行い、イベントの処理のみを準備処理の完了まで待たせる
+                if (!is_ready) {
+                    setting.ready.get();
+                    is_ready = true;
+                }
+                PROFILE_ZONE("ProcessEvent");
                 event.second();
+                metrics.events_processed.Add();
             } catch (std::exception const& e) {
                 auto err = std::runtime_error("Exception occurred while processing " + event.first + ": " + e.what());
                 if (!setting.callback.on_event_process_error || !setting.callback.on_event_process_error(err)) {
@@ -197,10 +296,16 @@ void ClientBase::Connect(ClientConnectSetting const& setting) {
     cond_var.notify_all();
     processing_thread.join();
 
+    // 思考エンジンがこの関数より後まで実行されないよう、残った思考の終了を待つ
+    CancelTurn();
+    push_event_ = nullptr;
+
     if (error.has_value()) throw std::move(error.value());
 }
 
 StateUpdateEventData ClientBase::ParseStateUpdateEventData(httplib::sse::SSEMessage const& message) {
+    PROFILE_ZONE("ParseStateUpdateEventData");
+    auto const parse_start = std::chrono::steady_clock::now();
     auto json = json::parse(message.data);
     auto total_shot_opt = json.at("total_shot_number").get<std::optional<int>>();
 
@@ -290,10 +395,18 @@ StateUpdateEventData ClientBase::ParseStateUpdateEventData(httplib::sse::SSEMess
         state.game_result = { winner.value(), reason };
     }
 
+    auto& metrics = Metrics::GetInstance();
+    metrics.remaining_time_team0.Set(std::chrono::duration<double>(state.thinking_time_remaining[Team::k0]).count());
+    metrics.remaining_time_team1.Set(std::chrono::duration<double>(state.thinking_time_remaining[Team::k1]).count());
+    metrics.parse_time.Observe(std::chrono::steady_clock::now() - parse_start);
+
     return StateUpdateEventData { total_shot, next_team, std::move(state), std::move(last_shot) };
 }
 
 void ClientBase::OnReceiveLatestStateUpdateEvent(StateUpdateEventData const& event_data) {
+    // 試合状況が変わったため、前の状況での思考は不要になる
+    CancelTurn();
+
     if (event_data.game_state.IsGameOver()) {
         OnGameOver(event_data);
         return;
@@ -303,38 +416,150 @@ void ClientBase::OnReceiveLatestStateUpdateEvent(StateUpdateEventData const& eve
         is_first_update_ = false;
         OnGameStart(team_, std::move(states_));
     }
+    // 思考エンジンの一時メモリはターンごとに一括で破棄する
+    TurnArena::BeginTurn();
+
     if (event_data.total_shot_number == 0) {
         OnNextEnd(event_data);
+        // ミックスダブルスの配置の思考を開始した場合は、完了まで他の通知を行わない
+        if (pending_turn_.has_value()) return;
     }
 
     if (event_data.next_shot_team == team_) {
+        StartTurn(event_data);
+    } else {
+        OnOpponentTurn(event_data);
+    }
+}
+
+void ClientBase::StartTurn(StateUpdateEventData const& event_data) {
+    StartThinking(event_data, [this, event_data]() -> std::function<void()> {
+        PROFILE_ZONE("OnMyTurn");
         auto move = OnMyTurn(event_data);
-        if (std::holds_alternative<moves::Shot>(move)) {
-            const std::string shot_path = "/shots?match_id=" + game_id_;
-            auto shot = std::get<moves::Shot>(move);
-            nlohmann::json shot_json = {
-                { "translational_velocity", shot.translational_velocity },
-                { "angular_velocity", -shot.angular_velocity },
-                { "shot_angle", shot.release_angle }
-            };
-
-            auto result = http_client_.Post(shot_path, shot_json.dump(), "application/json");
-            if (!result) {
-                throw std::runtime_error("Failed to post shot: " + httplib::to_string(result.error()));
-            } else if (result->status != 200) {
-                std::string err = "Failed to post shot: return status code " + std::to_string(result->status);
-                if (!result->body.empty()) err += " " + result->body;
-                throw std::runtime_error(err);
+        return [this, move = std::move(move)]() { PostMove(move); };
+    }, [this](ThinkingContext const& context) {
+        auto best = context.GetBest();
+        if (!best.has_value()) return false;
+        PostMove(best.value());
+        return true;
+    });
+}
+
+void ClientBase::StartThinking(
+    StateUpdateEventData const& event_data,
+    std::function<std::function<void()>()> think,
+    std::function<bool(ThinkingContext const&)> fallback
+) {
+    auto const now = std::chrono::steady_clock::now();
+    auto const remaining = event_data.game_state.thinking_time_remaining[team_];
+
+    // 残り思考時間が通知されない場合は期限を設けない
+    std::optional<std::chrono::steady_clock::time_point> deadline;
+    if (remaining > std::chrono::milliseconds(0)) {
+        deadline = now + std::max<std::chrono::steady_clock::duration>(remaining - think_time_margin_, std::chrono::steady_clock::duration::zero());
+    }
+
+    auto context = std::make_shared<ThinkingContext>(deadline);
+    auto future = std::async(std::launch::async, [this, think = std::move(think), context]() {
+        // 例外の場合も完了を通知する
+        struct Notifier {
+            ClientBase& client;
+            std::shared_ptr<ThinkingContext> const& context;
+            ~Notifier() {
+                client.push_event_("turn finished", [&client = client, context = context]() {
+                    client.FinishTurn(context);
+                });
             }
-        } else if (std::holds_alternative<moves::Concede>(move)) {
-            // Currently, there is no API to concede a game.
-        } else {
-            throw std::runtime_error("Unknown move type returned by OnMyTurn.");
+        } notifier { *this, context };
+
+        Profiler::SetThreadName("thinking");
+        ThinkingContext::Scope scope(*context);
+        return think();
+    });
+
+    pending_turn_ = PendingTurn { std::move(context), std::move(future), std::move(fallback), now, deadline, false };
+}
+
+void ClientBase::FinishTurn(std::shared_ptr<ThinkingContext> const& context) {
+    // 取り消し済みの思考の通知は無視する
+    if (!pending_turn_.has_value() || pending_turn_->context != context) return;
+
+    auto turn = std::move(pending_turn_.value());
+    pending_turn_ = std::nullopt;
+
+    auto submit = turn.future.get();
+    if (turn.is_submitted) return;
+
+    Metrics::GetInstance().think_time.Observe(std::chrono::steady_clock::now() - turn.start);
+    submit();
+}
+
+void ClientBase::OnTurnDeadline() {
+    if (!pending_turn_.has_value() || !pending_turn_->deadline.has_value()) return;
+    auto& turn = pending_turn_.value();
+    turn.deadline = std::nullopt;
+
+    auto const elapsed = std::chrono::steady_clock::now() - turn.start;
+    if (!turn.fallback(*turn.context)) {
+        // 送信できる暫定の結果がないため、思考の完了を待つ
+        AsyncLogger::GetInstance().Log(LogLevel::kWarning, "client",
+            "Thinking deadline passed without a fallback result; waiting for the engine.");
+        return;
+    }
+
+    AsyncLogger::GetInstance().Log(LogLevel::kInfo, "client", "Thinking deadline passed; submitted the fallback result.");
+    turn.context->Cancel();
+    turn.is_submitted = true;
+    Metrics::GetInstance().think_time.Observe(elapsed);
+}
+
+void ClientBase::CancelTurn() {
+    if (!pending_turn_.has_value()) return;
+
+    auto turn = std::move(pending_turn_.value());
+    pending_turn_ = std::nullopt;
+
+    if (!turn.is_submitted) {
+        AsyncLogger::GetInstance().Log(LogLevel::kInfo, "client", "Thinking cancelled: the game state has changed.");
+    }
+    turn.context->Cancel();
+
+    // 思考エンジンはスレッドセーフでないため、次の通知の前に思考の終了を待つ。
+    // 評価器と探索のループは取り消しを確認して戻るため、待つのは処理中のシミュレーション程度に収まる
+    try {
+        turn.future.get();
+    } catch (std::exception const& e) {
+        AsyncLogger::GetInstance().Log(LogLevel::kWarning, "client", "Cancelled thinking failed: %s", e.what());
+    }
+}
+
+void ClientBase::PostMove(moves::Move const& move) {
+    PROFILE_ZONE("PostShot");
+    if (std::holds_alternative<moves::Shot>(move)) {
+        const std::string shot_path = "/shots?match_id=" + game_id_;
+        auto shot = std::get<moves::Shot>(move);
+        nlohmann::json shot_json = {
+            { "translational_velocity", shot.translational_velocity },
+            { "angular_velocity", -shot.angular_velocity },
+            { "shot_angle", shot.release_angle }
+        };
+
+        auto result = http_client_.Post(shot_path, shot_json.dump(), "application/json");
+        if (!result) {
+            throw std::runtime_error("Failed to post shot: " + httplib::to_string(result.error()));
+        } else if (result->status != 200) {
+            std::string err = "Failed to post shot: return status code " + std::to_string(result->status);
+            if (!result->body.empty()) err += " " + result->body;
+            throw std::runtime_error(err);
         }
+    } else if (std::holds_alternative<moves::Concede>(move)) {
+        // Currently, there is no API to concede a game.
     } else {
-        OnOpponentTurn(event_data);
+        throw std::runtime_error("Unknown move type returned by OnMyTurn.");
     }
+    latest_filter_.MarkMovePosted();
 }
+
 void ClientBase::OnReceiveStateUpdateEvent(StateUpdateEventData const& event_data) {
     if (!is_first_update_) return;
     states_.emplace_back(event_data.game_state, event_data.last_shot);
@@ -1,6 +1,13 @@
 
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
 #include <optional>
+#include <random>
 #include <string>
+#include <thread>
 #include <httplib.h>
 #include "digitalcurling/client/client_base.hpp"
 #include "digitalcurling/client/standard_client.hpp"
@@ -12,15 +19,136 @@
 
 namespace digitalcurling::client {
 
-std::unique_ptr<ClientBase> ClientFactory::CreateClient(
+namespace {
+
+/// @brief 試合情報の取得結果
+struct ProbeResult {
+    std::string url;
+    std::optional<httplib::Response> response;
+    httplib::Error error = httplib::Error::Unknown;
+    /// @brief 応答から読み取った試合情報 (ステータスが200で解析できた場合のみ)
+    std::optional<MatchInfo> match_info;
+    /// @brief 解析に失敗した理由
+    std::string parse_error;
+};
+
+ProbeResult ProbeMatch(std::string const& url, std::string const& match_path) {
+    ProbeResult probe { url };
+    try {
+        auto http_client = httplib::Client(url);
+        http_client.set_follow_location(true);
+        http_client.set_connection_timeout(5);
+
+        auto result = http_client.Get(match_path);
+        if (result) {
+            probe.response = *result;
+        } else {
+            probe.error = result.error();
+        }
+    } catch (...) {
+        // 不正なURLは応答なしとして扱う
+    }
+
+    if (probe.response.has_value() && probe.response->status == 200) {
+        try {
+            probe.match_info = nlohmann::json::parse(probe.response->body).get<MatchInfo>();
+        } catch (nlohmann::json::exception const& e) {
+            probe.parse_error = e.what();
+        }
+    }
+    return probe;
+}
+
+/// @brief 複数のURLを同時に試し、最初に試合情報を取得できたものを返す
+///
+/// HTTPS のポートに HTTP で接続した場合の400のように、エラーの応答は勝者にしない。
+/// 応答が遅いURLの取得は待たずに打ち切り、バックグラウンドで終了させる。
+/// 全て失敗した場合は、応答のあった失敗を優先して返す。
+ProbeResult RaceProbes(std::vector<std::string> const& urls, std::string const& match_path) {
+    struct State {
+        std::mutex mutex;
+        std::condition_variable cond_var;
+        std::optional<ProbeResult> winner;
+        ProbeResult last_failure;
+        std::size_t remaining;
+    };
+    auto state = std::make_shared<State>();
+    state->remaining = urls.size();
+
+    for (auto const& url : urls) {
+        std::thread([state, url, match_path]() {
+            auto probe = ProbeMatch(url, match_path);
+            std::lock_guard lock(state->mutex);
+            if (probe.match_info.has_value()) {
+                if (!state->winner.has_value()) state->winner = std::move(probe);
+            } else if (probe.response.has_value() || !state->last_failure.response.has_value()) {
+                state->last_failure = std::move(probe);
+            }
+            state->remaining--;
+            state->cond_var.notify_all();
+        }).detach();
+    }
+
+    std::unique_lock lock(state->mutex);
+    state->cond_var.wait(lock, [&state]() {
+        return state->winner.has_value() || state->remaining == 0;
+    });
+    return state->winner.has_value() ? *state->winner : state->last_failure;
+}
+
+std::optional<std::string> LoadCachedEndpoint(std::filesystem::path const& cache_path, std::string const& host) {
+    try {
+        std::ifstream ifs(cache_path);
+        if (!ifs) return std::nullopt;
+        auto json = nlohmann::json::parse(ifs);
+        if (!json.contains(host)) return std::nullopt;
+        return json.at(host).get<std::string>();
+    } catch (std::exception const&) {
+        return std::nullopt;
+    }
+}
+
+void SaveCachedEndpoint(std::filesystem::path const& cache_path, std::string const& host, std::string const& url) {
+    nlohmann::json json = nlohmann::json::object();
+    try {
+        std::ifstream ifs(cache_path);
+        if (ifs) json = nlohmann::json::parse(ifs);
+    } catch (std::exception const&) {
+        json = nlohmann::json::object();
+    }
+    json[host] = url;
+
+    std::error_code ec;
+    std::filesystem::create_directories(cache_path.parent_path(), ec);
+
+    // 同じキャッシュを使う他のプロセスに書きかけのファイルを読ませない
+    auto temp_path = cache_path;
+    temp_path += ".tmp" + std::to_string(std::random_device {}());
+    {
+        std::ofstream ofs(temp_path);
+        if (!ofs) return;
+        ofs << json.dump(2);
+        if (!ofs) {
+            ofs.close();
+            std::filesystem::remove(temp_path, ec);
+            return;
+        }
+    }
+    std::filesystem::rename(temp_path, cache_path, ec);
+    if (ec) std::filesystem::remove(temp_path, ec);
+}
+
+} // namespace
+
+MatchEndpoint ClientFactory::GetMatch(
     std::string const& host,
     std::string const& id,
-    std::unique_ptr<IThinkingEngine> engine,
-    std::unique_ptr<IFactoryCreator> factory_creator
+    std::optional<std::filesystem::path> const& cache_path
 ) {
-    // Resolve URL
-    std::vector<std::string> target_urls;
+    const std::string match_path = "/matches/" + id;
 
+    // Resolve URL
+    ProbeResult probe;
     size_t pos = host.find("://");
     if (pos != std::string::npos) {
         auto schema = host.substr(0, pos);
@@ -28,57 +156,70 @@ std::unique_ptr<ClientBase> ClientFactory::CreateClient(
 #ifdef DIGITALCURLING_CLIENT_NO_SSL
             throw std::runtime_error("Failed to create client: the client does not support HTTPS.");
 #else
-            target_urls.push_back(host);
+            probe = ProbeMatch(host, match_path);
 #endif
         } else if (schema == "http") {
-            target_urls.push_back(host);
+            probe = ProbeMatch(host, match_path);
         } else {
             throw std::runtime_error("Failed to create client: invalid URL schema.");
         }
     } else {
+        // 前回解決したスキームを優先し、試合情報を取得できなかった場合のみ全てのスキームを試す
+        std::optional<std::string> cached_url;
+        if (cache_path.has_value()) cached_url = LoadCachedEndpoint(cache_path.value(), host);
+        if (cached_url.has_value()) probe = ProbeMatch(cached_url.value(), match_path);
+
+        if (!probe.match_info.has_value()) {
+            std::vector<std::string> target_urls;
 #ifndef DIGITALCURLING_CLIENT_NO_SSL
-        target_urls.push_back("https://" + host);
+            target_urls.push_back("https://" + host);
 #endif
-        target_urls.push_back("http://" + host);
-    }
-
-    httplib::Result result;
-    const std::string match_path = "/matches/" + id;
+            target_urls.push_back("http://" + host);
+            probe = RaceProbes(target_urls, match_path);
 
-    std::string valid_host;
-    for (const auto& url : target_urls) {
-        try {
-            auto http_client = httplib::Client(url);
-            http_client.set_follow_location(true);
-            http_client.set_connection_timeout(5);
-
-            result = http_client.Get(match_path);
-            if (result) {
-                valid_host = url;
-                break;
+            if (probe.match_info.has_value() && cache_path.has_value() && probe.url != cached_url) {
+                SaveCachedEndpoint(cache_path.value(), host, probe.url);
             }
-        } catch (...) {
-            continue;
         }
     }
 
-    if (valid_host.empty()) {
+    if (probe.url.empty()) {
         throw std::runtime_error("Failed to create HTTP client for host: " + host);
-    } else if (!result) {
-        throw std::runtime_error("Failed to connect to host: " + httplib::to_string(result.error()));
-    } else if (result->status != 200) {
-        std::string err = "Failed to get match information: return status code " + std::to_string(result->status);
-        if (!result->body.empty()) err += " " + result->body;
+    } else if (!probe.response.has_value()) {
+        throw std::runtime_error("Failed to connect to host: " + httplib::to_string(probe.error));
+    }
+
+    auto& valid_host = probe.url;
+    auto const& response = probe.response.value();
+    if (response.status != 200) {
+        std::string err = "Failed to get match information: return status code " + std::to_string(response.status);
+        if (!response.body.empty()) err += " " + response.body;
         throw std::runtime_error(err);
     }
 
-    MatchInfo match_info;
-    try {
-        auto body_json = nlohmann::json::parse(result->body);
-        match_info = body_json.get<MatchInfo>();
-    } catch (nlohmann::json::parse_error& e) {
-        throw std::runtime_error("Failed to get match information: " + std::string(e.what()));
+    if (!probe.match_info.has_value()) {
+        throw std::runtime_error("Failed to get match information: " + probe.parse_error);
     }
+    return MatchEndpoint { std::move(valid_host), id, std::move(probe.match_info.value()) };
+}
+
+std::unique_ptr<ClientBase> ClientFactory::CreateClient(
+    std::string const& host,
+    std::string const& id,
+    std::unique_ptr<IThinkingEngine> engine,
+    std::unique_ptr<IFactoryCreator> factory_creator
+) {
+    return CreateClient(GetMatch(host, id, std::nullopt), std::move(engine), std::move(factory_creator));
+}
+
+std::unique_ptr<ClientBase> ClientFactory::CreateClient(
+    MatchEndpoint endpoint,
+    std::unique_ptr<IThinkingEngine> engine,
+    std::unique_ptr<IFactoryCreator> factory_creator
+) {
+    auto& valid_host = endpoint.host;
+    auto const& id = endpoint.id;
+    auto& match_info = endpoint.match_info;
 
     std::string expected_rule;
     std::unique_ptr<ClientBase> client;
@@ -0,0 +1,262 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: Unlicense
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <nlohmann/json.hpp>
+#include "digitalcurling/client/async_logger.hpp"
+#include "digitalcurling/client/board_evaluation.hpp"
+#include "digitalcurling/client/delivery_order_optimizer.hpp"
+#include "digitalcurling/client/metrics.hpp"
+#include "digitalcurling/client/profiler.hpp"
+
+namespace digitalcurling::client {
+
+namespace {
+
+/// @brief 1エンドに各チームが投げるストーン数
+constexpr int kStonesPerTeam = 8;
+/// @brief 各プレイヤーが続けて投げるストーン数
+constexpr int kStonesPerPlayer = 2;
+
+/// @brief 特性の測定に用いるショット
+moves::Shot const kReferenceShot(2.3f, 1.57f, 0.f);
+
+/// @brief 投球順ごとの得点の集計
+struct Tally {
+    double sum = 0.;
+    double square_sum = 0.;
+    std::uint32_t count = 0;
+
+    double GetMean() const { return count > 0 ? sum / count : 0.; }
+    double GetStandardError() const {
+        if (count < 2) return std::numeric_limits<double>::infinity();
+        double const mean = GetMean();
+        double const variance = std::max(0., square_sum / count - mean * mean);
+        return std::sqrt(variance / (count - 1));
+    }
+};
+
+nlohmann::json LoadCacheFile(std::filesystem::path const& path) {
+    std::error_code ec;
+    if (path.empty() || !std::filesystem::exists(path, ec)) return nlohmann::json::object();
+    try {
+        std::ifstream ifs(path);
+        auto json = nlohmann::json::parse(ifs);
+        if (json.is_object()) return json;
+    } catch (std::exception const& e) {
+        AsyncLogger::GetInstance().Log(LogLevel::kWarning, "order",
+            "Ignoring the cache %s: %s", path.string().c_str(), e.what());
+    }
+    return nlohmann::json::object();
+}
+
+void SaveCacheFile(std::filesystem::path const& path, nlohmann::json const& json) {
+    std::error_code ec;
+    if (path.has_parent_path()) std::filesystem::create_directories(path.parent_path(), ec);
+
+    auto temp_path = path;
+    temp_path += ".tmp";
+    {
+        std::ofstream ofs(temp_path, std::ios::trunc);
+        ofs << json.dump(2);
+        if (!ofs) {
+            throw std::runtime_error("Failed to write " + temp_path.string());
+        }
+    }
+    std::filesystem::rename(temp_path, path, ec);
+    if (ec) {
+        throw std::runtime_error("Failed to write " + path.string() + ": " + ec.message());
+    }
+}
+
+} // namespace
+
+// --- PlayerProfile ---
+PlayerProfile PlayerProfile::Measure(players::IPlayerFactory const& factory, std::size_t samples) {
+    auto player = factory.CreatePlayer();
+    double speed_sum = 0., speed_square_sum = 0., angle_sum = 0., angle_square_sum = 0.;
+    for (std::size_t i = 0; i < samples; ++i) {
+        auto const shot = player->Play(kReferenceShot);
+        double const speed = shot.translational_velocity - kReferenceShot.translational_velocity;
+        double const angle = shot.release_angle - kReferenceShot.release_angle;
+        speed_sum += speed;
+        speed_square_sum += speed * speed;
+        angle_sum += angle;
+        angle_square_sum += angle * angle;
+    }
+
+    auto const stddev = [samples](double sum, double square_sum) {
+        if (samples == 0) return 0.f;
+        double const mean = sum / samples;
+        return static_cast<float>(std::sqrt(std::max(0., square_sum / samples - mean * mean)));
+    };
+
+    PlayerProfile profile;
+    profile.gender = factory.GetGender();
+    profile.speed_stddev = stddev(speed_sum, speed_square_sum);
+    profile.angle_stddev = stddev(angle_sum, angle_square_sum);
+    return profile;
+}
+
+// --- DeliveryOrderOptimizer ---
+DeliveryOrderOptimizer::DeliveryOrderOptimizer(
+    GameRule const& game_rule,
+    ISimulationEvaluator& evaluator,
+    simulators::IInvertibleSimulator& simulator,
+    std::filesystem::path cache_path,
+    Setting const& setting
+)
+  : game_rule_(game_rule),
+    evaluator_(evaluator),
+    cache_path_(std::move(cache_path)),
+    setting_(setting),
+    playout_runner_(game_rule, evaluator, simulator)
+{}
+
+std::vector<std::vector<std::uint8_t>> DeliveryOrderOptimizer::EnumerateOrders(
+    GameRuleType rule_type,
+    std::vector<players::Gender> const& genders
+) {
+    std::vector<std::uint8_t> order(genders.size());
+    std::iota(order.begin(), order.end(), 0);
+
+    std::vector<std::vector<std::uint8_t>> orders;
+    do {
+        bool valid = true;
+        if (rule_type == GameRuleType::kMixed) {
+            // MixedClient と同じく、続けて投げるプレイヤーは異性でなければならない
+            auto last_gender = players::Gender::kUnknown;
+            for (auto index : order) {
+                if (genders[index] == last_gender) {
+                    valid = false;
+                    break;
+                }
+                last_gender = genders[index];
+            }
+        }
+        if (valid) orders.push_back(order);
+    } while (std::next_permutation(order.begin(), order.end()));
+    return orders;
+}
+
+std::string DeliveryOrderOptimizer::GetCacheKey(std::vector<PlayerProfile> const& profiles) const {
+    // 測定誤差で変わらないよう、有効数字2桁に丸める
+    std::string key = std::to_string(static_cast<int>(game_rule_.type));
+    char buffer[64];
+    for (auto const& profile : profiles) {
+        std::snprintf(buffer, sizeof(buffer), "/%d:%.2g:%.2g",
+            static_cast<int>(profile.gender), profile.speed_stddev, profile.angle_stddev);
+        key += buffer;
+    }
+    return key;
+}
+
+DeliveryOrderOptimizer::Result DeliveryOrderOptimizer::Optimize(std::vector<std::unique_ptr<players::IPlayerFactory>> const& players) {
+    PROFILE_ZONE("DeliveryOrderOptimizer::Optimize");
+    std::vector<PlayerProfile> profiles;
+    std::vector<players::Gender> genders;
+    for (auto const& player : players) {
+        profiles.push_back(PlayerProfile::Measure(*player, setting_.profile_samples));
+        genders.push_back(profiles.back().gender);
+    }
+
+    auto const orders = EnumerateOrders(game_rule_.type, genders);
+    if (orders.empty()) {
+        throw std::runtime_error("DeliveryOrderOptimizer: no valid delivery order.");
+    }
+
+    auto const cache_key = GetCacheKey(profiles);
+    auto cache = LoadCacheFile(cache_path_);
+    bool const cached = cache.contains(cache_key);
+    Metrics::GetInstance().GetCache("delivery_order").Record(cached);
+    if (cached) {
+        try {
+            auto const& item = cache.at(cache_key);
+            Result result;
+            result.order = item.at("order").get<std::vector<std::uint8_t>>();
+            result.value = item.at("value").get<float>();
+            result.ends = item.at("ends").get<std::uint32_t>();
+            result.from_cache = true;
+            if (std::find(orders.begin(), orders.end(), result.order) != orders.end()) return result;
+        } catch (std::exception const& e) {
+            AsyncLogger::GetInstance().Log(LogLevel::kWarning, "order", "%s", e.what());
+        }
+    }
+
+    std::vector<std::unique_ptr<players::IPlayer>> instances;
+    for (auto const& player : players) instances.push_back(player->CreatePlayer());
+
+    auto const start = std::chrono::steady_clock::now();
+    auto const deadline = start + setting_.time_budget;
+    evaluator_.SetDeadline(deadline);
+
+    // 自チームをチーム0、相手チームをチーム1とする
+    std::vector<std::size_t> active(orders.size());
+    std::iota(active.begin(), active.end(), 0);
+    std::vector<Tally> tallies(orders.size());
+    auto const ends_per_round = std::max(2u, setting_.ends_per_round);
+    std::uint32_t ends = 0;
+    do {
+        std::vector<CompactBoard> boards(active.size() * ends_per_round);
+        std::vector<Team> first_teams(boards.size());
+        for (std::size_t k = 0; k < boards.size(); ++k) {
+            first_teams[k] = k % 2 == 0 ? Team::k0 : Team::k1;
+        }
+
+        playout_runner_.Run(boards, first_teams, 0, kStonesPerTeam,
+            [&](std::size_t playout, Team team, int stone) -> players::IPlayer& {
+                auto const slot = static_cast<std::size_t>(stone / kStonesPerPlayer);
+                auto const& order = team == Team::k0 ? orders[active[playout / ends_per_round]] : orders.front();
+                return *instances[order[slot]];
+            });
+
+        for (std::size_t k = 0; k < boards.size(); ++k) {
+            double const score = GetEndScore(boards[k], Team::k0);
+            auto& tally = tallies[active[k / ends_per_round]];
+            tally.sum += score;
+            tally.square_sum += score * score;
+            tally.count++;
+        }
+        ends += ends_per_round;
+
+        // 最善の投球順より明らかに劣る投球順を打ち切る
+        auto const best = *std::max_element(active.begin(), active.end(),
+            [&tallies](std::size_t a, std::size_t b) { return tallies[a].GetMean() < tallies[b].GetMean(); });
+        double const threshold = tallies[best].GetMean() - 2. * tallies[best].GetStandardError();
+        active.erase(std::remove_if(active.begin(), active.end(), [&](std::size_t i) {
+            return i != best && tallies[i].GetMean() + 2. * tallies[i].GetStandardError() < threshold;
+        }), active.end());
+    } while (active.size() > 1 && ends < setting_.max_ends && std::chrono::steady_clock::now() < deadline);
+
+    evaluator_.SetDeadline(std::nullopt);
+
+    auto const best = *std::max_element(active.begin(), active.end(),
+        [&tallies](std::size_t a, std::size_t b) { return tallies[a].GetMean() < tallies[b].GetMean(); });
+    Result result;
+    result.order = orders[best];
+    result.value = static_cast<float>(tallies[best].GetMean());
+    result.ends = tallies[best].count;
+
+    AsyncLogger::GetInstance().Log(LogLevel::kInfo, "order",
+        "Delivery order %s: %.3f points per end over %u ends (%zu of %zu orders remaining) in %.1f ms",
+        nlohmann::json(result.order).dump().c_str(), result.value, result.ends, active.size(), orders.size(),
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+
+    if (!cache_path_.empty()) {
+        cache[cache_key] = { { "order", result.order }, { "value", result.value }, { "ends", result.ends } };
+        try {
+            SaveCacheFile(cache_path_, cache);
+        } catch (std::exception const& e) {
+            AsyncLogger::GetInstance().Log(LogLevel::kWarning, "order", "%s", e.what());
+        }
+    }
+    return result;
+}
+
+} // namespace digitalcurling::client
@@ -0,0 +1,404 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: Unlicense
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include "digitalcurling/client/async_logger.hpp"
+#include "digitalcurling/client/board_evaluation.hpp"
+#include "digitalcurling/client/endgame_solver.hpp"
+#include "digitalcurling/client/metrics.hpp"
+#include "digitalcurling/client/profiler.hpp"
+#include "digitalcurling/client/thinking_context.hpp"
+
+namespace digitalcurling::client {
+
+namespace {
+
+constexpr std::uint32_t kMagic = 0x47454344; // "DCEG"
+constexpr std::uint32_t kVersion = 2;
+
+/// @brief ファイルのヘッダ
+struct FileHeader {
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint32_t entry_size;
+    float sheet_width;
+};
+
+constexpr float kSpin = 1.57f;
+/// @brief 格子で覆う範囲 (ティーからの距離) [m]
+constexpr float kGridRadius = kHouseRadius + 0.3f;
+constexpr float kHitSpeeds[] = { 2.f, 3.f, 4.f };
+/// @brief ヒットの狙いをずらす幅 [m]
+constexpr float kHitOffsets[] = { -0.1f, 0.f, 0.1f };
+
+} // namespace
+
+// --- EndgameTable ---
+EndgameTable::EndgameTable(std::filesystem::path const& path, float sheet_width) {
+    FileHeader header { kMagic, kVersion, sizeof(EndgameTableEntry), sheet_width };
+
+    std::error_code ec;
+    if (std::filesystem::exists(path, ec)) {
+        std::ifstream ifs(path, std::ios::binary);
+        FileHeader existing;
+        if (!ifs.read(reinterpret_cast<char*>(&existing), sizeof(existing))) {
+            throw std::runtime_error("Endgame table is corrupted: " + path.string());
+        }
+        if (existing.magic != kMagic || existing.version != kVersion || existing.entry_size != sizeof(EndgameTableEntry)) {
+            throw std::runtime_error("Unsupported endgame table format: " + path.string());
+        }
+        if (existing.sheet_width != sheet_width) {
+            throw std::runtime_error("Endgame table was made for a different sheet width: " + path.string());
+        }
+
+        EndgameTableEntry entry;
+        while (ifs.read(reinterpret_cast<char*>(&entry), sizeof(entry))) {
+            entries_[entry.board_hash].push_back(entry);
+            entry_count_++;
+        }
+
+        // 追記中に終了した場合の欠けたエントリを取り除く
+        ifs.close();
+        auto const size = sizeof(FileHeader) + entry_count_ * sizeof(EndgameTableEntry);
+        if (std::filesystem::file_size(path) != size) {
+            std::filesystem::resize_file(path, size);
+        }
+        ofs_.open(path, std::ios::binary | std::ios::app);
+    } else {
+        if (path.has_parent_path()) std::filesystem::create_directories(path.parent_path(), ec);
+        ofs_.open(path, std::ios::binary | std::ios::trunc);
+        ofs_.write(reinterpret_cast<char const*>(&header), sizeof(header));
+        ofs_.flush();
+    }
+
+    if (!ofs_) {
+        throw std::runtime_error("Failed to open " + path.string());
+    }
+    is_open_ = true;
+}
+
+std::size_t EndgameTable::GetEntryCount() const {
+    std::lock_guard lock(mutex_);
+    return entry_count_;
+}
+
+std::optional<EndgameTableEntry> EndgameTable::Find(EndgameKey const& key, CanonicalBoard const& board) const {
+    std::lock_guard lock(mutex_);
+    auto const it = entries_.find(board.GetHash());
+    if (it == entries_.end()) return std::nullopt;
+    for (auto const& entry : it->second) {
+        if (entry.key == key && entry.board == board) return entry;
+    }
+    return std::nullopt;
+}
+
+void EndgameTable::Add(EndgameTableEntry const& entry) {
+    std::lock_guard lock(mutex_);
+    auto& bucket = entries_[entry.board_hash];
+    for (auto const& existing : bucket) {
+        if (existing.key == entry.key && existing.board == entry.board) return;
+    }
+    bucket.push_back(entry);
+    entry_count_++;
+
+    if (is_open_) {
+        ofs_.write(reinterpret_cast<char const*>(&entry), sizeof(entry));
+        ofs_.flush();
+    }
+}
+
+// --- EndgameSolver ---
+struct EndgameSolver::Objective {
+    WinProbabilityTable const* win_probability = nullptr;
+    std::optional<WinProbabilityKey> situation;
+
+    /// @brief エンドの得点に対する評価値
+    double GetUtility(int score) const {
+        if (!situation.has_value()) return score;
+        return win_probability->GetAfterEnd(situation.value(), score);
+    }
+
+    /// @brief 両チームの評価値の和 (期待得点なら0、勝率なら1)
+    double GetTotal() const {
+        return situation.has_value() ? 1. : 0.;
+    }
+
+    Objective GetOpponent() const {
+        if (!situation.has_value()) return *this;
+        auto opponent = situation.value();
+        opponent.score_difference = static_cast<std::int8_t>(-opponent.score_difference);
+        opponent.has_hammer = opponent.has_hammer != 0 ? 0 : 1;
+        return Objective { win_probability, opponent };
+    }
+};
+
+EndgameSolver::EndgameSolver(
+    GameRule const& game_rule,
+    ISimulationEvaluator& evaluator,
+    simulators::IInvertibleSimulator& simulator,
+    EndgameTable* table,
+    WinProbabilityTable const* win_probability,
+    MultiFidelityEvaluator* multi_fidelity,
+    Setting const& setting
+)
+  : game_rule_(game_rule),
+    evaluator_(evaluator),
+    simulator_(simulator),
+    table_(table),
+    win_probability_(win_probability),
+    multi_fidelity_(multi_fidelity),
+    setting_(setting),
+    table_metrics_(Metrics::GetInstance().GetCache("endgame_table"))
+{}
+
+std::optional<EndgameSolver::Result> EndgameSolver::Solve(
+    CompactBoard const& board,
+    Team team,
+    std::uint8_t end,
+    std::uint8_t shot,
+    std::uint8_t shots_remaining,
+    players::IPlayer& player,
+    std::optional<WinProbabilityKey> situation,
+    SearchTree<>* tree
+) {
+    PROFILE_ZONE("EndgameSolver::Solve");
+    if (shots_remaining == 0 || shots_remaining > kMaxShotsRemaining) return std::nullopt;
+    if (!board.FindFreeStoneIndex(team).has_value()) return std::nullopt;
+
+    if (win_probability_ == nullptr || !win_probability_->IsOpen()) situation.reset();
+    Objective const objective { win_probability_, situation };
+
+    EndgameKey key;
+    key.shot = shot;
+    key.shots_remaining = shots_remaining;
+    key.objective = situation.has_value() ? situation->score_difference : EndgameKey::kExpectedScore;
+    key.ends_remaining = situation.has_value() ? situation->ends_remaining : 0;
+    // テーブルには正規化した向きのショットを登録する
+    bool is_mirrored = false;
+    auto const canonical = CanonicalBoard::Create(board, team, &is_mirrored);
+
+    if (table_ != nullptr) {
+        auto entry = table_->Find(key, canonical);
+        table_metrics_.Record(entry.has_value());
+        if (entry.has_value()) {
+            auto const shot = is_mirrored ? MirrorShot(entry->GetShot()) : entry->GetShot();
+            return Result { shot, entry->value, entry->trials, true };
+        }
+    }
+
+    // 探索木には残り2投の試行の盤面のみを記録する (最後の1投の後に続く手番はない)
+    if (shots_remaining != 2) tree = nullptr;
+    if (tree != nullptr && (!tree->HasRoot() || tree->GetNode(tree->GetRoot()).board != board)) tree->Reset(board);
+
+    auto const start = std::chrono::steady_clock::now();
+    bool const is_last_shot = shots_remaining == 1;
+    bool const is_screening = multi_fidelity_ != nullptr && multi_fidelity_->HasScreening();
+    auto grid_step = is_last_shot ? setting_.grid_step : setting_.two_shot_grid_step;
+    if (is_screening) grid_step *= setting_.screening_grid_scale;
+    auto const coarse_trials = std::max(1u, is_last_shot ? setting_.coarse_trials : setting_.two_shot_coarse_trials);
+    auto refine_trials = is_last_shot ? setting_.refine_trials : setting_.two_shot_refine_trials;
+    // 粗いシミュレーターの評価値は偏りうるため、再評価を省略しない
+    if (is_screening) refine_trials = std::max(refine_trials, coarse_trials);
+
+    // 全候補を少ない試行回数で評価する
+    auto& screening_evaluator = is_screening ? multi_fidelity_->GetScreening() : evaluator_;
+    auto const candidates = GenerateCandidates(board, grid_step);
+    // 粗いシミュレーターの盤面は探索木に記録しない
+    auto values = EvaluateCandidates(screening_evaluator, board, team, end, shots_remaining, candidates, coarse_trials, player, objective,
+        is_screening ? nullptr : tree);
+    // 取り消された評価の結果は不完全なため、解として用いずテーブルにも登録しない
+    if (ThinkingContext::IsCurrentCancelled()) return std::nullopt;
+
+    // 上位の候補を再評価し、全ての試行の平均で比較する
+    auto order = MakeArenaVector<std::size_t>();
+    if (is_screening) {
+        order = multi_fidelity_->Select(values, setting_.refine_count, setting_.screening_max_refine_count);
+    } else {
+        order.resize(candidates.size());
+        std::iota(order.begin(), order.end(), 0);
+        auto const count = std::min<std::size_t>(setting_.refine_count, order.size());
+        std::partial_sort(order.begin(), order.begin() + count, order.end(),
+            [&values](std::size_t a, std::size_t b) { return values[a] > values[b]; });
+        order.resize(count);
+    }
+    auto const refine_count = order.size();
+
+    std::size_t best = order[0];
+    std::uint32_t trials = coarse_trials;
+    if (refine_trials > 0 && (refine_count > 1 || is_screening)) {
+        auto refine_candidates = MakeArenaVector<moves::Shot>(refine_count);
+        for (std::size_t i = 0; i < refine_count; ++i) refine_candidates.push_back(candidates[order[i]]);
+        auto const refined = EvaluateCandidates(evaluator_, board, team, end, shots_remaining, refine_candidates, refine_trials, player, objective, tree);
+        if (ThinkingContext::IsCurrentCancelled()) return std::nullopt;
+
+        for (std::size_t i = 0; i < refine_count; ++i) {
+            auto& value = values[order[i]];
+            if (is_screening) {
+                // 絞り込みの誤差を観測し、通常のシミュレーターの評価値のみで比較する
+                multi_fidelity_->Observe(value, refined[i]);
+                value = refined[i];
+            } else {
+                value = (value * coarse_trials + refined[i] * refine_trials) / (coarse_trials + refine_trials);
+            }
+        }
+        best = *std::max_element(order.begin(), order.end(),
+            [&values](std::size_t a, std::size_t b) { return values[a] < values[b]; });
+        trials = is_screening ? refine_trials : trials + refine_trials;
+    }
+
+    Result result { candidates[best], static_cast<float>(values[best]), trials, false };
+    AsyncLogger::GetInstance().Log(LogLevel::kDebug, "endgame",
+        "Solved %d shot(s) remaining: %zu candidates (%zu refined), value %.3f in %.1f ms",
+        shots_remaining, candidates.size(), refine_count, result.value,
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+
+    if (table_ != nullptr) {
+        auto const shot = is_mirrored ? MirrorShot(result.shot) : result.shot;
+        EndgameTableEntry entry;
+        entry.board_hash = canonical.GetHash();
+        entry.translational_velocity = shot.translational_velocity;
+        entry.angular_velocity = shot.angular_velocity;
+        entry.release_angle = shot.release_angle;
+        entry.value = result.value;
+        entry.trials = result.trials;
+        entry.key = key;
+        entry.board = canonical;
+        table_->Add(entry);
+    }
+    return result;
+}
+
+ArenaVector<moves::Shot> EndgameSolver::GenerateCandidates(CompactBoard const& board, float grid_step) const {
+    auto const& tee = coordinate::kTee;
+    auto shots = MakeArenaVector<moves::Shot>();
+    int const steps = static_cast<int>(std::floor(kGridRadius / grid_step));
+    for (float spin : { -kSpin, kSpin }) {
+        // ハウスを覆う格子へのドロー
+        for (int iy = -steps; iy <= steps; ++iy) {
+            for (int ix = -steps; ix <= steps; ++ix) {
+                float const dx = ix * grid_step;
+                float const dy = iy * grid_step;
+                if (std::hypot(dx, dy) > kGridRadius) continue;
+                shots.push_back(simulator_.CalculateShot(Vector2(tee.x + dx, tee.y + dy), 0.f, spin));
+            }
+        }
+        // 各ストーンへのヒット
+        for (std::size_t i = 0; i < CompactBoard::kStoneCount; ++i) {
+            if (!board.HasStone(i)) continue;
+            auto const position = board.GetPosition(i);
+            for (float speed : kHitSpeeds) {
+                for (float offset : kHitOffsets) {
+                    shots.push_back(simulator_.CalculateShot(Vector2(position.x + offset, position.y), speed, spin));
+                }
+            }
+        }
+    }
+    return shots;
+}
+
+ArenaVector<CompactBoard> EndgameSolver::Simulate(
+    ISimulationEvaluator& evaluator,
+    ArenaVector<CompactBoard> const& boards,
+    Team team,
+    std::uint8_t end,
+    ArenaVector<ArenaVector<moves::Shot>> const& candidates,
+    std::uint32_t trials,
+    players::IPlayer& player
+) {
+    PROFILE_ZONE("EndgameSolver::Simulate");
+    // 全ての盤面と候補の試行をまとめて評価器に渡す
+    std::size_t total = 0;
+    for (auto const& shots : candidates) total += shots.size() * trials;
+    auto jobs = MakeArenaVector<SimulationJob>(total);
+    for (std::size_t b = 0; b < boards.size(); ++b) {
+        auto const stone_index = boards[b].FindFreeStoneIndex(team).value();
+        for (auto const& candidate : candidates[b]) {
+            for (std::uint32_t t = 0; t < trials; ++t) {
+                jobs.push_back(SimulationJob::Create(boards[b], stone_index, player.Play(candidate)));
+            }
+        }
+    }
+    evaluator.Evaluate(jobs);
+
+    auto results = MakeArenaVector<CompactBoard>(jobs.size());
+    std::size_t k = 0;
+    for (std::size_t b = 0; b < boards.size(); ++b) {
+        auto const stones = boards[b].ToStoneCoordinate();
+        for (std::size_t n = candidates[b].size() * trials; n > 0; --n, ++k) {
+            // ルール違反の場合はショット前の盤面に戻る
+            if (game_rule_.VerifyShot(end, team, stones, jobs[k].board.ToStoneCoordinate()).has_value()) {
+                results.push_back(boards[b]);
+            } else {
+                results.push_back(jobs[k].board);
+            }
+        }
+    }
+    return results;
+}
+
+ArenaVector<double> EndgameSolver::EvaluateCandidates(
+    ISimulationEvaluator& evaluator,
+    CompactBoard const& board,
+    Team team,
+    std::uint8_t end,
+    std::uint8_t shots_remaining,
+    ArenaVector<moves::Shot> const& candidates,
+    std::uint32_t trials,
+    players::IPlayer& player,
+    Objective const& objective,
+    SearchTree<>* tree
+) {
+    auto boards = MakeArenaVector<CompactBoard>(1);
+    boards.push_back(board);
+    auto shots = MakeArenaVector<ArenaVector<moves::Shot>>(1);
+    shots.push_back(candidates);
+    auto const results = Simulate(evaluator, boards, team, end, shots, trials, player);
+    auto values = MakeArenaVector<double>(candidates.size());
+    values.resize(candidates.size(), 0.);
+    if (ThinkingContext::IsCurrentCancelled()) return values;
+
+    auto const opponent = GetOpponentTeam(team);
+    if (shots_remaining == 1 || !board.FindFreeStoneIndex(opponent).has_value()) {
+        for (std::size_t k = 0; k < results.size(); ++k) {
+            values[k / trials] += objective.GetUtility(GetEndScore(results[k], team)) / trials;
+        }
+        return values;
+    }
+
+    // 各試行の盤面で相手の最後の1投を解き、その最善手を前提に評価する
+    auto const opponent_objective = objective.GetOpponent();
+    auto const reply_trials = std::max(1u, setting_.reply_trials);
+    auto replies = MakeArenaVector<ArenaVector<moves::Shot>>(results.size());
+    for (auto const& result : results) replies.push_back(GenerateCandidates(result, setting_.two_shot_grid_step));
+    auto const reply_results = Simulate(evaluator, results, opponent, end, replies, reply_trials, player);
+    if (ThinkingContext::IsCurrentCancelled()) return values;
+
+    std::size_t r = 0;
+    for (std::size_t k = 0; k < results.size(); ++k) {
+        double best_reply = -std::numeric_limits<double>::infinity();
+        for (std::size_t c = 0; c < replies[k].size(); ++c) {
+            double reply_value = 0.;
+            for (std::uint32_t t = 0; t < reply_trials; ++t, ++r) {
+                reply_value += opponent_objective.GetUtility(GetEndScore(reply_results[r], opponent));
+            }
+            best_reply = std::max(best_reply, reply_value / reply_trials);
+        }
+        values[k / trials] += (objective.GetTotal() - best_reply) / trials;
+
+        // 試行の盤面と相手の応手の評価を、実際の盤面で次のターンに引き継げるように残す
+        if (tree != nullptr) {
+            auto const node = tree->AddChild(tree->GetRoot(), results[k], candidates[k / trials]);
+            tree->AddResult(node, objective.GetTotal() - best_reply, 1 + replies[k].size() * reply_trials);
+        }
+    }
+    return values;
+}
+
+} // namespace digitalcurling::client
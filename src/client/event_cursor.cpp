@@ -0,0 +1,172 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: Unlicense
+
+#include <charconv>
+#include "digitalcurling/client/event_cursor.hpp"
+
+namespace digitalcurling::client {
+
+namespace {
+
+/// @brief 最上位のオブジェクトを走査して値のトークンを取り出す
+///
+/// 入れ子のオブジェクトや配列、文字列中の同名のキーは対象にしない。
+class TopLevelScanner {
+public:
+    explicit TopLevelScanner(std::string_view data) : data_(data) {}
+
+    /// @brief 最上位のキーの値のトークンを返す (文字列の場合は引用符を含む)
+    /// @param key キー
+    /// @return 値のトークン (見つからないか、JSONとして不正な場合は `std::nullopt`)
+    std::optional<std::string_view> Find(std::string_view key) {
+        pos_ = 0;
+        SkipSpace();
+        if (!Consume('{')) return std::nullopt;
+        SkipSpace();
+        if (Consume('}')) return std::nullopt;
+
+        while (true) {
+            SkipSpace();
+            auto const name = ScanString();
+            if (!name) return std::nullopt;
+            SkipSpace();
+            if (!Consume(':')) return std::nullopt;
+            SkipSpace();
+            auto const value = ScanValue();
+            if (!value) return std::nullopt;
+            if (name->substr(1, name->size() - 2) == key) return value;
+
+            SkipSpace();
+            if (Consume(',')) continue;
+            return std::nullopt;
+        }
+    }
+
+private:
+    std::string_view data_;
+    std::size_t pos_ = 0;
+
+    void SkipSpace() {
+        while (pos_ < data_.size() && (data_[pos_] == ' ' || data_[pos_] == '\t' || data_[pos_] == '\r' || data_[pos_] == '\n')) pos_++;
+    }
+
+    bool Consume(char c) {
+        if (pos_ >= data_.size() || data_[pos_] != c) return false;
+        pos_++;
+        return true;
+    }
+
+    std::optional<std::string_view> ScanString() {
+        auto const begin = pos_;
+        if (!Consume('"')) return std::nullopt;
+        for (; pos_ < data_.size(); pos_++) {
+            if (data_[pos_] == '\\') {
+                pos_++;
+            } else if (data_[pos_] == '"') {
+                pos_++;
+                return data_.substr(begin, pos_ - begin);
+            }
+        }
+        return std::nullopt;
+    }
+
+    std::optional<std::string_view> ScanValue() {
+        if (pos_ >= data_.size()) return std::nullopt;
+        auto const begin = pos_;
+        char const c = data_[pos_];
+        if (c == '"') return ScanString();
+
+        if (c == '{' || c == '[') {
+            // 入れ子は深さだけを数え、中の文字列の括弧は無視する
+            int depth = 0;
+            while (pos_ < data_.size()) {
+                char const d = data_[pos_];
+                if (d == '"') {
+                    if (!ScanString()) return std::nullopt;
+                    continue;
+                }
+                if (d == '{' || d == '[') {
+                    depth++;
+                } else if (d == '}' || d == ']') {
+                    if (--depth == 0) {
+                        pos_++;
+                        return data_.substr(begin, pos_ - begin);
+                    }
+                }
+                pos_++;
+            }
+            return std::nullopt;
+        }
+
+        while (pos_ < data_.size() && data_[pos_] != ',' && data_[pos_] != '}'
+            && data_[pos_] != ' ' && data_[pos_] != '\t' && data_[pos_] != '\r' && data_[pos_] != '\n') {
+            pos_++;
+        }
+        if (pos_ == begin) return std::nullopt;
+        return data_.substr(begin, pos_ - begin);
+    }
+};
+
+} // namespace
+
+EventHeader EventHeader::Peek(std::string_view data) {
+    EventHeader header;
+    TopLevelScanner scanner(data);
+    auto const end = scanner.Find("end_number");
+    auto const total_shot = scanner.Find("total_shot_number");
+    auto const next_team = scanner.Find("next_shot_team");
+    auto const winner = scanner.Find("winner_team");
+    if (!end || !total_shot || !next_team || !winner) return header;
+
+    EventCursor cursor {};
+    if (std::from_chars(end->data(), end->data() + end->size(), cursor.end).ec != std::errc()) return header;
+    if (*total_shot != "null"
+        && std::from_chars(total_shot->data(), total_shot->data() + total_shot->size(), cursor.total_shot).ec != std::errc()) {
+        return header;
+    }
+    cursor.has_next_team = *next_team != "null";
+
+    header.cursor = cursor;
+    if (*next_team == "\"team0\"") {
+        header.next_team = Team::k0;
+    } else if (*next_team == "\"team1\"") {
+        header.next_team = Team::k1;
+    }
+    header.is_game_over = *winner != "null";
+    return header;
+}
+
+bool EventCursorFilter::IsProcessed(EventHeader const& header, Team own_team) const {
+    // 位置が読み取れない場合は解析に任せ、試合終了のイベントは必ず処理する
+    if (!header.cursor.has_value() || header.is_game_over) return false;
+
+    std::lock_guard lock(mutex_);
+    if (!cursor_.has_value() || !(*header.cursor <= *cursor_)) return false;
+
+    // 行動を送信していない自チームの手番は、再送されたイベントから思考をやり直す
+    if (*header.cursor == *cursor_ && header.next_team != Team::kInvalid && header.next_team == own_team) {
+        return is_move_posted_;
+    }
+    return true;
+}
+
+bool EventCursorFilter::IsLatest(EventHeader const& header) const {
+    std::lock_guard lock(mutex_);
+    return header.cursor.has_value() && cursor_.has_value() && *header.cursor == *cursor_;
+}
+
+void EventCursorFilter::Commit(EventHeader const& header) {
+    if (!header.cursor.has_value()) return;
+
+    std::lock_guard lock(mutex_);
+    if (cursor_.has_value() && *header.cursor <= *cursor_) return;
+    cursor_ = header.cursor;
+    is_move_posted_ = false;
+}
+
+void EventCursorFilter::MarkMovePosted() {
+    std::lock_guard lock(mutex_);
+    is_move_posted_ = true;
+}
+
+} // namespace digitalcurling::client
@@ -0,0 +1,574 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: Unlicense
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <string>
+#include "digitalcurling/client/async_logger.hpp"
+#include "digitalcurling/client/client_helpers.hpp"
+#include "digitalcurling/client/free_path_model.hpp"
+#include "digitalcurling/client/profiler.hpp"
+#include "digitalcurling/client/simulation_evaluator.hpp"
+
+namespace digitalcurling::client {
+
+namespace {
+
+/// @brief 記録を打ち切るフレーム数 (停止しない場合の保険)
+constexpr std::uint32_t kMaxFrames = 1'000'000;
+
+/// @brief 点から線分までの距離の二乗
+float SquaredSegmentDistance(Vector2 const& a, Vector2 const& b, Vector2 const& p) {
+    auto const ab = b - a;
+    auto const ap = p - a;
+    float const length2 = ab.x * ab.x + ab.y * ab.y;
+    float const t = length2 > 0.f ? std::clamp((ap.x * ab.x + ap.y * ab.y) / length2, 0.f, 1.f) : 0.f;
+    auto const d = ap - ab * t;
+    return d.x * d.x + d.y * d.y;
+}
+
+/// @brief シートの境界から `margin` 以上内側にあるか (`IsVaildStone()` と同じ判定に余裕を加えたもの)
+bool IsInside(Vector2 const& position, float sheet_width, float margin) {
+    return position.x + Stone::kRadius < sheet_width / 2.f - margin
+        && position.x - Stone::kRadius > -sheet_width / 2.f + margin
+        && position.y - Stone::kRadius < coordinate::kBackLineY - margin
+        && position.y - Stone::kRadius > coordinate::kBackBoardY + margin;
+}
+
+} // namespace
+
+FreePathModel::FreePathModel(Setting const& setting, float sheet_width)
+  : setting_(setting),
+    sheet_width_(sheet_width),
+    trajectories_(),
+    reach_lengths_(),
+    use_prediction_(setting.use_prediction),
+    use_active_stones_(true),
+    use_checkpoints_(setting.use_checkpoints)
+{}
+
+std::unique_ptr<FreePathModel> FreePathModel::Fit(
+    simulators::ISimulatorFactory const& factory,
+    SimulatorPool& simulator_pool,
+    ThreadPool& thread_pool,
+    float sheet_width,
+    Setting const& setting
+) {
+    PROFILE_ZONE("FreePathModel::Fit");
+    std::unique_ptr<FreePathModel> model(new FreePathModel(setting, sheet_width));
+
+    auto const speed_count = static_cast<std::size_t>(std::floor((setting.max_speed - setting.min_speed) / setting.speed_step)) + 1;
+    auto const spin_count = setting.angular_velocities.size();
+    model->trajectories_.assign(spin_count, std::vector<Trajectory>(speed_count));
+    float const max_distance = std::hypot(sheet_width / 2.f + Stone::kRadius,
+        std::max(std::abs(coordinate::kBackLineY), std::abs(coordinate::kBackBoardY)) + Stone::kRadius);
+
+    thread_pool.ParallelFor(spin_count * speed_count, [&](std::size_t i) {
+        auto simulator = simulator_pool.Acquire(factory);
+        auto const spin = i / speed_count;
+        auto const speed = i % speed_count;
+        model->trajectories_[spin][speed] = Record(*simulator,
+            setting.min_speed + setting.speed_step * static_cast<float>(speed),
+            setting.angular_velocities[spin], setting.sample_frames, max_distance);
+    });
+
+    // 止まるまでの距離は初速について単調とは限らないため、それ以下の初速での最大値とする
+    model->reach_lengths_.assign(speed_count, 0.f);
+    for (std::size_t speed = 0; speed < speed_count; ++speed) {
+        float& length = model->reach_lengths_[speed];
+        if (speed > 0) length = model->reach_lengths_[speed - 1];
+        for (auto const& trajectories : model->trajectories_) {
+            auto const& trajectory = trajectories[speed];
+            length = std::max(length, trajectory.is_stopped ? trajectory.length : std::numeric_limits<float>::infinity());
+        }
+    }
+
+    // 予測、動きうるストーン、途中の状態はそれぞれ独立に検証し、誤差が許容範囲を超えたものだけを無効にする
+    if (setting.use_prediction) model->VerifyPrediction(factory, simulator_pool, thread_pool);
+    model->VerifyActiveStones(factory, simulator_pool, thread_pool);
+    if (setting.use_checkpoints) model->VerifyCheckpoints(factory, simulator_pool, thread_pool);
+
+    if (!model->use_prediction_ && !model->use_active_stones_ && !model->use_checkpoints_) return nullptr;
+    return model;
+}
+
+void FreePathModel::VerifyPrediction(
+    simulators::ISimulatorFactory const& factory,
+    SimulatorPool& simulator_pool,
+    ThreadPool& thread_pool
+) {
+    // 検証もスレッドごとに分けて行い、結果をまとめる
+    auto const& setting = setting_;
+    auto const spin_count = trajectories_.size();
+    auto const speed_count = reach_lengths_.size();
+    auto const chunk_count = std::max<std::size_t>(1, std::min(thread_pool.GetThreadCount(), setting.validation_count));
+    std::vector<FreePathValidation> chunks(chunk_count);
+    thread_pool.ParallelFor(chunk_count, [&](std::size_t chunk) {
+        auto simulator = simulator_pool.Acquire(factory);
+        auto const count = setting.validation_count * (chunk + 1) / chunk_count - setting.validation_count * chunk / chunk_count;
+        chunks[chunk] = Validate(*simulator, count, static_cast<std::uint32_t>(chunk));
+    });
+
+    FreePathValidation validation;
+    double square_sum = 0.;
+    for (auto const& chunk : chunks) {
+        validation.predicted_count += chunk.predicted_count;
+        validation.max_error = std::max(validation.max_error, chunk.max_error);
+        square_sum += static_cast<double>(chunk.rms_error) * chunk.rms_error * chunk.predicted_count;
+    }
+    if (validation.predicted_count > 0) {
+        validation.rms_error = static_cast<float>(std::sqrt(square_sum / validation.predicted_count));
+    }
+    if (!(validation.max_error <= setting.tolerance)) {
+        use_prediction_ = false;
+        AsyncLogger::GetInstance().Log(LogLevel::kWarning, "free_path",
+            "prediction disabled: max error %.4f m exceeds tolerance %.4f m (%zu/%zu predicted)",
+            validation.max_error, setting.tolerance, validation.predicted_count, setting.validation_count);
+        return;
+    }
+    AsyncLogger::GetInstance().Log(LogLevel::kInfo, "free_path",
+        "fitted %zu trajectories: max error %.4f m, rms %.4f m (%zu/%zu predicted)",
+        spin_count * speed_count, validation.max_error, validation.rms_error,
+        validation.predicted_count, setting.validation_count);
+}
+
+void FreePathModel::VerifyActiveStones(
+    simulators::ISimulatorFactory const& factory,
+    SimulatorPool& simulator_pool,
+    ThreadPool& thread_pool
+) {
+    auto const& setting = setting_;
+    auto const active_chunk_count = std::max<std::size_t>(1, std::min(thread_pool.GetThreadCount(), setting.active_validation_count));
+    std::vector<ActiveStonesValidation> active_chunks(active_chunk_count);
+    thread_pool.ParallelFor(active_chunk_count, [&](std::size_t chunk) {
+        auto simulator = simulator_pool.Acquire(factory);
+        auto const count = setting.active_validation_count * (chunk + 1) / active_chunk_count
+            - setting.active_validation_count * chunk / active_chunk_count;
+        active_chunks[chunk] = ValidateActiveStones(*simulator, count, static_cast<std::uint32_t>(chunk));
+    });
+
+    ActiveStonesValidation active_validation;
+    for (auto const& chunk : active_chunks) {
+        active_validation.mismatch_count += chunk.mismatch_count;
+        for (std::size_t n = 0; n < CompactBoard::kStoneCount; ++n) {
+            active_validation.counts[n] += chunk.counts[n];
+            active_validation.full_seconds[n] += chunk.full_seconds[n];
+            active_validation.active_seconds[n] += chunk.active_seconds[n];
+        }
+    }
+    if (active_validation.mismatch_count > 0) {
+        use_active_stones_ = false;
+        AsyncLogger::GetInstance().Log(LogLevel::kWarning, "free_path",
+            "active stones disabled: %zu/%zu boards differ from full simulation",
+            active_validation.mismatch_count, setting.active_validation_count);
+    } else {
+        std::string speedups;
+        char buffer[32];
+        for (std::size_t n = 1; n < CompactBoard::kStoneCount; ++n) {
+            if (active_validation.counts[n] == 0 || active_validation.active_seconds[n] <= 0.) continue;
+            std::snprintf(buffer, sizeof(buffer), " %zu:%.2fx", n, active_validation.full_seconds[n] / active_validation.active_seconds[n]);
+            speedups += buffer;
+        }
+        AsyncLogger::GetInstance().Log(LogLevel::kInfo, "free_path",
+            "active stones: identical on %zu boards, speed-up by stone count%s",
+            setting.active_validation_count, speedups.c_str());
+    }
+}
+
+void FreePathModel::VerifyCheckpoints(
+    simulators::ISimulatorFactory const& factory,
+    SimulatorPool& simulator_pool,
+    ThreadPool& thread_pool
+) {
+    auto const& setting = setting_;
+    auto const checkpoint_chunk_count = std::max<std::size_t>(1, std::min(thread_pool.GetThreadCount(), setting.checkpoint_validation_count));
+    std::vector<CheckpointValidation> checkpoint_chunks(checkpoint_chunk_count);
+    thread_pool.ParallelFor(checkpoint_chunk_count, [&](std::size_t chunk) {
+        auto simulator = simulator_pool.Acquire(factory);
+        auto const count = setting.checkpoint_validation_count * (chunk + 1) / checkpoint_chunk_count
+            - setting.checkpoint_validation_count * chunk / checkpoint_chunk_count;
+        checkpoint_chunks[chunk] = ValidateCheckpoints(*simulator, count, static_cast<std::uint32_t>(chunk));
+    });
+
+    CheckpointValidation checkpoint_validation;
+    for (auto const& chunk : checkpoint_chunks) {
+        checkpoint_validation.count += chunk.count;
+        checkpoint_validation.max_position_error = std::max(checkpoint_validation.max_position_error, chunk.max_position_error);
+        checkpoint_validation.max_velocity_error = std::max(checkpoint_validation.max_velocity_error, chunk.max_velocity_error);
+    }
+    if (!(checkpoint_validation.max_position_error <= setting.tolerance)
+        || !(checkpoint_validation.max_velocity_error <= setting.velocity_tolerance)) {
+        use_checkpoints_ = false;
+        AsyncLogger::GetInstance().Log(LogLevel::kWarning, "free_path",
+            "checkpoints disabled: max error %.4f m, %.5f m/s exceeds tolerance %.4f m, %.5f m/s",
+            checkpoint_validation.max_position_error, checkpoint_validation.max_velocity_error,
+            setting.tolerance, setting.velocity_tolerance);
+    } else {
+        AsyncLogger::GetInstance().Log(LogLevel::kInfo, "free_path",
+            "checkpoints: max error %.4f m, %.5f m/s (%zu states)",
+            checkpoint_validation.max_position_error, checkpoint_validation.max_velocity_error, checkpoint_validation.count);
+    }
+}
+
+FreePathModel::Trajectory FreePathModel::Record(
+    simulators::ISimulator& simulator,
+    float speed,
+    float angular_velocity,
+    std::uint32_t sample_frames,
+    float max_distance
+) {
+    simulators::ISimulator::AllStones stones;
+    stones[0] = simulators::ISimulator::StoneState(Vector2 { 0.f, 0.f }, 0.f, Vector2 { 0.f, speed }, angular_velocity);
+    simulator.SetStones(stones);
+
+    Trajectory trajectory;
+    trajectory.states.push_back(stones[0].value());
+    auto const push = [&trajectory](simulators::ISimulator::StoneState const& stone) {
+        auto const d = stone.position - trajectory.states.back().position;
+        trajectory.length += std::hypot(d.x, d.y);
+        trajectory.states.push_back(stone);
+    };
+    for (std::uint32_t frame = 1; frame <= kMaxFrames; ++frame) {
+        simulator.Step();
+        auto const& stone = simulator.GetStones()[0].value();
+        auto const position = stone.position;
+        if (simulator.AreAllStonesStopped()) {
+            push(stone);
+            trajectory.is_stopped = true;
+            break;
+        }
+        if (frame % sample_frames == 0) {
+            push(stone);
+            // どの向きに投げても盤面外に出ている距離を超えたら、以降は記録しない
+            if (std::hypot(position.x, position.y) > max_distance) break;
+        }
+    }
+    return trajectory;
+}
+
+FreePathModel::PathResult FreePathModel::Trace(
+    Trajectory const& trajectory,
+    float cos,
+    float sin,
+    CompactBoard const& board,
+    std::uint8_t stone_index,
+    std::size_t* contact
+) const {
+    float const contact_distance = 2.f * Stone::kRadius + setting_.clearance;
+    float const contact_distance2 = contact_distance * contact_distance;
+
+    Vector2 previous;
+    for (std::size_t k = 0; k < trajectory.states.size(); ++k) {
+        auto const& point = trajectory.states[k].position;
+        Vector2 const position(cos * point.x - sin * point.y, sin * point.x + cos * point.y);
+        if (k == 0) previous = position;
+
+        for (std::size_t i = 0; i < CompactBoard::kStoneCount; ++i) {
+            if (i == stone_index || !board.HasStone(i)) continue;
+            if (SquaredSegmentDistance(previous, position, board.GetPosition(i)) < contact_distance2) {
+                if (contact != nullptr) *contact = k;
+                return PathResult::kContact;
+            }
+        }
+
+        // 境界を明らかに越えた時点で取り除かれる。境界付近はシミュレーションに任せる
+        if (!IsInside(position, sheet_width_, -setting_.clearance)) return PathResult::kRemoved;
+        if (!IsInside(position, sheet_width_, setting_.clearance)) return PathResult::kUncertain;
+        previous = position;
+    }
+    return trajectory.is_stopped ? PathResult::kStopped : PathResult::kUncertain;
+}
+
+std::optional<FreePathModel::Bracket> FreePathModel::Locate(moves::Shot const& shot) const {
+    auto const spin_it = std::find_if(setting_.angular_velocities.begin(), setting_.angular_velocities.end(),
+        [&shot](float angular_velocity) { return std::abs(angular_velocity - shot.angular_velocity) < 1e-4f; });
+    if (spin_it == setting_.angular_velocities.end()) return std::nullopt;
+    auto const& trajectories = trajectories_[spin_it - setting_.angular_velocities.begin()];
+
+    float const t = (shot.translational_velocity - setting_.min_speed) / setting_.speed_step;
+    if (!(t >= 0.f)) return std::nullopt;
+    auto const index = static_cast<std::size_t>(t);
+    if (index + 1 >= trajectories.size()) return std::nullopt;
+
+    // 基準の向き (+y) からショットの向きへの回転
+    auto const velocity = shot.ToVector2();
+    float const speed = std::hypot(velocity.x, velocity.y);
+    if (!(speed > 0.f)) return std::nullopt;
+
+    Bracket bracket;
+    bracket.lower = &trajectories[index];
+    bracket.upper = &trajectories[index + 1];
+    bracket.weight = t - static_cast<float>(index);
+    bracket.cos = velocity.y / speed;
+    bracket.sin = -velocity.x / speed;
+    return bracket;
+}
+
+std::optional<CompactBoard> FreePathModel::Predict(
+    CompactBoard const& board,
+    std::uint8_t stone_index,
+    moves::Shot const& shot
+) const {
+    if (!use_prediction_) return std::nullopt;
+    auto const bracket = Locate(shot);
+    if (!bracket.has_value()) return std::nullopt;
+    auto const cos = bracket->cos;
+    auto const sin = bracket->sin;
+
+    // 補間する軌跡は両側の軌跡の間を通るため、両側とも同じ結果になる場合のみ予測する
+    auto const result = Trace(*bracket->lower, cos, sin, board, stone_index);
+    if (result != PathResult::kStopped && result != PathResult::kRemoved) return std::nullopt;
+    if (Trace(*bracket->upper, cos, sin, board, stone_index) != result) return std::nullopt;
+
+    CompactBoard after = board;
+    if (result == PathResult::kRemoved) {
+        after.RemoveStone(stone_index);
+        return after;
+    }
+
+    auto const point = bracket->lower->states.back().position * (1.f - bracket->weight)
+        + bracket->upper->states.back().position * bracket->weight;
+    Vector2 const position(cos * point.x - sin * point.y, sin * point.x + cos * point.y);
+    if (!IsInside(position, sheet_width_, setting_.clearance)) return std::nullopt;
+    after.SetStone(stone_index, position);
+    return after;
+}
+
+std::optional<std::uint16_t> FreePathModel::FindActiveStones(
+    CompactBoard const& board,
+    std::uint8_t stone_index,
+    moves::Shot const& shot
+) const {
+    if (!use_active_stones_) return std::nullopt;
+    auto const bracket = Locate(shot);
+    if (!bracket.has_value()) return std::nullopt;
+    auto const cos = bracket->cos;
+    auto const sin = bracket->sin;
+    auto const rotate = [cos, sin](Vector2 const& point) {
+        return Vector2(cos * point.x - sin * point.y, sin * point.x + cos * point.y);
+    };
+
+    std::uint16_t active = static_cast<std::uint16_t>(1u << stone_index);
+    std::uint16_t pending = 0;
+    float const contact_distance = 2.f * Stone::kRadius + setting_.clearance;
+
+    // 最初に触れうる位置より後は、その時点の速さで止まるまでの距離の範囲内のどこへでも動きうる。
+    // 衝突で速さは増えないため、弾かれたストーンも同じ距離の範囲内にとどまる
+    float reach = 0.f;
+    for (auto const* trajectory : { bracket->lower, bracket->upper }) {
+        std::size_t contact = 0;
+        auto const result = Trace(*trajectory, cos, sin, board, stone_index, &contact);
+        if (result == PathResult::kStopped || result == PathResult::kRemoved) continue;
+        if (result != PathResult::kContact) return std::nullopt;
+
+        auto const before = contact > 0 ? contact - 1 : 0;
+        auto const& velocity = trajectory->states[before].linear_velocity;
+        auto const length = GetReachLength(std::hypot(velocity.x, velocity.y));
+        if (!length.has_value()) return std::nullopt;
+        float const radius = length.value() * (1.f + setting_.reach_margin) + contact_distance;
+        reach = std::max(reach, radius);
+
+        auto const a = rotate(trajectory->states[before].position);
+        auto const b = rotate(trajectory->states[contact].position);
+        for (std::size_t i = 0; i < CompactBoard::kStoneCount; ++i) {
+            if (((active | pending) >> i) & 1u || !board.HasStone(i)) continue;
+            if (SquaredSegmentDistance(a, b, board.GetPosition(i)) < radius * radius) {
+                pending |= static_cast<std::uint16_t>(1u << i);
+            }
+        }
+    }
+
+    // 動きうるストーンから届く範囲のストーンを順に加える
+    float const reach2 = reach * reach;
+    while (pending != 0) {
+        std::size_t i = 0;
+        while (((pending >> i) & 1u) == 0) ++i;
+        pending &= static_cast<std::uint16_t>(~(1u << i));
+        active |= static_cast<std::uint16_t>(1u << i);
+
+        auto const position = board.GetPosition(i);
+        for (std::size_t j = 0; j < CompactBoard::kStoneCount; ++j) {
+            if (((active | pending) >> j) & 1u || !board.HasStone(j)) continue;
+            auto const d = board.GetPosition(j) - position;
+            if (d.x * d.x + d.y * d.y < reach2) pending |= static_cast<std::uint16_t>(1u << j);
+        }
+    }
+    return active;
+}
+
+std::optional<simulators::ISimulator::StoneState> FreePathModel::FindCheckpoint(
+    CompactBoard const& board,
+    std::uint8_t stone_index,
+    moves::Shot const& shot
+) const {
+    if (!use_checkpoints_) return std::nullopt;
+    auto const bracket = Locate(shot);
+    if (!bracket.has_value()) return std::nullopt;
+
+    // 両側の軌跡とも触れる手前までは他のストーンにもシートの境界にも触れない。
+    // 停止した軌跡の最後の状態はフレームの間隔が揃っていないため用いない
+    std::size_t sample = std::min(bracket->lower->states.size(), bracket->upper->states.size()) - 1;
+    for (auto const* trajectory : { bracket->lower, bracket->upper }) {
+        std::size_t contact = 0;
+        if (Trace(*trajectory, bracket->cos, bracket->sin, board, stone_index, &contact) != PathResult::kContact) return std::nullopt;
+        sample = std::min(sample, contact);
+    }
+    if (sample < 2) return std::nullopt;
+    return Interpolate(bracket.value(), sample - 1);
+}
+
+simulators::ISimulator::StoneState FreePathModel::Interpolate(Bracket const& bracket, std::size_t sample) const {
+    auto const& lower = bracket.lower->states[sample];
+    auto const& upper = bracket.upper->states[sample];
+    float const w = bracket.weight;
+    auto const rotate = [&bracket](Vector2 const& v) {
+        return Vector2(bracket.cos * v.x - bracket.sin * v.y, bracket.sin * v.x + bracket.cos * v.y);
+    };
+
+    // ストーンの向きは投げた時点で 0 のため、ショットの向きによらず回転しない
+    return simulators::ISimulator::StoneState(
+        rotate(lower.position * (1.f - w) + upper.position * w),
+        lower.angle * (1.f - w) + upper.angle * w,
+        rotate(lower.linear_velocity * (1.f - w) + upper.linear_velocity * w),
+        lower.angular_velocity * (1.f - w) + upper.angular_velocity * w
+    );
+}
+
+std::optional<float> FreePathModel::GetReachLength(float speed) const {
+    float const t = std::max(0.f, (speed - setting_.min_speed) / setting_.speed_step);
+    auto const index = static_cast<std::size_t>(std::ceil(t));
+    if (index >= reach_lengths_.size() || !std::isfinite(reach_lengths_[index])) return std::nullopt;
+    return reach_lengths_[index];
+}
+
+FreePathValidation FreePathModel::Validate(simulators::ISimulator& simulator, std::size_t count, std::uint32_t seed) const {
+    std::mt19937 random(seed);
+    std::uniform_real_distribution<float> speed_dist(setting_.min_speed, setting_.max_speed - setting_.speed_step);
+    std::uniform_real_distribution<float> angle_dist(-0.1f, 0.1f);
+    std::uniform_int_distribution<std::size_t> spin_dist(0, setting_.angular_velocities.size() - 1);
+
+    FreePathValidation validation;
+    if (setting_.angular_velocities.empty()) return validation;
+
+    double square_sum = 0.;
+    CompactBoard const empty;
+    for (std::size_t i = 0; i < count; ++i) {
+        moves::Shot const shot(speed_dist(random), setting_.angular_velocities[spin_dist(random)], angle_dist(random));
+        auto const predicted = Predict(empty, 0, shot);
+        if (!predicted.has_value()) continue;
+        validation.predicted_count++;
+
+        simulators::ISimulator::AllStones stones;
+        stones[0] = simulators::ISimulator::StoneState(Vector2 { 0.f, 0.f }, 0.f, shot.ToVector2(), shot.angular_velocity);
+        simulator.SetStones(stones);
+        SimulateFull(&simulator, sheet_width_);
+        auto const simulated = CompactBoard::FromSimulatorStones(simulator.GetStones());
+
+        float error = 0.f;
+        if (predicted->HasStone(0) != simulated.HasStone(0)) {
+            error = std::numeric_limits<float>::infinity();
+        } else if (simulated.HasStone(0)) {
+            auto const d = predicted->GetPosition(0) - simulated.GetPosition(0);
+            error = std::hypot(d.x, d.y);
+        }
+        validation.max_error = std::max(validation.max_error, error);
+        square_sum += static_cast<double>(error) * error;
+    }
+    if (validation.predicted_count > 0) {
+        validation.rms_error = static_cast<float>(std::sqrt(square_sum / validation.predicted_count));
+    }
+    return validation;
+}
+
+ActiveStonesValidation FreePathModel::ValidateActiveStones(simulators::ISimulator& simulator, std::size_t count, std::uint32_t seed) const {
+    using Clock = std::chrono::steady_clock;
+    std::mt19937 random(seed);
+    std::uniform_real_distribution<float> speed_dist(setting_.min_speed, setting_.max_speed - setting_.speed_step);
+    std::uniform_real_distribution<float> angle_dist(-0.05f, 0.05f);
+    std::uniform_int_distribution<std::size_t> spin_dist(0, setting_.angular_velocities.size() - 1);
+    // ハウスとその手前のガードの範囲
+    float const half_width = sheet_width_ / 2.f - Stone::kRadius - setting_.clearance;
+    std::uniform_real_distribution<float> x_dist(-half_width, half_width);
+    std::uniform_real_distribution<float> y_dist(coordinate::kTee.y - 6.4f, coordinate::kBackLineY);
+
+    ActiveStonesValidation validation;
+    if (setting_.angular_velocities.empty()) return validation;
+
+    for (std::size_t i = 0; i < count; ++i) {
+        // 投げるストーンを 0 番とし、残りのストーンを重ならないように置く
+        auto const stone_count = 1 + (seed + i) % (CompactBoard::kStoneCount - 1);
+        CompactBoard board;
+        for (std::size_t n = 1; n <= stone_count; ++n) {
+            for (int attempt = 0; attempt < 100; ++attempt) {
+                Vector2 const position(x_dist(random), y_dist(random));
+                bool overlaps = false;
+                for (std::size_t j = 1; j < n; ++j) {
+                    auto const d = board.GetPosition(j) - position;
+                    overlaps = overlaps || d.x * d.x + d.y * d.y < 4.f * Stone::kRadius * Stone::kRadius;
+                }
+                if (!overlaps) {
+                    board.SetStone(n, position);
+                    break;
+                }
+            }
+        }
+
+        moves::Shot const shot(speed_dist(random), setting_.angular_velocities[spin_dist(random)], angle_dist(random));
+        auto const active = FindActiveStones(board, 0, shot);
+        if (!active.has_value()) continue;
+
+        auto full = SimulationJob::Create(board, 0, shot);
+        auto subset = full;
+        auto const start = Clock::now();
+        RunSimulationJob(simulator, full, sheet_width_);
+        auto const middle = Clock::now();
+        RunSimulationJob(simulator, subset, sheet_width_, active.value());
+        auto const end = Clock::now();
+
+        if (full.board != subset.board) validation.mismatch_count++;
+        validation.counts[stone_count]++;
+        validation.full_seconds[stone_count] += std::chrono::duration<double>(middle - start).count();
+        validation.active_seconds[stone_count] += std::chrono::duration<double>(end - middle).count();
+    }
+    return validation;
+}
+
+CheckpointValidation FreePathModel::ValidateCheckpoints(simulators::ISimulator& simulator, std::size_t count, std::uint32_t seed) const {
+    std::mt19937 random(seed);
+    std::uniform_real_distribution<float> speed_dist(setting_.min_speed, setting_.max_speed - setting_.speed_step);
+    std::uniform_real_distribution<float> angle_dist(-0.1f, 0.1f);
+    std::uniform_int_distribution<std::size_t> spin_dist(0, setting_.angular_velocities.size() - 1);
+
+    CheckpointValidation validation;
+    if (setting_.angular_velocities.empty()) return validation;
+
+    for (std::size_t i = 0; i < count; ++i) {
+        moves::Shot const shot(speed_dist(random), setting_.angular_velocities[spin_dist(random)], angle_dist(random));
+        auto const bracket = Locate(shot);
+        if (!bracket.has_value()) continue;
+        auto const sample_count = std::min(bracket->lower->states.size(), bracket->upper->states.size()) - 1;
+        if (sample_count < 2) continue;
+        auto const sample = std::uniform_int_distribution<std::size_t>(1, sample_count - 1)(random);
+        auto const expected = Interpolate(bracket.value(), sample);
+
+        simulators::ISimulator::AllStones stones;
+        stones[0] = simulators::ISimulator::StoneState(Vector2 { 0.f, 0.f }, 0.f, shot.ToVector2(), shot.angular_velocity);
+        simulator.SetStones(stones);
+        for (std::size_t frame = 0; frame < sample * setting_.sample_frames; ++frame) simulator.Step();
+        auto const& actual = simulator.GetStones()[0];
+        if (!actual.has_value()) continue;
+
+        auto const dp = actual->position - expected.position;
+        auto const dv = actual->linear_velocity - expected.linear_velocity;
+        validation.count++;
+        validation.max_position_error = std::max(validation.max_position_error, std::hypot(dp.x, dp.y));
+        validation.max_velocity_error = std::max(validation.max_velocity_error, std::hypot(dv.x, dv.y));
+    }
+    return validation;
+}
+
+} // namespace digitalcurling::client
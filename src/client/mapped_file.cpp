@@ -0,0 +1,114 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: Unlicense
+
+#include <stdexcept>
+#include <utility>
+#include "digitalcurling/client/mapped_file.hpp"
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace digitalcurling::client {
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(std::filesystem::path const& path) {
+    auto file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("Failed to open " + path.string());
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)) {
+        CloseHandle(file);
+        throw std::runtime_error("Failed to get the size of " + path.string());
+    }
+    size_ = static_cast<std::size_t>(size.QuadPart);
+    file_handle_ = file;
+    if (size_ == 0) return;
+
+    mapping_handle_ = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping_handle_ != nullptr) {
+        data_ = MapViewOfFile(mapping_handle_, FILE_MAP_READ, 0, 0, 0);
+    }
+    if (data_ == nullptr) {
+        Close();
+        throw std::runtime_error("Failed to map " + path.string());
+    }
+}
+
+void MappedFile::Close() {
+    if (data_ != nullptr) UnmapViewOfFile(data_);
+    if (mapping_handle_ != nullptr) CloseHandle(mapping_handle_);
+    if (file_handle_ != nullptr) CloseHandle(file_handle_);
+    data_ = nullptr;
+    size_ = 0;
+    mapping_handle_ = nullptr;
+    file_handle_ = nullptr;
+}
+
+#else // _WIN32
+
+MappedFile::MappedFile(std::filesystem::path const& path) {
+    int const fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open " + path.string());
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        throw std::runtime_error("Failed to get the size of " + path.string());
+    }
+    size_ = static_cast<std::size_t>(st.st_size);
+    if (size_ == 0) {
+        close(fd);
+        return;
+    }
+
+    // マップはファイルを閉じた後も有効
+    void* address = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (address == MAP_FAILED) {
+        size_ = 0;
+        throw std::runtime_error("Failed to map " + path.string());
+    }
+    data_ = address;
+}
+
+void MappedFile::Close() {
+    if (data_ != nullptr) munmap(const_cast<void*>(data_), size_);
+    data_ = nullptr;
+    size_ = 0;
+}
+
+#endif // _WIN32
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+    *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        Close();
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+#ifdef _WIN32
+        std::swap(file_handle_, other.file_handle_);
+        std::swap(mapping_handle_, other.mapping_handle_);
+#endif
+    }
+    return *this;
+}
+
+MappedFile::~MappedFile() {
+    Close();
+}
+
+} // namespace digitalcurling::client
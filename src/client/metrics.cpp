@@ -0,0 +1,120 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: Unlicense
+
+#include <sstream>
+#include <stdexcept>
+#include <httplib.h>
+#include "digitalcurling/client/metrics.hpp"
+
+namespace digitalcurling::client {
+
+namespace {
+
+constexpr char const* kPrefix = "digitalcurling_client_";
+
+void WriteHeader(std::ostringstream& stream, char const* name, char const* type, char const* help) {
+    stream << "# HELP " << kPrefix << name << " " << help << "\n"
+           << "# TYPE " << kPrefix << name << " " << type << "\n";
+}
+
+void WriteCounter(std::ostringstream& stream, char const* name, char const* help, std::uint64_t value) {
+    WriteHeader(stream, name, "counter", help);
+    stream << kPrefix << name << " " << value << "\n";
+}
+
+void WriteGauge(std::ostringstream& stream, char const* name, char const* help, double value) {
+    WriteHeader(stream, name, "gauge", help);
+    stream << kPrefix << name << " " << value << "\n";
+}
+
+void WriteTimer(std::ostringstream& stream, char const* name, char const* help, MetricTimer const& timer) {
+    WriteHeader(stream, name, "summary", help);
+    stream << kPrefix << name << "_sum " << timer.GetSum() << "\n"
+           << kPrefix << name << "_count " << timer.GetCount() << "\n";
+}
+
+} // namespace
+
+// --- Metrics ---
+Metrics& Metrics::GetInstance() {
+    static Metrics instance;
+    return instance;
+}
+
+CacheMetrics& Metrics::GetCache(std::string const& name) {
+    std::lock_guard lock(caches_mutex_);
+    for (std::size_t i = 0; i < cache_count_; ++i) {
+        if (cache_names_[i] == name) return caches_[i];
+    }
+    if (cache_count_ == kMaxCaches) {
+        throw std::runtime_error("Metrics: too many caches.");
+    }
+    cache_names_[cache_count_] = name;
+    return caches_[cache_count_++];
+}
+
+std::string Metrics::Render() const {
+    std::ostringstream stream;
+    WriteCounter(stream, "events_received_total", "Number of SSE events received.", events_received.Get());
+    WriteCounter(stream, "events_processed_total", "Number of SSE events processed.", events_processed.Get());
+    WriteGauge(stream, "event_queue_depth", "Number of SSE events waiting to be processed.", event_queue_depth.Get());
+    WriteTimer(stream, "parse_seconds", "Time spent parsing state update events.", parse_time);
+    WriteTimer(stream, "think_seconds", "Time spent thinking on our turns.", think_time);
+    WriteGauge(stream, "last_think_seconds", "Thinking time of the last turn.", think_time.GetLast());
+    WriteCounter(stream, "simulations_total", "Number of simulation jobs evaluated by the engine.", simulations.Get());
+    WriteGauge(stream, "simulations_per_second", "Throughput of the last simulation evaluation.", simulations_per_second.Get());
+    WriteCounter(stream, "carried_playouts_total", "Number of search tree playouts carried over to the next turn.", carried_playouts.Get());
+    WriteGauge(stream, "screening_error", "Standard deviation of the coarse screening error.", screening_error.Get());
+
+    WriteHeader(stream, "remaining_time_seconds", "gauge", "Remaining thinking time of each team.");
+    stream << kPrefix << "remaining_time_seconds{team=\"team0\"} " << remaining_time_team0.Get() << "\n"
+           << kPrefix << "remaining_time_seconds{team=\"team1\"} " << remaining_time_team1.Get() << "\n";
+
+    WriteCounter(stream, "reconnects_total", "Number of SSE reconnections.", reconnects.Get());
+    WriteCounter(stream, "events_discarded_total", "Number of already processed SSE events discarded after reconnection.", events_discarded.Get());
+    WriteTimer(stream, "reconnect_ready_seconds", "Time from disconnection until the latest state is received again.", reconnect_ready_time);
+
+    std::lock_guard lock(caches_mutex_);
+    if (cache_count_ > 0) {
+        WriteHeader(stream, "cache_lookups_total", "counter", "Number of cache lookups by result.");
+        for (std::size_t i = 0; i < cache_count_; ++i) {
+            stream << kPrefix << "cache_lookups_total{cache=\"" << cache_names_[i] << "\",result=\"hit\"} "
+                   << caches_[i].hits.Get() << "\n"
+                   << kPrefix << "cache_lookups_total{cache=\"" << cache_names_[i] << "\",result=\"miss\"} "
+                   << caches_[i].misses.Get() << "\n";
+        }
+    }
+    return stream.str();
+}
+
+
+// --- MetricsServer ---
+MetricsServer::MetricsServer() = default;
+
+MetricsServer::~MetricsServer() {
+    Stop();
+}
+
+void MetricsServer::Start(std::string const& host, int port) {
+    Stop();
+
+    server_ = std::make_unique<httplib::Server>();
+    server_->Get("/metrics", [](httplib::Request const&, httplib::Response& res) {
+        res.set_content(Metrics::GetInstance().Render(), "text/plain; version=0.0.4");
+    });
+    if (!server_->bind_to_port(host, port)) {
+        server_.reset();
+        throw std::runtime_error("MetricsServer: failed to bind " + host + ":" + std::to_string(port));
+    }
+    thread_ = std::thread([server = server_.get()]() {
+        server->listen_after_bind();
+    });
+}
+
+void MetricsServer::Stop() {
+    if (server_) server_->stop();
+    if (thread_.joinable()) thread_.join();
+    server_.reset();
+}
+
+} // namespace digitalcurling::client
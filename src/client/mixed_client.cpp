@@ -46,6 +46,10 @@ std::vector<std::uint8_t> MixedClient::GetPlayersIndex() const {
     return players_index_;
 }
 
+void MixedClient::OnWarmUp() {
+    engine_->OnWarmUp();
+}
+
 void MixedClient::OnGameStart(
     Team const& team,
     std::vector<std::pair<GameState, std::optional<moves::Shot>>> states
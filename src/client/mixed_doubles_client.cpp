@@ -38,6 +38,10 @@ std::vector<std::uint8_t> MixedDoublesClient::GetPlayersIndex() const {
     return players_index_;
 }
 
+void MixedDoublesClient::OnWarmUp() {
+    engine_->OnWarmUp();
+}
+
 void MixedDoublesClient::OnGameStart(
     Team const& team,
     std::vector<std::pair<GameState, std::optional<moves::Shot>>> states
@@ -49,36 +53,48 @@ void MixedDoublesClient::OnNextEnd(StateUpdateEventData const& event_data) {
     if (event_data.next_shot_team == Team::kInvalid) {
         if (event_data.game_state.hammer != team_ || event_data.last_shot.has_value()) return;
 
-        std::string team_path = "/matches/" + game_id_ + "/end-setup?request=";
-        switch (engine_->OnDecidePositionedStone(event_data.game_state)) {
-            case StoneOpts::kCenterGuard:
-                team_path += "center_guard";
-                break;
-            case StoneOpts::kCenterHouse:
-                team_path += "center_house";
-                break;
-            case StoneOpts::kPowerPlayLeft:
-                team_path += "pp_left";
-                break;
-            case StoneOpts::kPowerPlayRight:
-                team_path += "pp_right";
-                break;
-            default:
-                throw std::runtime_error("Invalid PositionedStoneOptions");
-        }
-
-        auto result = http_client_.Post(team_path);
-        if (!result) {
-            throw std::runtime_error("Failed to setup end stones: " + httplib::to_string(result.error()));
-        } else if (result->status != 200) {
-            std::string err = "Failed to setup end stones: return status code " + std::to_string(result->status);
-            if (!result->body.empty()) err += " " + result->body;
-            throw std::runtime_error(err);
-        }
+        // 配置もショットと同じく別のスレッドで決め、イベントの処理と思考の期限の確認を止めない
+        StartThinking(event_data, [this, game_state = event_data.game_state]() -> std::function<void()> {
+            auto const option = engine_->OnDecidePositionedStone(game_state);
+            return [this, option]() { PostPositionedStone(option); };
+        }, [this](ThinkingContext const&) {
+            // 配置は公開されないため、期限を過ぎた場合は既定の配置を送信する
+            PostPositionedStone(StoneOpts::kCenterHouse);
+            return true;
+        });
     } else {
         engine_->OnNextEnd(event_data.game_state);
     }
 }
+
+void MixedDoublesClient::PostPositionedStone(StoneOpts option) {
+    std::string team_path = "/matches/" + game_id_ + "/end-setup?request=";
+    switch (option) {
+        case StoneOpts::kCenterGuard:
+            team_path += "center_guard";
+            break;
+        case StoneOpts::kCenterHouse:
+            team_path += "center_house";
+            break;
+        case StoneOpts::kPowerPlayLeft:
+            team_path += "pp_left";
+            break;
+        case StoneOpts::kPowerPlayRight:
+            team_path += "pp_right";
+            break;
+        default:
+            throw std::runtime_error("Invalid PositionedStoneOptions");
+    }
+
+    auto result = http_client_.Post(team_path);
+    if (!result) {
+        throw std::runtime_error("Failed to setup end stones: " + httplib::to_string(result.error()));
+    } else if (result->status != 200) {
+        std::string err = "Failed to setup end stones: return status code " + std::to_string(result->status);
+        if (!result->body.empty()) err += " " + result->body;
+        throw std::runtime_error(err);
+    }
+}
 moves::Move MixedDoublesClient::OnMyTurn(StateUpdateEventData const& event_data) {
     int index = event_data.game_state.shot == 0 || event_data.game_state.shot == 4 ? 0 : 1;
     return engine_->OnMyTurn(
@@ -0,0 +1,61 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: Unlicense
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include "digitalcurling/client/metrics.hpp"
+#include "digitalcurling/client/multi_fidelity_evaluator.hpp"
+
+namespace digitalcurling::client {
+
+MultiFidelityEvaluator::MultiFidelityEvaluator(
+    ISimulationEvaluator& fine,
+    std::unique_ptr<ISimulationEvaluator> screening,
+    Setting const& setting
+)
+  : fine_(fine),
+    screening_(std::move(screening)),
+    setting_(setting)
+{}
+
+ArenaVector<std::size_t> MultiFidelityEvaluator::Select(
+    ArenaVector<double> const& values,
+    std::size_t min_count,
+    std::size_t max_count
+) const {
+    auto order = MakeArenaVector<std::size_t>(values.size());
+    order.resize(values.size());
+    std::iota(order.begin(), order.end(), 0);
+    max_count = std::min(std::max(min_count, max_count), order.size());
+    std::partial_sort(order.begin(), order.begin() + max_count, order.end(),
+        [&values](std::size_t a, std::size_t b) { return values[a] > values[b]; });
+    if (order.empty()) return order;
+
+    // 誤差が大きいほど、最善の候補に逆転しうる候補が増える
+    double const threshold = values[order[0]] - setting_.margin_sigmas * GetErrorStddev();
+    std::size_t count = std::min(min_count, max_count);
+    while (count < max_count && values[order[count]] >= threshold) ++count;
+    order.resize(count);
+    return order;
+}
+
+void MultiFidelityEvaluator::Observe(double screening, double fine) {
+    double const error = fine - screening;
+    // 観測が少ない間は単純平均とし、初期値に引きずられないようにする
+    double const weight = std::max(setting_.error_decay, 1. / (observations_ + 1));
+    error_mean_ += weight * (error - error_mean_);
+    error_square_mean_ += weight * (error * error - error_square_mean_);
+    observations_++;
+
+    auto const stddev = GetErrorStddev();
+    if (std::isfinite(stddev)) Metrics::GetInstance().screening_error.Set(stddev);
+}
+
+double MultiFidelityEvaluator::GetErrorStddev() const {
+    if (observations_ < setting_.min_observations) return std::numeric_limits<double>::infinity();
+    return std::sqrt(std::max(0., error_square_mean_ - error_mean_ * error_mean_));
+}
+
+} // namespace digitalcurling::client
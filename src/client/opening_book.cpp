@@ -0,0 +1,376 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: Unlicense
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include "digitalcurling/client/async_logger.hpp"
+#include "digitalcurling/client/board_evaluation.hpp"
+#include "digitalcurling/client/metrics.hpp"
+#include "digitalcurling/client/opening_book.hpp"
+#include "digitalcurling/client/profiler.hpp"
+
+namespace digitalcurling::client {
+
+namespace {
+
+constexpr std::uint32_t kMagic = 0x424f4344; // "DCOB"
+constexpr std::uint32_t kVersion = 2;
+
+/// @brief ファイルのヘッダ
+struct FileHeader {
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint64_t entry_count;
+    float sheet_width;
+    std::uint32_t entry_size;
+};
+
+static_assert(sizeof(FileHeader) % alignof(OpeningBookEntry) == 0);
+
+constexpr float kSpin = 1.57f;
+constexpr float kHitSpeed = 3.f;
+
+/// @brief 同じキーとストーン数のエントリが連続するように整列する
+auto GetSortKey(OpeningBookEntry const& entry) {
+    return std::make_tuple(entry.key.Tie(), entry.board.own_count, entry.board.opponent_count, entry.board_hash);
+}
+
+auto GetRangeKey(OpeningBookKey const& key, CanonicalBoard const& board) {
+    return std::make_tuple(key.Tie(), board.own_count, board.opponent_count);
+}
+
+/// @brief 候補ショットを生成する
+std::vector<moves::Shot> GenerateCandidates(simulators::IInvertibleSimulator const& simulator, CompactBoard const& board) {
+    auto const& tee = coordinate::kTee;
+    std::vector<moves::Shot> shots;
+    for (float spin : { -kSpin, kSpin }) {
+        // ハウス内へのドロー
+        for (float dy : { -1.2f, 0.f, 1.2f }) {
+            for (float dx : { -1.2f, -0.6f, 0.f, 0.6f, 1.2f }) {
+                shots.push_back(simulator.CalculateShot(Vector2(tee.x + dx, tee.y + dy), 0.f, spin));
+            }
+        }
+        // ガード
+        for (float dy : { -4.5f, -3.f }) {
+            for (float dx : { -0.6f, 0.f, 0.6f }) {
+                shots.push_back(simulator.CalculateShot(Vector2(tee.x + dx, tee.y + dy), 0.f, spin));
+            }
+        }
+        // 盤面上のストーンへのヒット
+        for (std::size_t i = 0; i < CompactBoard::kStoneCount; ++i) {
+            if (board.HasStone(i)) shots.push_back(simulator.CalculateShot(board.GetPosition(i), kHitSpeed, spin));
+        }
+    }
+    return shots;
+}
+
+} // namespace
+
+// --- OpeningBookKey ---
+OpeningBookKey OpeningBookKey::Create(GameState const& game_state, Team team) {
+    OpeningBookKey key;
+    key.shot = game_state.shot;
+    key.has_hammer = game_state.hammer == team ? 1 : 0;
+    return key;
+}
+
+// --- OpeningBook ---
+OpeningBook::OpeningBook(std::filesystem::path const& path) : file_(path) {
+    FileHeader header;
+    if (file_.GetSize() < sizeof(header)) {
+        throw std::runtime_error("Opening book is corrupted: " + path.string());
+    }
+    std::memcpy(&header, file_.GetData(), sizeof(header));
+    if (header.magic != kMagic || header.version != kVersion || header.entry_size != sizeof(OpeningBookEntry)) {
+        throw std::runtime_error("Unsupported opening book format: " + path.string());
+    }
+    if (file_.GetSize() != sizeof(header) + header.entry_count * sizeof(OpeningBookEntry)) {
+        throw std::runtime_error("Opening book is corrupted: " + path.string());
+    }
+
+    entries_ = reinterpret_cast<OpeningBookEntry const*>(static_cast<char const*>(file_.GetData()) + sizeof(header));
+    entry_count_ = static_cast<std::size_t>(header.entry_count);
+    sheet_width_ = header.sheet_width;
+    metrics_ = &Metrics::GetInstance().GetCache("opening_book");
+}
+
+std::optional<OpeningBookEntry> OpeningBook::Find(OpeningBookKey const& key, CanonicalBoard const& board, float tolerance) const {
+    if (!IsOpen()) return std::nullopt;
+
+    auto const range_key = GetRangeKey(key, board);
+    auto const [first, last] = std::equal_range(entries_, entries_ + entry_count_, range_key,
+        [](auto const& a, auto const& b) {
+            if constexpr (std::is_same_v<std::decay_t<decltype(a)>, OpeningBookEntry>) {
+                return GetRangeKey(a.key, a.board) < b;
+            } else {
+                return a < GetRangeKey(b.key, b.board);
+            }
+        });
+
+    auto const hash = board.GetHash();
+    OpeningBookEntry const* nearest = nullptr;
+    float nearest_distance = tolerance;
+    for (auto it = first; it != last; ++it) {
+        if (it->board_hash == hash && it->board == board) return *it;
+
+        float const distance = it->board.GetDistance(board);
+        if (distance <= nearest_distance) {
+            nearest = it;
+            nearest_distance = distance;
+        }
+    }
+    if (nearest == nullptr) return std::nullopt;
+    return *nearest;
+}
+
+std::optional<OpeningBookEntry> OpeningBook::Find(GameState const& game_state, Team team, float tolerance) const {
+    PROFILE_ZONE("OpeningBook::Find");
+    if (!IsOpen()) return std::nullopt;
+
+    auto const key = OpeningBookKey::Create(game_state, team);
+    auto const board = CanonicalBoard::CreateUnmirrored(CompactBoard::FromStoneCoordinate(game_state.stones), team);
+    auto const mirrored_board = board.Mirror();
+
+    // 左右対称に近い盤面は、わずかな違いで正規化の向きが変わりうるため、両方の向きで検索する
+    auto entry = Find(key, board, tolerance);
+    auto const mirrored = Find(key, mirrored_board, tolerance);
+    if (mirrored.has_value()
+        && (!entry.has_value() || mirrored->board.GetDistance(mirrored_board) < entry->board.GetDistance(board))) {
+        entry = mirrored;
+        auto const shot = MirrorShot(entry->GetShot());
+        entry->angular_velocity = shot.angular_velocity;
+        entry->release_angle = shot.release_angle;
+    }
+    metrics_->Record(entry.has_value());
+    return entry;
+}
+
+// --- OpeningBookBuilder ---
+OpeningBookBuilder::OpeningBookBuilder(
+    GameRule const& game_rule,
+    ISimulationEvaluator& evaluator,
+    simulators::IInvertibleSimulator& simulator
+)
+  : game_rule_(game_rule),
+    evaluator_(evaluator),
+    simulator_(simulator)
+{}
+
+OpeningBookBuilder::SearchResult OpeningBookBuilder::Search(
+    CompactBoard const& board,
+    Team team,
+    std::uint8_t end,
+    std::uint8_t shot,
+    players::IPlayer& player,
+    SearchSetting const& setting
+) const {
+    SearchResult result;
+    result.value = static_cast<float>(SearchValue(board, team, end, shot, player,
+        std::max(setting.depth, 1u), std::max(setting.trials, 1u), std::max(setting.reply_trials, 1u), &result.shot));
+    result.trials = setting.trials;
+    return result;
+}
+
+double OpeningBookBuilder::SearchValue(
+    CompactBoard const& board,
+    Team team,
+    std::uint8_t end,
+    std::uint8_t shot,
+    players::IPlayer& player,
+    std::uint32_t depth,
+    std::uint32_t trials,
+    std::uint32_t reply_trials,
+    moves::Shot* best_shot
+) const {
+    auto const stone_index = board.FindFreeStoneIndex(team);
+    if (!stone_index.has_value()) return GetEndScore(board, team);
+
+    auto const candidates = GenerateCandidates(simulator_, board);
+    // 定跡の作成はターンの外で行うため、アリーナではなくヒープから確保する
+    std::pmr::vector<SimulationJob> jobs;
+    jobs.reserve(candidates.size() * trials);
+    for (auto const& candidate : candidates) {
+        for (std::uint32_t i = 0; i < trials; ++i) {
+            jobs.push_back(SimulationJob::Create(board, stone_index.value(), player.Play(candidate)));
+        }
+    }
+    evaluator_.Evaluate(jobs);
+
+    auto const stones = board.ToStoneCoordinate();
+    std::vector<double> values(candidates.size(), 0.);
+    for (std::size_t k = 0; k < jobs.size(); ++k) {
+        // ルール違反の場合はショット前の盤面に戻る
+        auto result = jobs[k].board;
+        if (game_rule_.VerifyShot(end, team, stones, result.ToStoneCoordinate()).has_value()) {
+            result = board;
+        }
+
+        double const value = depth <= 1
+            ? GetEndScore(result, team)
+            : -SearchValue(result, GetOpponentTeam(team), end, static_cast<std::uint8_t>(shot + 1),
+                player, depth - 1, reply_trials, reply_trials, nullptr);
+        values[k / trials] += value / trials;
+    }
+
+    auto const best = std::max_element(values.begin(), values.end()) - values.begin();
+    if (best_shot != nullptr) *best_shot = candidates[best];
+    return values[best];
+}
+
+// --- OpeningBookWriter ---
+void OpeningBookWriter::Add(OpeningBookKey const& key, CanonicalBoard const& board, OpeningBookBuilder::SearchResult const& result) {
+    OpeningBookEntry entry;
+    entry.board_hash = board.GetHash();
+    entry.translational_velocity = result.shot.translational_velocity;
+    entry.angular_velocity = result.shot.angular_velocity;
+    entry.release_angle = result.shot.release_angle;
+    entry.value = result.value;
+    entry.trials = result.trials;
+    entry.key = key;
+    entry.board = board;
+
+    for (auto& existing : entries_) {
+        if (existing.key == key && existing.board_hash == entry.board_hash && existing.board == board) {
+            if (existing.trials <= entry.trials) existing = entry;
+            return;
+        }
+    }
+    entries_.push_back(entry);
+}
+
+void OpeningBookWriter::Save(std::filesystem::path const& path) const {
+    auto entries = entries_;
+    std::sort(entries.begin(), entries.end(), [](auto const& a, auto const& b) {
+        return GetSortKey(a) < GetSortKey(b);
+    });
+
+    FileHeader header {};
+    header.magic = kMagic;
+    header.version = kVersion;
+    header.entry_count = entries.size();
+    header.sheet_width = sheet_width_;
+    header.entry_size = sizeof(OpeningBookEntry);
+
+    std::error_code ec;
+    if (path.has_parent_path()) std::filesystem::create_directories(path.parent_path(), ec);
+
+    auto temp_path = path;
+    temp_path += ".tmp";
+    {
+        std::ofstream ofs(temp_path, std::ios::binary | std::ios::trunc);
+        ofs.write(reinterpret_cast<char const*>(&header), sizeof(header));
+        ofs.write(reinterpret_cast<char const*>(entries.data()), static_cast<std::streamsize>(entries.size() * sizeof(OpeningBookEntry)));
+        if (!ofs) {
+            throw std::runtime_error("Failed to write " + temp_path.string());
+        }
+    }
+    std::filesystem::rename(temp_path, path, ec);
+    if (ec) {
+        throw std::runtime_error("Failed to write " + path.string() + ": " + ec.message());
+    }
+}
+
+// --- Positions ---
+std::vector<OpeningBookPosition> GetDefaultOpeningBookPositions(GameRuleType rule_type) {
+    std::vector<OpeningBookPosition> positions;
+    if (rule_type == GameRuleType::kMixedDoubles) return positions;
+
+    // ハウスが空の局面 (先攻の1投目)
+    positions.push_back(OpeningBookPosition { CompactBoard(), 0 });
+
+    // 相手のセンターガードが1つある局面 (後攻の1投目)
+    OpeningBookPosition center_guard { CompactBoard(), 1 };
+    center_guard.board.SetStone(8, Vector2(coordinate::kTee.x, coordinate::kTee.y - 3.f));
+    positions.push_back(center_guard);
+
+    return positions;
+}
+
+std::vector<OpeningBookPosition> LoadOpeningBookPositions(std::filesystem::path const& path) {
+    std::ifstream ifs(path);
+    if (!ifs) {
+        throw std::runtime_error("Failed to open " + path.string());
+    }
+
+    std::vector<OpeningBookPosition> positions;
+    try {
+        for (auto const& item : nlohmann::json::parse(ifs)) {
+            OpeningBookPosition position;
+            position.shot = item.at("shot").get<std::uint8_t>();
+            for (auto const& [name, offset] : { std::pair{ "own", 0 }, std::pair{ "opponent", 8 } }) {
+                if (!item.contains(name)) continue;
+                auto const& stones = item.at(name);
+                if (stones.size() > 8) {
+                    throw std::runtime_error(std::string("too many stones in \"") + name + "\"");
+                }
+                for (std::size_t i = 0; i < stones.size(); ++i) {
+                    position.board.SetStone(offset + i, Vector2(stones[i].at(0).get<float>(), stones[i].at(1).get<float>()));
+                }
+            }
+            positions.push_back(position);
+        }
+    } catch (std::exception const& e) {
+        throw std::runtime_error("Failed to load " + path.string() + ": " + e.what());
+    }
+    return positions;
+}
+
+// --- BuildOpeningBook ---
+void BuildOpeningBook(
+    MatchInfo const& match_info,
+    IFactoryCreator& factory_creator,
+    std::vector<OpeningBookPosition> const& positions,
+    std::filesystem::path const& path,
+    OpeningBookBuilder::SearchSetting const& setting
+) {
+    auto const simulator_factory = factory_creator.CreateSimulatorFactory(match_info.simulator);
+    auto simulator = simulator_factory->CreateSimulator();
+    auto invertible = dynamic_cast<simulators::IInvertibleSimulator*>(simulator.get());
+    if (invertible == nullptr) {
+        throw std::runtime_error("Simulator is not invertible simulator.");
+    }
+
+    std::vector<std::unique_ptr<players::IPlayer>> players;
+    for (auto const& player_json : match_info.players) {
+        players.push_back(factory_creator.CreatePlayerFactory(player_json)->CreatePlayer());
+    }
+    if (players.empty()) {
+        throw std::runtime_error("No players in the match.");
+    }
+
+    auto evaluator = CreateSimulationEvaluator(*simulator_factory, match_info.setting.sheet_width);
+    OpeningBookBuilder builder(match_info.rule, *evaluator, *invertible);
+    OpeningBookWriter writer(match_info.setting.sheet_width);
+
+    auto& logger = AsyncLogger::GetInstance();
+    for (std::size_t i = 0; i < positions.size(); ++i) {
+        auto const& position = positions[i];
+        // 投球順は 0, 1, 2, ... の順で、各プレイヤーが2投ずつ行うものとする
+        auto& player = *players[std::min<std::size_t>(position.shot / 4, players.size() - 1)];
+
+        auto const start = std::chrono::steady_clock::now();
+        auto const result = builder.Search(position.board, Team::k0, 0, position.shot, player, setting);
+        logger.Log(LogLevel::kInfo, "book", "Position %zu/%zu (shot %d): value %.3f in %.1f s",
+            i + 1, positions.size(), position.shot, result.value,
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+
+        bool is_mirrored = false;
+        auto const board = CanonicalBoard::Create(position.board, Team::k0, &is_mirrored);
+        auto canonical_result = result;
+        if (is_mirrored) canonical_result.shot = MirrorShot(result.shot);
+        OpeningBookKey key;
+        key.shot = position.shot;
+        key.has_hammer = position.shot % 2 == 1 ? 1 : 0;
+        writer.Add(key, board, canonical_result);
+    }
+
+    writer.Save(path);
+    logger.Log(LogLevel::kInfo, "book", "Saved %zu entries to %s", writer.GetEntryCount(), path.string().c_str());
+}
+
+} // namespace digitalcurling::client
@@ -0,0 +1,89 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: Unlicense
+
+#include <cmath>
+#include "digitalcurling/client/board_evaluation.hpp"
+#include "digitalcurling/client/playout.hpp"
+#include "digitalcurling/client/profiler.hpp"
+#include "digitalcurling/client/turn_arena.hpp"
+
+namespace digitalcurling::client {
+
+namespace {
+
+constexpr float kSpin = 1.57f;
+constexpr float kHitSpeed = 3.f;
+
+} // namespace
+
+std::optional<std::size_t> FindShotStone(CompactBoard const& board) {
+    constexpr float kScoringDistance = kHouseRadius + Stone::kRadius;
+    std::optional<std::size_t> nearest;
+    float nearest_distance = kScoringDistance;
+    for (std::size_t i = 0; i < CompactBoard::kStoneCount; ++i) {
+        if (!board.HasStone(i)) continue;
+        auto const diff = board.GetPosition(i) - coordinate::kTee;
+        float const distance = std::hypot(diff.x, diff.y);
+        if (distance < nearest_distance) {
+            nearest = i;
+            nearest_distance = distance;
+        }
+    }
+    return nearest;
+}
+
+PlayoutRunner::PlayoutRunner(GameRule const& game_rule, ISimulationEvaluator& evaluator, simulators::IInvertibleSimulator& simulator)
+  : game_rule_(game_rule),
+    evaluator_(evaluator),
+    simulator_(simulator),
+    random_(std::random_device{}())
+{}
+
+moves::Shot PlayoutRunner::ChooseShot(CompactBoard const& board, Team team) {
+    auto const& tee = coordinate::kTee;
+    std::uniform_real_distribution<float> unit(0.f, 1.f);
+    float const spin = unit(random_) < 0.5f ? -kSpin : kSpin;
+
+    auto const shot_stone = FindShotStone(board);
+    if (shot_stone.has_value() && shot_stone.value() / 8 != static_cast<std::size_t>(team) && unit(random_) < 0.6f) {
+        return simulator_.CalculateShot(board.GetPosition(shot_stone.value()), kHitSpeed, spin);
+    }
+    if (unit(random_) < 0.2f) {
+        Vector2 const target(tee.x + (unit(random_) - 0.5f) * 1.2f, tee.y - 2.5f - unit(random_));
+        return simulator_.CalculateShot(target, 0.f, spin);
+    }
+    Vector2 const target(tee.x + (unit(random_) - 0.5f) * 2.f, tee.y + (unit(random_) - 0.5f) * 2.f);
+    return simulator_.CalculateShot(target, 0.f, spin);
+}
+
+void PlayoutRunner::Run(
+    std::vector<CompactBoard>& boards,
+    std::vector<Team> const& first_teams,
+    std::uint8_t end,
+    int stones_per_team,
+    PlayerSelector const& select_player
+) {
+    PROFILE_ZONE("PlayoutRunner::Run");
+    auto jobs = MakeArenaVector<SimulationJob>(boards.size());
+    jobs.resize(boards.size());
+    for (int step = 0; step < 2 * stones_per_team; ++step) {
+        int const stone = step / 2;
+        for (std::size_t k = 0; k < boards.size(); ++k) {
+            auto const thrower = step % 2 == 0 ? first_teams[k] : GetOpponentTeam(first_teams[k]);
+            auto& player = select_player(k, thrower, stone);
+            jobs[k] = SimulationJob::Create(boards[k], boards[k].FindFreeStoneIndex(thrower).value(),
+                player.Play(ChooseShot(boards[k], thrower)));
+        }
+        evaluator_.Evaluate(jobs);
+
+        for (std::size_t k = 0; k < boards.size(); ++k) {
+            auto const thrower = step % 2 == 0 ? first_teams[k] : GetOpponentTeam(first_teams[k]);
+            // ルール違反の場合はショット前の盤面に戻る
+            if (!game_rule_.VerifyShot(end, thrower, boards[k].ToStoneCoordinate(), jobs[k].board.ToStoneCoordinate()).has_value()) {
+                boards[k] = jobs[k].board;
+            }
+        }
+    }
+}
+
+} // namespace digitalcurling::client
@@ -0,0 +1,160 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: Unlicense
+
+#include <chrono>
+#include <fstream>
+#include <stdexcept>
+#include <system_error>
+#include <nlohmann/json.hpp>
+#include "digitalcurling/client/position_file.hpp"
+
+namespace digitalcurling::client {
+
+namespace {
+
+constexpr std::uint32_t kMagic = 0x53504344; // "DCPS"
+constexpr std::uint32_t kVersion = 1;
+
+/// @brief ファイルのヘッダ
+struct FileHeader {
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint64_t record_count;
+    std::uint32_t record_size;
+    std::uint32_t reserved;
+};
+
+constexpr std::array<Team, 2> kTeams { Team::k0, Team::k1 };
+
+moves::Shot ParseShot(nlohmann::json const& json) {
+    return moves::Shot(
+        json.at("translational_velocity").get<float>(),
+        json.at("angular_velocity").get<float>(),
+        json.at("release_angle").get<float>()
+    );
+}
+
+AnalysisPosition FromRecord(PositionRecord const& record, GameSetting const& setting) {
+    if (record.team > 1 || record.hammer > 1) {
+        throw std::runtime_error("invalid team");
+    }
+
+    AnalysisPosition position;
+    position.team = static_cast<Team>(record.team);
+    position.game_state = GameState(setting);
+    auto& state = position.game_state;
+    state.end = record.end;
+    state.shot = record.shot;
+    state.hammer = static_cast<Team>(record.hammer);
+    state.stones = record.board.ToStoneCoordinate();
+    for (std::size_t i = 0; i < kTeams.size(); ++i) {
+        if (!state.scores[kTeams[i]].empty()) state.scores[kTeams[i]][0] = record.total_scores[i];
+        state.thinking_time_remaining[kTeams[i]] = std::chrono::milliseconds(record.thinking_time_remaining[i]);
+    }
+    return position;
+}
+
+PositionRecord ToRecord(AnalysisPosition const& position) {
+    auto const& state = position.game_state;
+
+    PositionRecord record;
+    record.board = CompactBoard::FromStoneCoordinate(state.stones);
+    record.end = state.end;
+    record.shot = state.shot;
+    record.team = static_cast<std::uint8_t>(position.team);
+    record.hammer = static_cast<std::uint8_t>(state.hammer);
+    for (std::size_t i = 0; i < kTeams.size(); ++i) {
+        record.total_scores[i] = static_cast<std::uint8_t>(state.GetTotalScore(kTeams[i]));
+        record.thinking_time_remaining[i] = static_cast<std::uint32_t>(state.thinking_time_remaining[kTeams[i]].count());
+    }
+    return record;
+}
+
+} // namespace
+
+std::vector<AnalysisPosition> LoadPositions(std::filesystem::path const& path, GameSetting const& setting) {
+    std::ifstream ifs(path, std::ios::binary);
+    if (!ifs) {
+        throw std::runtime_error("Failed to open " + path.string());
+    }
+
+    FileHeader header {};
+    ifs.read(reinterpret_cast<char*>(&header), sizeof(header));
+    bool const is_binary = ifs.gcount() == sizeof(header) && header.magic == kMagic;
+
+    std::vector<AnalysisPosition> positions;
+    if (is_binary) {
+        if (header.version != kVersion || header.record_size != sizeof(PositionRecord)) {
+            throw std::runtime_error("Unsupported position file format: " + path.string());
+        }
+        if (std::filesystem::file_size(path) != sizeof(header) + header.record_count * sizeof(PositionRecord)) {
+            throw std::runtime_error("Position file is corrupted: " + path.string());
+        }
+
+        std::vector<PositionRecord> records(static_cast<std::size_t>(header.record_count));
+        ifs.read(reinterpret_cast<char*>(records.data()), static_cast<std::streamsize>(records.size() * sizeof(PositionRecord)));
+        if (!ifs) {
+            throw std::runtime_error("Position file is corrupted: " + path.string());
+        }
+
+        positions.reserve(records.size());
+        for (std::size_t i = 0; i < records.size(); ++i) {
+            try {
+                positions.push_back(FromRecord(records[i], setting));
+            } catch (std::exception const& e) {
+                throw std::runtime_error("Failed to load " + path.string() + " (record " + std::to_string(i) + "): " + e.what());
+            }
+            positions.back().id = std::to_string(i);
+        }
+        return positions;
+    }
+
+    ifs.clear();
+    ifs.seekg(0);
+    std::string line;
+    for (std::size_t line_number = 1; std::getline(ifs, line); ++line_number) {
+        if (line.find_first_not_of(" \t\r") == std::string::npos) continue;
+
+        try {
+            auto const json = nlohmann::json::parse(line);
+            AnalysisPosition position;
+            position.id = json.contains("id") ? json.at("id").get<std::string>() : std::to_string(line_number);
+            position.team = json.at("team").get<Team>();
+            if (position.team != Team::k0 && position.team != Team::k1) {
+                throw std::runtime_error("invalid team");
+            }
+            position.game_state = json.at("game_state").get<GameState>();
+            if (json.contains("last_shot") && !json.at("last_shot").is_null()) {
+                position.last_shot = ParseShot(json.at("last_shot"));
+            }
+            positions.push_back(std::move(position));
+        } catch (std::exception const& e) {
+            throw std::runtime_error("Failed to load " + path.string() + " (line " + std::to_string(line_number) + "): " + e.what());
+        }
+    }
+    return positions;
+}
+
+void SavePositions(std::filesystem::path const& path, std::vector<AnalysisPosition> const& positions) {
+    std::vector<PositionRecord> records;
+    records.reserve(positions.size());
+    for (auto const& position : positions) records.push_back(ToRecord(position));
+
+    FileHeader header {};
+    header.magic = kMagic;
+    header.version = kVersion;
+    header.record_count = records.size();
+    header.record_size = sizeof(PositionRecord);
+
+    std::error_code ec;
+    if (path.has_parent_path()) std::filesystem::create_directories(path.parent_path(), ec);
+
+    std::ofstream ofs(path, std::ios::binary | std::ios::trunc);
+    ofs.write(reinterpret_cast<char const*>(&header), sizeof(header));
+    ofs.write(reinterpret_cast<char const*>(records.data()), static_cast<std::streamsize>(records.size() * sizeof(PositionRecord)));
+    if (!ofs) {
+        throw std::runtime_error("Failed to write " + path.string());
+    }
+}
+
+} // namespace digitalcurling::client
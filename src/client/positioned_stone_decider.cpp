@@ -0,0 +1,252 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: Unlicense
+
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <nlohmann/json.hpp>
+#include "digitalcurling/client/async_logger.hpp"
+#include "digitalcurling/client/board_evaluation.hpp"
+#include "digitalcurling/client/metrics.hpp"
+#include "digitalcurling/client/positioned_stone_decider.hpp"
+#include "digitalcurling/client/profiler.hpp"
+#include "digitalcurling/client/thinking_context.hpp"
+
+namespace digitalcurling::client {
+
+namespace {
+
+using Option = PositionedStoneDecider::Option;
+
+constexpr std::array<Option, PositionedStoneDecider::kOptionCount> kOptions {
+    Option::kCenterGuard, Option::kCenterHouse, Option::kPowerPlayLeft, Option::kPowerPlayRight
+};
+
+/// @brief 1エンドに各チームが投げるストーン数
+constexpr int kStonesPerTeam = 5;
+
+/// @brief ティーからセンターガードまでの距離 [m]
+constexpr float kGuardDistance = 2.896f;
+/// @brief ティーからハウス内のストーンまでの距離 [m] (4フィートの後端にストーンの後端を合わせる)
+constexpr float kHouseStoneDistance = 0.465f;
+/// @brief パワープレイのストーンのx座標 (8フィートの外側にストーンの内側を合わせる) [m]
+constexpr float kPowerPlayX = 1.364f;
+
+bool IsPowerPlay(Option option) {
+    return option == Option::kPowerPlayLeft || option == Option::kPowerPlayRight;
+}
+
+} // namespace
+
+PositionedStoneDecider::PositionedStoneDecider(
+    GameRule const& game_rule,
+    GameSetting const& game_setting,
+    ISimulationEvaluator& evaluator,
+    simulators::IInvertibleSimulator& simulator,
+    WinProbabilityTable const& win_probability,
+    std::vector<PlayerPool::Lease> players,
+    std::filesystem::path cache_path,
+    Setting const& setting
+)
+  : game_rule_(game_rule),
+    game_setting_(game_setting),
+    evaluator_(evaluator),
+    simulator_(simulator),
+    win_probability_(win_probability),
+    players_(std::move(players)),
+    cache_path_(std::move(cache_path)),
+    setting_(setting),
+    playout_runner_(game_rule, evaluator, simulator)
+{
+    if (players_.empty()) {
+        throw std::runtime_error("PositionedStoneDecider: no players.");
+    }
+    LoadCache();
+}
+
+CompactBoard PositionedStoneDecider::GetInitialBoard(Option option, Team team) {
+    auto const& tee = coordinate::kTee;
+    auto const own = static_cast<std::size_t>(team) * 8;
+    auto const opponent = static_cast<std::size_t>(GetOpponentTeam(team)) * 8;
+
+    CompactBoard board;
+    switch (option) {
+        case Option::kCenterGuard:
+            board.SetStone(own, Vector2(tee.x, tee.y - kGuardDistance));
+            board.SetStone(opponent, Vector2(tee.x, tee.y + kHouseStoneDistance));
+            break;
+        case Option::kCenterHouse:
+            board.SetStone(own, Vector2(tee.x, tee.y + kHouseStoneDistance));
+            board.SetStone(opponent, Vector2(tee.x, tee.y - kGuardDistance));
+            break;
+        case Option::kPowerPlayLeft:
+        case Option::kPowerPlayRight: {
+            float const x = tee.x + (option == Option::kPowerPlayLeft ? -kPowerPlayX : kPowerPlayX);
+            board.SetStone(own, Vector2(x, tee.y - Stone::kRadius));
+            board.SetStone(opponent, Vector2(x, tee.y - kGuardDistance));
+            break;
+        }
+    }
+    return board;
+}
+
+PositionedStoneDecider::Result PositionedStoneDecider::Decide(GameState const& game_state, Team team, bool power_play_available) {
+    PROFILE_ZONE("PositionedStoneDecider::Decide");
+    auto const situation = WinProbabilityKey::Create(game_state, team, game_setting_.max_end);
+    // パワープレイはエキストラエンドでは選べない
+    power_play_available = power_play_available && situation.ends_remaining > 0;
+
+    CacheKey const cache_key { situation.ends_remaining, situation.score_difference, power_play_available };
+    auto const cached = cache_.find(cache_key);
+    Metrics::GetInstance().GetCache("positioned_stone").Record(cached != cache_.end());
+    if (cached != cache_.end()) {
+        auto result = cached->second;
+        result.from_cache = true;
+        return result;
+    }
+
+    // 右のパワープレイは左のパワープレイをセンターラインについて反転した配置のため、評価値は等しい。
+    // 左のみを評価し、その分のプレイアウトを他の選択肢に回す
+    std::vector<Option> options;
+    for (auto option : kOptions) {
+        if (option == Option::kPowerPlayRight) continue;
+        if (power_play_available || !IsPowerPlay(option)) options.push_back(option);
+    }
+
+    auto const start = std::chrono::steady_clock::now();
+    auto const deadline = GetDeadline(game_state, team);
+    std::optional<DeadlineScope> deadline_scope(std::in_place, evaluator_, deadline);
+
+    std::vector<double> totals(options.size(), 0.);
+    std::uint32_t playouts = 0;
+    auto const batch = std::max(1u, setting_.batch_playouts);
+    do {
+        // 全ての選択肢のプレイアウトをまとめて進める
+        std::vector<CompactBoard> boards;
+        std::vector<Team> first_teams;
+        boards.reserve(options.size() * batch);
+        first_teams.reserve(options.size() * batch);
+        for (auto option : options) {
+            auto const first_team = HasHammer(option) ? GetOpponentTeam(team) : team;
+            for (std::uint32_t i = 0; i < batch; ++i) {
+                boards.push_back(GetInitialBoard(option, team));
+                first_teams.push_back(first_team);
+            }
+        }
+        // 各チームの1投目と5投目を1人目、それ以外を2人目が投げる (相手も同じプレイヤーとする)
+        playout_runner_.Run(boards, first_teams, game_state.end, kStonesPerTeam,
+            [this](std::size_t, Team, int stone) -> players::IPlayer& {
+                return *players_[stone == 0 || stone == kStonesPerTeam - 1 ? 0 : players_.size() - 1];
+            });
+
+        for (std::size_t k = 0; k < boards.size(); ++k) {
+            auto key = situation;
+            key.has_hammer = HasHammer(options[k / batch]) ? 1 : 0;
+            totals[k / batch] += win_probability_.IsOpen()
+                ? win_probability_.GetAfterEnd(key, GetEndScore(boards[k], team))
+                : GetEndScore(boards[k], team);
+        }
+        playouts += batch;
+    } while (playouts < setting_.max_playouts && std::chrono::steady_clock::now() < deadline
+        && !ThinkingContext::IsCurrentCancelled());
+
+    deadline_scope.reset();
+    // 取り消された評価を含む結果はキャッシュしない
+    bool const is_cancelled = ThinkingContext::IsCurrentCancelled();
+
+    Result result;
+    result.values.fill(-1.f);
+    result.playouts = playouts;
+    for (std::size_t i = 0; i < options.size(); ++i) {
+        auto const value = static_cast<float>(totals[i] / playouts);
+        result.values[static_cast<std::size_t>(options[i])] = value;
+        if (i == 0 || value > result.values[static_cast<std::size_t>(result.option)]) result.option = options[i];
+    }
+    if (power_play_available) {
+        result.values[static_cast<std::size_t>(Option::kPowerPlayRight)] = result.values[static_cast<std::size_t>(Option::kPowerPlayLeft)];
+    }
+
+    AsyncLogger::GetInstance().Log(LogLevel::kInfo, "positioned",
+        "%s (guard %.3f, house %.3f, pp_left %.3f, pp_right %.3f) with %u playouts in %.1f ms",
+        nlohmann::json(result.option).get<std::string>().c_str(),
+        result.values[0], result.values[1], result.values[2], result.values[3], playouts,
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+
+    if (!is_cancelled && playouts >= setting_.min_cached_playouts) {
+        cache_[cache_key] = result;
+        try {
+            SaveCache();
+        } catch (std::exception const& e) {
+            AsyncLogger::GetInstance().Log(LogLevel::kWarning, "positioned", "%s", e.what());
+        }
+    }
+    return result;
+}
+
+std::chrono::steady_clock::time_point PositionedStoneDecider::GetDeadline(GameState const& game_state, Team team) const {
+    auto const ends_remaining = std::max(1, static_cast<int>(game_setting_.max_end) - static_cast<int>(game_state.end));
+    auto const remaining = std::chrono::duration<double, std::milli>(game_state.thinking_time_remaining[team]);
+    auto const budget = std::chrono::duration_cast<std::chrono::milliseconds>(remaining * setting_.time_fraction / ends_remaining);
+    return std::chrono::steady_clock::now() + std::clamp(budget, std::chrono::milliseconds(0), setting_.max_time);
+}
+
+void PositionedStoneDecider::LoadCache() {
+    std::error_code ec;
+    if (cache_path_.empty() || !std::filesystem::exists(cache_path_, ec)) return;
+
+    try {
+        std::ifstream ifs(cache_path_);
+        auto const json = nlohmann::json::parse(ifs);
+        for (auto const& item : json) {
+            Result result;
+            result.option = item.at("option").get<Option>();
+            result.values = item.at("values").get<std::array<float, kOptionCount>>();
+            result.playouts = item.at("playouts").get<std::uint32_t>();
+            cache_[CacheKey {
+                item.at("ends_remaining").get<int>(),
+                item.at("score_difference").get<int>(),
+                item.at("power_play_available").get<bool>()
+            }] = result;
+        }
+    } catch (std::exception const& e) {
+        AsyncLogger::GetInstance().Log(LogLevel::kWarning, "positioned",
+            "Ignoring the cache %s: %s", cache_path_.string().c_str(), e.what());
+        cache_.clear();
+    }
+}
+
+void PositionedStoneDecider::SaveCache() const {
+    if (cache_path_.empty()) return;
+
+    auto json = nlohmann::json::array();
+    for (auto const& [key, result] : cache_) {
+        json.push_back({
+            { "ends_remaining", std::get<0>(key) },
+            { "score_difference", std::get<1>(key) },
+            { "power_play_available", std::get<2>(key) },
+            { "option", result.option },
+            { "values", result.values },
+            { "playouts", result.playouts }
+        });
+    }
+
+    std::error_code ec;
+    if (cache_path_.has_parent_path()) std::filesystem::create_directories(cache_path_.parent_path(), ec);
+
+    auto temp_path = cache_path_;
+    temp_path += ".tmp";
+    {
+        std::ofstream ofs(temp_path, std::ios::trunc);
+        ofs << json.dump(2);
+        if (!ofs) {
+            throw std::runtime_error("Failed to write " + temp_path.string());
+        }
+    }
+    std::filesystem::rename(temp_path, cache_path_, ec);
+    if (ec) {
+        throw std::runtime_error("Failed to write " + cache_path_.string() + ": " + ec.message());
+    }
+}
+
+} // namespace digitalcurling::client
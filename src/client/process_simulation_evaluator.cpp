@@ -0,0 +1,490 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: Unlicense
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include "digitalcurling/client/async_logger.hpp"
+#include "digitalcurling/client/process_simulation_evaluator.hpp"
+#include "digitalcurling/client/profiler.hpp"
+#include "digitalcurling/client/thinking_context.hpp"
+
+#ifdef __linux__
+    #include <cerrno>
+    #include <csignal>
+    #include <ctime>
+    #include <fcntl.h>
+    #include <semaphore.h>
+    #include <sys/mman.h>
+    #include <sys/prctl.h>
+    #include <sys/wait.h>
+    #include <unistd.h>
+#endif
+
+namespace digitalcurling::client {
+
+#ifdef __linux__
+
+namespace {
+
+constexpr std::uint32_t kMagic = 0x44435357; // "DCSW"
+constexpr std::size_t kSlotCount = 4096;
+// ワーカーのクラッシュによる再投入の分の空きを残しておく
+constexpr std::size_t kMaxBatchSize = kSlotCount / 2;
+constexpr std::size_t kSimulatorJsonSize = 4096;
+constexpr int kMaxAttempts = 3;
+constexpr auto kPollInterval = std::chrono::milliseconds(50);
+constexpr auto kShutdownTimeout = std::chrono::seconds(1);
+// 処理中のジョブがこの時間完了しない場合は、ワーカーが応答しないとみなして停止させる
+constexpr auto kBatchTimeout = std::chrono::seconds(10);
+// 期限を過ぎた後は応答を待つ時間を短くする
+constexpr auto kDeadlineBatchTimeout = std::chrono::milliseconds(200);
+constexpr std::uint64_t kCollected = ~std::uint64_t(0);
+
+/// @brief スロットの状態 (`kRunning` はワーカーのインデックスとの論理和で表す)
+enum SlotState : std::uint32_t {
+    kFree = 0,
+    kPending = 1,
+    kDone = 2,
+    kAbandoned = 3,
+    kRunning = 0x100,
+};
+
+int WaitSemaphore(sem_t* semaphore, std::chrono::milliseconds timeout) {
+    timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    auto const nsec = deadline.tv_nsec + std::chrono::nanoseconds(timeout).count();
+    deadline.tv_sec += static_cast<time_t>(nsec / 1'000'000'000);
+    deadline.tv_nsec = static_cast<long>(nsec % 1'000'000'000);
+    return sem_timedwait(semaphore, &deadline);
+}
+
+} // namespace
+
+struct ProcessSimulationEvaluator::SharedMemory {
+    struct Slot {
+        std::atomic<std::uint32_t> state;
+        std::uint32_t batch_index;
+        /// @brief 投入した位置 (親プロセスのみが書き込む)
+        std::uint64_t position;
+        SimulationJob job;
+    };
+
+    std::uint32_t magic;
+    float sheet_width;
+    char simulator_json[kSimulatorJsonSize];
+
+    std::atomic<bool> is_shutdown;
+    /// @brief 次にワーカーが取り出す位置 (`publish_position` を超えない)
+    std::atomic<std::uint64_t> claim_position;
+    /// @brief 親プロセスが次にジョブを追加する位置 (親プロセスのみが書き込む)
+    std::atomic<std::uint64_t> publish_position;
+    /// @brief 次にワーカーが完了を通知する位置
+    std::atomic<std::uint64_t> done_write_position;
+    /// @brief 親プロセスが次に完了の通知を読む位置 (親プロセスのみが使用する)
+    std::uint64_t done_read_position;
+    sem_t jobs_available;
+    sem_t jobs_done;
+
+    Slot slots[kSlotCount];
+    /// @brief 完了したジョブの位置 + 1 (読み終えたものと書き込み中のものは0)
+    std::atomic<std::uint64_t> done_queue[kSlotCount];
+
+    static_assert(std::atomic<std::uint32_t>::is_always_lock_free);
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free);
+};
+
+ProcessSimulationEvaluator::ProcessSimulationEvaluator(
+    nlohmann::json const& simulator_json,
+    float sheet_width,
+    std::size_t worker_count,
+    std::vector<std::string> worker_arguments
+)
+  : worker_arguments_(std::move(worker_arguments)),
+    worker_pids_(worker_count, -1)
+{
+    if (worker_count == 0) {
+        throw std::runtime_error("ProcessSimulationEvaluator: worker_count must be positive.");
+    }
+    auto const json_text = simulator_json.dump();
+    if (json_text.size() >= kSimulatorJsonSize) {
+        throw std::runtime_error("ProcessSimulationEvaluator: simulator json is too large.");
+    }
+
+    static std::atomic<unsigned> instance_count = 0;
+    shm_name_ = "/digitalcurling-client-" + std::to_string(getpid()) + "-" + std::to_string(instance_count++);
+
+    int fd = shm_open(shm_name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) {
+        throw std::runtime_error("ProcessSimulationEvaluator: shm_open failed: " + std::string(std::strerror(errno)));
+    }
+    if (ftruncate(fd, sizeof(SharedMemory)) != 0) {
+        close(fd);
+        shm_unlink(shm_name_.c_str());
+        throw std::runtime_error("ProcessSimulationEvaluator: ftruncate failed: " + std::string(std::strerror(errno)));
+    }
+    void* address = mmap(nullptr, sizeof(SharedMemory), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (address == MAP_FAILED) {
+        shm_unlink(shm_name_.c_str());
+        throw std::runtime_error("ProcessSimulationEvaluator: mmap failed: " + std::string(std::strerror(errno)));
+    }
+
+    shared_ = new (address) SharedMemory();
+    shared_->magic = kMagic;
+    shared_->sheet_width = sheet_width;
+    std::memcpy(shared_->simulator_json, json_text.c_str(), json_text.size() + 1);
+    shared_->is_shutdown = false;
+    shared_->claim_position = 0;
+    shared_->publish_position = 0;
+    shared_->done_write_position = 0;
+    shared_->done_read_position = 0;
+    sem_init(&shared_->jobs_available, 1, 0);
+    sem_init(&shared_->jobs_done, 1, 0);
+    for (auto& slot : shared_->slots) slot.state = kFree;
+    for (auto& entry : shared_->done_queue) entry = 0;
+
+    for (std::size_t i = 0; i < worker_count; ++i) StartWorker(i);
+}
+
+ProcessSimulationEvaluator::~ProcessSimulationEvaluator() {
+    shared_->is_shutdown = true;
+    for (std::size_t i = 0; i < worker_pids_.size(); ++i) sem_post(&shared_->jobs_available);
+
+    auto const deadline = std::chrono::steady_clock::now() + kShutdownTimeout;
+    for (auto pid : worker_pids_) {
+        if (pid <= 0) continue;
+        while (waitpid(pid, nullptr, WNOHANG) == 0) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                kill(pid, SIGKILL);
+                waitpid(pid, nullptr, 0);
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    }
+
+    sem_destroy(&shared_->jobs_available);
+    sem_destroy(&shared_->jobs_done);
+    shared_->~SharedMemory();
+    munmap(shared_, sizeof(SharedMemory));
+    shm_unlink(shm_name_.c_str());
+}
+
+void ProcessSimulationEvaluator::StartWorker(std::size_t worker_index) {
+    // fork 後はメモリ確保を避けるため、引数は先に用意しておく
+    std::vector<std::string> arguments {
+        "/proc/self/exe",
+        "--simulation-worker", shm_name_,
+        "--simulation-worker-index", std::to_string(worker_index)
+    };
+    arguments.insert(arguments.end(), worker_arguments_.begin(), worker_arguments_.end());
+    std::vector<char*> argv;
+    for (auto& argument : arguments) argv.push_back(argument.data());
+    argv.push_back(nullptr);
+
+    auto const parent_pid = getpid();
+    auto const pid = fork();
+    if (pid < 0) {
+        throw std::runtime_error("ProcessSimulationEvaluator: fork failed: " + std::string(std::strerror(errno)));
+    }
+    if (pid == 0) {
+        // 親プロセスが終了した場合はワーカーも終了させる
+        prctl(PR_SET_PDEATHSIG, SIGKILL);
+        if (getppid() != parent_pid) _exit(1);
+        execv(argv[0], argv.data());
+        _exit(127);
+    }
+    worker_pids_[worker_index] = pid;
+}
+
+std::vector<std::size_t> ProcessSimulationEvaluator::CollectCrashedWorkers() {
+    std::vector<std::size_t> crashed;
+    for (std::size_t i = 0; i < worker_pids_.size(); ++i) {
+        int status = 0;
+        if (waitpid(worker_pids_[i], &status, WNOHANG) != worker_pids_[i]) continue;
+
+        AsyncLogger::GetInstance().Log(LogLevel::kWarning, "worker",
+            "Simulation worker %zu exited (%s %d). Restarting.", i,
+            WIFSIGNALED(status) ? "signal" : "status",
+            WIFSIGNALED(status) ? WTERMSIG(status) : WEXITSTATUS(status));
+        crashed.push_back(i);
+    }
+    return crashed;
+}
+
+void ProcessSimulationEvaluator::SetDeadline(std::optional<std::chrono::steady_clock::time_point> deadline) {
+    deadline_.store(deadline.has_value() ? deadline->time_since_epoch().count() : kNoDeadline, std::memory_order_relaxed);
+}
+
+void ProcessSimulationEvaluator::Evaluate(std::pmr::vector<SimulationJob>& jobs) {
+    PROFILE_ZONE("ProcessSimulationEvaluator::Evaluate");
+    using Clock = std::chrono::steady_clock;
+    std::lock_guard lock(mutex_);
+    auto const* const context = ThinkingContext::GetCurrent();
+    bool is_cancelled = false;
+
+    for (std::size_t batch_start = 0; batch_start < jobs.size() && !is_cancelled; batch_start += kMaxBatchSize) {
+        auto const batch_size = std::min(kMaxBatchSize, jobs.size() - batch_start);
+        auto* const batch = jobs.data() + batch_start;
+
+        // ジョブごとに最後に投入した位置 (回収済みなら kCollected)
+        std::vector<std::uint64_t> positions(batch_size, kCollected);
+        std::vector<int> attempts(batch_size, 0);
+        std::size_t remaining = batch_size;
+
+        auto publish = [&](std::uint32_t batch_index) {
+            if (++attempts[batch_index] > kMaxAttempts) {
+                throw std::runtime_error("ProcessSimulationEvaluator: simulation job crashed workers repeatedly.");
+            }
+            auto const position = shared_->publish_position.load(std::memory_order_relaxed);
+            auto& slot = shared_->slots[position % kSlotCount];
+            slot.batch_index = batch_index;
+            slot.position = position;
+            slot.job = batch[batch_index];
+            slot.state.store(kPending, std::memory_order_release);
+            shared_->publish_position.store(position + 1, std::memory_order_release);
+            positions[batch_index] = position;
+            sem_post(&shared_->jobs_available);
+        };
+
+        // 完了したジョブの結果を回収する (再投入前の位置や重複した通知は無視する)
+        auto collect = [&](std::uint64_t position) {
+            auto& slot = shared_->slots[position % kSlotCount];
+            if (slot.state.load(std::memory_order_acquire) != kDone || slot.position != position) return false;
+            if (slot.batch_index >= batch_size || positions[slot.batch_index] != position) return false;
+            batch[slot.batch_index].board = slot.job.board;
+            positions[slot.batch_index] = kCollected;
+            slot.state.store(kFree, std::memory_order_relaxed);
+            remaining--;
+            return true;
+        };
+
+        for (std::uint32_t i = 0; i < batch_size; ++i) publish(i);
+
+        // ジョブが完了しないまま再起動を繰り返す場合 (起動に失敗するなど) は諦める
+        std::size_t restarts_without_progress = 0;
+        auto last_progress = Clock::now();
+        while (remaining > 0) {
+            bool const is_notified = WaitSemaphore(&shared_->jobs_done, kPollInterval) == 0;
+
+            // 完了の通知を順に読む
+            bool is_progressed = false;
+            while (shared_->done_read_position < shared_->done_write_position.load(std::memory_order_acquire)) {
+                auto& entry = shared_->done_queue[shared_->done_read_position % kSlotCount];
+                auto const value = entry.exchange(0, std::memory_order_acquire);
+                if (value == 0) break; // 書き込み中
+                shared_->done_read_position++;
+                is_progressed |= collect(value - 1);
+            }
+
+            // 通知が途絶えた場合は、通知の書き込み中に終了したワーカーがいても進めるよう、全てのジョブを確かめる
+            if (!is_notified) {
+                shared_->done_read_position = shared_->done_write_position.load(std::memory_order_acquire);
+                for (auto position : positions) {
+                    if (position != kCollected) is_progressed |= collect(position);
+                }
+            }
+
+            // 思考が取り消された場合は、まだ取り出されていないジョブを破棄し、処理中のジョブの完了のみを待つ
+            // (処理中のスロットはワーカーが書き込んでいるため、再利用されないよう回収まで待つ)
+            if (!is_cancelled && context != nullptr && context->IsCancelled()) {
+                is_cancelled = true;
+                for (std::uint32_t i = 0; i < batch_size; ++i) {
+                    if (positions[i] == kCollected) continue;
+                    std::uint32_t expected = kPending;
+                    if (shared_->slots[positions[i] % kSlotCount].state.compare_exchange_strong(expected, kAbandoned)) {
+                        positions[i] = kCollected;
+                        remaining--;
+                    }
+                }
+            }
+
+            auto const now = Clock::now();
+            if (is_progressed) {
+                restarts_without_progress = 0;
+                last_progress = now;
+            }
+
+            // 処理中のジョブが完了しないワーカーは停止させ、クラッシュと同様に再起動してジョブを再投入する
+            auto const deadline = deadline_.load(std::memory_order_relaxed);
+            auto const timeout = deadline != kNoDeadline && now.time_since_epoch().count() >= deadline
+                ? std::chrono::duration_cast<Clock::duration>(kDeadlineBatchTimeout)
+                : std::chrono::duration_cast<Clock::duration>(kBatchTimeout);
+            if (remaining > 0 && now - last_progress >= timeout) {
+                std::vector<bool> is_killed(worker_pids_.size(), false);
+                for (auto position : positions) {
+                    if (position == kCollected) continue;
+                    auto const state = shared_->slots[position % kSlotCount].state.load(std::memory_order_acquire);
+                    if ((state & kRunning) == 0) continue;
+                    auto const worker_index = static_cast<std::size_t>(state & ~kRunning);
+                    if (worker_index >= worker_pids_.size() || is_killed[worker_index]) continue;
+
+                    AsyncLogger::GetInstance().Log(LogLevel::kWarning, "worker",
+                        "Simulation worker %zu did not finish a job in %lld ms. Killing.", worker_index,
+                        static_cast<long long>(std::chrono::duration_cast<std::chrono::milliseconds>(now - last_progress).count()));
+                    kill(worker_pids_[worker_index], SIGKILL);
+                    is_killed[worker_index] = true;
+                }
+                // 取り出されないまま残ったジョブのために通知を補う (余分な通知は読み捨てられる)
+                for (std::size_t i = 0; i < worker_pids_.size(); ++i) sem_post(&shared_->jobs_available);
+                last_progress = now;
+            }
+
+            // クラッシュしたワーカーが処理中だったジョブを破棄して再投入し、ワーカーを再起動する
+            for (auto worker_index : CollectCrashedWorkers()) {
+                if (++restarts_without_progress > kMaxAttempts * worker_pids_.size()) {
+                    throw std::runtime_error("ProcessSimulationEvaluator: simulation workers keep exiting.");
+                }
+                auto const running = kRunning | static_cast<std::uint32_t>(worker_index);
+                auto const claimed = shared_->claim_position.load(std::memory_order_acquire);
+                std::vector<std::uint32_t> lost;
+                for (std::uint32_t i = 0; i < batch_size; ++i) {
+                    if (positions[i] == kCollected) continue;
+                    auto& slot = shared_->slots[positions[i] % kSlotCount];
+                    auto state = slot.state.load(std::memory_order_acquire);
+                    // 取り出した直後にクラッシュした場合は Pending のまま残る
+                    bool const is_lost = state == running || (state == kPending && positions[i] < claimed);
+                    if (is_lost && slot.state.compare_exchange_strong(state, kAbandoned)) {
+                        lost.push_back(i);
+                    }
+                }
+
+                StartWorker(worker_index);
+                // 通知を受け取ってから取り出すまでの間にクラッシュした場合、その通知は失われている
+                sem_post(&shared_->jobs_available);
+                for (auto batch_index : lost) {
+                    if (is_cancelled) {
+                        positions[batch_index] = kCollected;
+                        remaining--;
+                    } else {
+                        publish(batch_index);
+                    }
+                }
+            }
+        }
+    }
+}
+
+int ProcessSimulationEvaluator::RunWorker(std::string const& shm_name, std::size_t worker_index, FactoryCreator const& create_factory) {
+    std::unique_ptr<simulators::ISimulator> simulator;
+    float sheet_width = 0.f;
+    return RunWorker(shm_name, worker_index, [&](nlohmann::json const& simulator_json, float width) {
+        simulator = create_factory(simulator_json)->CreateSimulator();
+        sheet_width = width;
+    }, [&](SimulationJob& job) {
+        RunSimulationJob(*simulator, job, sheet_width);
+    });
+}
+
+int ProcessSimulationEvaluator::RunWorker(std::string const& shm_name, std::size_t worker_index, JobRunner const& run_job) {
+    return RunWorker(shm_name, worker_index, [](nlohmann::json const&, float) {}, run_job);
+}
+
+int ProcessSimulationEvaluator::RunWorker(
+    std::string const& shm_name,
+    std::size_t worker_index,
+    std::function<void(nlohmann::json const&, float)> const& initialize,
+    JobRunner const& run_job
+) {
+    int fd = shm_open(shm_name.c_str(), O_RDWR, 0);
+    if (fd < 0) {
+        std::cerr << "[Error] Simulation worker: shm_open failed: " << std::strerror(errno) << std::endl;
+        return 1;
+    }
+    void* address = mmap(nullptr, sizeof(SharedMemory), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (address == MAP_FAILED) {
+        std::cerr << "[Error] Simulation worker: mmap failed: " << std::strerror(errno) << std::endl;
+        return 1;
+    }
+    auto* shared = static_cast<SharedMemory*>(address);
+    if (shared->magic != kMagic) {
+        std::cerr << "[Error] Simulation worker: invalid shared memory." << std::endl;
+        return 1;
+    }
+
+    auto const running = kRunning | static_cast<std::uint32_t>(worker_index);
+    try {
+        initialize(nlohmann::json::parse(shared->simulator_json), shared->sheet_width);
+
+        while (true) {
+            if (sem_wait(&shared->jobs_available) != 0) {
+                if (errno == EINTR) continue;
+                throw std::runtime_error("sem_wait failed: " + std::string(std::strerror(errno)));
+            }
+            if (shared->is_shutdown.load()) break;
+
+            // 補われた通知では取り出すジョブがないことがある
+            auto position = shared->claim_position.load(std::memory_order_acquire);
+            bool is_claimed = false;
+            while (position < shared->publish_position.load(std::memory_order_acquire)) {
+                if (shared->claim_position.compare_exchange_weak(position, position + 1, std::memory_order_acq_rel)) {
+                    is_claimed = true;
+                    break;
+                }
+            }
+            if (!is_claimed) continue;
+
+            auto& slot = shared->slots[position % kSlotCount];
+            std::uint32_t expected = kPending;
+            if (!slot.state.compare_exchange_strong(expected, running, std::memory_order_acquire)) continue;
+            // 完了後は親プロセスがスロットを再利用するため、先に位置を読んでおく
+            auto const slot_position = slot.position;
+
+            run_job(slot.job);
+
+            expected = running;
+            if (slot.state.compare_exchange_strong(expected, kDone, std::memory_order_release)) {
+                auto const done_position = shared->done_write_position.fetch_add(1, std::memory_order_acq_rel);
+                shared->done_queue[done_position % kSlotCount].store(slot_position + 1, std::memory_order_release);
+                sem_post(&shared->jobs_done);
+            }
+        }
+    } catch (std::exception const& e) {
+        std::cerr << "[Error] Simulation worker " << worker_index << ": " << e.what() << std::endl;
+        munmap(address, sizeof(SharedMemory));
+        return 1;
+    }
+
+    munmap(address, sizeof(SharedMemory));
+    return 0;
+}
+
+#else // __linux__
+
+struct ProcessSimulationEvaluator::SharedMemory {};
+
+ProcessSimulationEvaluator::ProcessSimulationEvaluator(nlohmann::json const&, float, std::size_t, std::vector<std::string>) {
+    throw std::runtime_error("ProcessSimulationEvaluator: worker processes are not supported on this platform.");
+}
+
+ProcessSimulationEvaluator::~ProcessSimulationEvaluator() = default;
+
+void ProcessSimulationEvaluator::SetDeadline(std::optional<std::chrono::steady_clock::time_point>) {}
+
+void ProcessSimulationEvaluator::Evaluate(std::pmr::vector<SimulationJob>&) {}
+
+void ProcessSimulationEvaluator::StartWorker(std::size_t) {}
+
+std::vector<std::size_t> ProcessSimulationEvaluator::CollectCrashedWorkers() {
+    return {};
+}
+
+int ProcessSimulationEvaluator::RunWorker(std::string const&, std::size_t, FactoryCreator const&) {
+    std::cerr << "[Error] Simulation workers are not supported on this platform." << std::endl;
+    return 1;
+}
+
+int ProcessSimulationEvaluator::RunWorker(std::string const&, std::size_t, JobRunner const&) {
+    std::cerr << "[Error] Simulation workers are not supported on this platform." << std::endl;
+    return 1;
+}
+
+#endif // __linux__
+
+} // namespace digitalcurling::client
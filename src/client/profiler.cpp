@@ -0,0 +1,297 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: Unlicense
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+#include "digitalcurling/client/profiler.hpp"
+
+#ifdef __linux__
+    #include <linux/perf_event.h>
+    #include <sys/ioctl.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
+namespace digitalcurling::client {
+
+namespace {
+
+using Counters = std::array<std::uint64_t, Profiler::kCounterCount>;
+
+constexpr std::array<char const*, Profiler::kCounterCount> kCounterNames {{ "cycles", "cache_misses", "branch_misses" }};
+
+/// @brief 1チャンクあたりのイベント数
+constexpr std::size_t kChunkSize = 1024;
+/// @brief 1スレッドあたりのチャンク数の上限
+constexpr std::size_t kMaxChunks = 256;
+
+struct ProfileEvent {
+    char const* name;
+    std::int64_t start;
+    std::int64_t duration;
+    Counters counters;
+    bool has_counters;
+};
+
+/// @brief スレッドごとのイベントのバッファ
+///
+/// 書き込みは所有するスレッドのみが行い、`size` の更新で読み出し側に公開する。
+/// チャンクは追加のみ行うため、公開済みのイベントは書き出し中に移動しない。
+struct ThreadBuffer {
+    std::uint32_t thread_id = 0;
+    std::atomic<char const*> thread_name = nullptr;
+    std::array<std::unique_ptr<ProfileEvent[]>, kMaxChunks> chunks;
+    std::atomic<std::size_t> size = 0;
+    std::atomic<std::uint64_t> dropped = 0;
+
+    void Push(ProfileEvent const& event) {
+        auto const index = size.load(std::memory_order_relaxed);
+        if (index >= kChunkSize * kMaxChunks) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        auto& chunk = chunks[index / kChunkSize];
+        if (chunk == nullptr) chunk = std::make_unique<ProfileEvent[]>(kChunkSize);
+        chunk[index % kChunkSize] = event;
+        size.store(index + 1, std::memory_order_release);
+    }
+};
+
+struct ProfilerRegistry {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    std::atomic<bool> enabled = false;
+    std::atomic<bool> hardware_counters = false;
+    std::chrono::steady_clock::time_point const epoch = std::chrono::steady_clock::now();
+
+    static ProfilerRegistry& GetInstance() {
+        static ProfilerRegistry instance;
+        return instance;
+    }
+};
+
+/// @brief スレッドのハードウェアカウンター
+class HardwareCounters {
+public:
+    HardwareCounters() = default;
+    HardwareCounters(HardwareCounters const&) = delete;
+    HardwareCounters& operator=(HardwareCounters const&) = delete;
+
+    ~HardwareCounters() {
+#ifdef __linux__
+        for (int fd : fds_) {
+            if (fd >= 0) close(fd);
+        }
+#endif
+    }
+
+    /// @brief カウンターの値を読み取る
+    /// @param[out] counters 値
+    /// @return 読み取れたなら `true`
+    bool Read(Counters& counters) {
+#ifdef __linux__
+        if (!opened_) Open();
+        if (fds_[0] < 0) return false;
+
+        // PERF_FORMAT_GROUP の読み取り結果 (イベント数、各イベントの値)
+        std::array<std::uint64_t, 1 + Profiler::kCounterCount> values {};
+        auto const bytes = read(fds_[0], values.data(), sizeof(values));
+        if (bytes != static_cast<ssize_t>(sizeof(values)) || values[0] != Profiler::kCounterCount) return false;
+        for (std::size_t i = 0; i < Profiler::kCounterCount; ++i) counters[i] = values[1 + i];
+        return true;
+#else
+        return false;
+#endif
+    }
+
+private:
+    bool opened_ = false;
+    std::array<int, Profiler::kCounterCount> fds_ {{ -1, -1, -1 }};
+
+#ifdef __linux__
+    void Open() {
+        opened_ = true;
+        constexpr std::array<std::uint64_t, Profiler::kCounterCount> kConfigs {{
+            PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES
+        }};
+
+        for (std::size_t i = 0; i < kConfigs.size(); ++i) {
+            perf_event_attr attr {};
+            attr.size = sizeof(attr);
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = kConfigs[i];
+            attr.disabled = i == 0 ? 1 : 0;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_GROUP;
+
+            // 呼び出したスレッドのみを計測し、最初のカウンターをグループのリーダーとする
+            int const fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, i == 0 ? -1 : fds_[0], 0));
+            if (fd < 0) {
+                // 権限がない場合など。一部のカウンターのみでは記録しない
+                for (std::size_t j = 0; j < i; ++j) close(fds_[j]);
+                fds_.fill(-1);
+                return;
+            }
+            fds_[i] = fd;
+        }
+        ioctl(fds_[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+#endif
+};
+
+struct LocalProfiler {
+    std::shared_ptr<ThreadBuffer> buffer;
+    std::unique_ptr<HardwareCounters> counters;
+
+    ThreadBuffer& GetBuffer() {
+        if (buffer == nullptr) {
+            auto& registry = ProfilerRegistry::GetInstance();
+            std::lock_guard lock(registry.mutex);
+            buffer = std::make_shared<ThreadBuffer>();
+            buffer->thread_id = static_cast<std::uint32_t>(registry.buffers.size() + 1);
+            registry.buffers.push_back(buffer);
+        }
+        return *buffer;
+    }
+};
+
+thread_local LocalProfiler local_profiler;
+
+std::int64_t GetTimestamp() {
+    auto const elapsed = std::chrono::steady_clock::now() - ProfilerRegistry::GetInstance().epoch;
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+}
+
+/// @brief JSONの文字列として出力できない文字を置き換える
+void WriteJsonString(std::ostream& os, char const* str) {
+    os << '"';
+    for (char const* c = str; *c != '\0'; ++c) {
+        if (*c == '"' || *c == '\\') {
+            os << '\\' << *c;
+        } else if (static_cast<unsigned char>(*c) < 0x20) {
+            os << ' ';
+        } else {
+            os << *c;
+        }
+    }
+    os << '"';
+}
+
+} // namespace
+
+void Profiler::Start(bool hardware_counters) {
+    auto& registry = ProfilerRegistry::GetInstance();
+    registry.hardware_counters.store(hardware_counters, std::memory_order_relaxed);
+    registry.enabled.store(true, std::memory_order_release);
+}
+
+bool Profiler::IsEnabled() {
+    return ProfilerRegistry::GetInstance().enabled.load(std::memory_order_relaxed);
+}
+
+void Profiler::SetThreadName(char const* name) {
+    // 記録しない場合にバッファを作らないよう、記録の開始後にのみ設定する
+    if (!IsEnabled()) return;
+    local_profiler.GetBuffer().thread_name.store(name, std::memory_order_relaxed);
+}
+
+bool Profiler::BeginZone(std::int64_t& start, Counters& counters) {
+    bool has_counters = false;
+    if (ProfilerRegistry::GetInstance().hardware_counters.load(std::memory_order_relaxed)) {
+        if (local_profiler.counters == nullptr) local_profiler.counters = std::make_unique<HardwareCounters>();
+        has_counters = local_profiler.counters->Read(counters);
+    }
+    // カウンターの読み取りの時間を含めないよう、時刻は最後に取得する
+    start = GetTimestamp();
+    return has_counters;
+}
+
+void Profiler::EndZone(char const* name, std::int64_t start, Counters const& counters, bool has_counters) {
+    ProfileEvent event { name, start, GetTimestamp() - start, {}, false };
+    if (has_counters) {
+        Counters end_counters;
+        if (local_profiler.counters->Read(end_counters)) {
+            for (std::size_t i = 0; i < kCounterCount; ++i) event.counters[i] = end_counters[i] - counters[i];
+            event.has_counters = true;
+        }
+    }
+    local_profiler.GetBuffer().Push(event);
+}
+
+void Profiler::WriteChromeTrace(std::filesystem::path const& path) {
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    {
+        auto& registry = ProfilerRegistry::GetInstance();
+        std::lock_guard lock(registry.mutex);
+        buffers = registry.buffers;
+    }
+
+    std::error_code ec;
+    if (path.has_parent_path()) std::filesystem::create_directories(path.parent_path(), ec);
+
+    auto temp_path = path;
+    temp_path += ".tmp";
+    {
+        std::ofstream ofs(temp_path, std::ios::trunc);
+        ofs << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+        char buffer[128];
+        bool first = true;
+        auto const separator = [&]() -> std::ofstream& {
+            if (!first) ofs << ",\n";
+            first = false;
+            return ofs;
+        };
+
+        for (auto const& thread : buffers) {
+            if (auto const name = thread->thread_name.load(std::memory_order_relaxed)) {
+                separator() << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread->thread_id
+                    << ",\"args\":{\"name\":";
+                WriteJsonString(ofs, name);
+                ofs << "}}";
+            }
+
+            auto const size = thread->size.load(std::memory_order_acquire);
+            for (std::size_t i = 0; i < size; ++i) {
+                auto const& event = thread->chunks[i / kChunkSize][i % kChunkSize];
+                separator() << "{\"name\":";
+                WriteJsonString(ofs, event.name);
+                // Chrome のトレース形式の時刻はマイクロ秒単位
+                std::snprintf(buffer, sizeof(buffer), ",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f",
+                    thread->thread_id, event.start / 1000., event.duration / 1000.);
+                ofs << buffer;
+                if (event.has_counters) {
+                    ofs << ",\"args\":{";
+                    for (std::size_t c = 0; c < kCounterCount; ++c) {
+                        ofs << (c == 0 ? "" : ",") << '"' << kCounterNames[c] << "\":" << event.counters[c];
+                    }
+                    ofs << '}';
+                }
+                ofs << '}';
+            }
+
+            if (auto const dropped = thread->dropped.load(std::memory_order_relaxed)) {
+                separator() << "{\"name\":\"dropped_zones\",\"ph\":\"C\",\"pid\":1,\"tid\":" << thread->thread_id
+                    << ",\"ts\":0,\"args\":{\"count\":" << dropped << "}}";
+            }
+        }
+        ofs << "\n]}\n";
+
+        if (!ofs) {
+            throw std::runtime_error("Failed to write " + temp_path.string());
+        }
+    }
+    std::filesystem::rename(temp_path, path, ec);
+    if (ec) {
+        throw std::runtime_error("Failed to write " + path.string() + ": " + ec.message());
+    }
+}
+
+} // namespace digitalcurling::client
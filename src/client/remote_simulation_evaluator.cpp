@@ -0,0 +1,454 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: Unlicense
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <list>
+#include <stdexcept>
+#include <type_traits>
+#include <httplib.h>
+#include "digitalcurling/client/async_logger.hpp"
+#include "digitalcurling/client/profiler.hpp"
+#include "digitalcurling/client/remote_simulation_evaluator.hpp"
+#include "digitalcurling/client/thinking_context.hpp"
+
+namespace digitalcurling::client {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::uint32_t kMagic = 0x44435352; // "DCSR"
+constexpr std::uint32_t kProtocolVersion = 1;
+constexpr char const* kSimulatePath = "/simulate";
+constexpr char const* kContentType = "application/octet-stream";
+
+constexpr std::size_t kMinChunkSize = 16;
+// 処理の速いノードが多くのチャンクを処理できるよう、ワーカーあたり複数のチャンクに分ける
+constexpr std::size_t kChunksPerWorker = 4;
+constexpr auto kNodeCooldown = std::chrono::seconds(30);
+constexpr auto kConnectionTimeout = std::chrono::seconds(1);
+constexpr auto kReadTimeout = std::chrono::seconds(30);
+constexpr auto kWaitInterval = std::chrono::milliseconds(5);
+
+/// @brief リクエストのヘッダ
+///
+/// リクエストはヘッダ、シミュレーターの JSON、`SimulationJob` の配列の順に並べる。
+/// レスポンスは `CompactBoard` の配列。ノードとクライアントは同じバイナリであることを前提とする。
+struct RequestHeader {
+    std::uint32_t magic;
+    std::uint32_t version;
+    float sheet_width;
+    std::uint32_t json_size;
+    std::uint32_t job_count;
+};
+
+static_assert(std::is_trivially_copyable_v<RequestHeader>);
+
+enum ChunkState : std::uint8_t {
+    kQueued,
+    kInFlight,
+};
+
+double ToMilliseconds(Clock::duration duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+} // namespace
+
+struct RemoteSimulationEvaluator::Batch {
+    std::vector<SimulationJob> jobs;
+    std::size_t chunk_size = 0;
+    std::size_t chunk_count = 0;
+    std::unique_ptr<std::atomic<std::uint8_t>[]> states;
+    std::unique_ptr<std::atomic<bool>[]> completed;
+    std::optional<Clock::time_point> deadline;
+    /// @brief 思考が取り消され、新しいチャンクを処理しないなら `true`
+    std::atomic<bool> is_cancelled = false;
+
+    std::mutex mutex;
+    std::condition_variable cond_var;
+    std::size_t completed_count = 0;
+
+    Batch(std::pmr::vector<SimulationJob> const& source, std::size_t chunk_size, std::optional<Clock::time_point> deadline)
+      : jobs(source.begin(), source.end()),
+        chunk_size(chunk_size),
+        chunk_count((source.size() + chunk_size - 1) / chunk_size),
+        states(new std::atomic<std::uint8_t>[chunk_count]),
+        completed(new std::atomic<bool>[chunk_count]),
+        deadline(deadline)
+    {
+        for (std::size_t i = 0; i < chunk_count; ++i) {
+            states[i] = kQueued;
+            completed[i] = false;
+        }
+    }
+
+    std::pair<std::size_t, std::size_t> GetRange(std::size_t chunk) const {
+        return { chunk * chunk_size, std::min(jobs.size(), (chunk + 1) * chunk_size) };
+    }
+
+    /// @brief 未処理のチャンクを取得する
+    std::optional<std::size_t> Claim() {
+        if (is_cancelled) return std::nullopt;
+        for (std::size_t i = 0; i < chunk_count; ++i) {
+            std::uint8_t expected = kQueued;
+            if (states[i].compare_exchange_strong(expected, kInFlight)) return i;
+        }
+        return std::nullopt;
+    }
+
+    /// @brief ノードで処理中のまま完了していないチャンクを返す
+    std::optional<std::size_t> FindStraggler() const {
+        for (std::size_t i = 0; i < chunk_count; ++i) {
+            if (states[i] == kInFlight && !completed[i]) return i;
+        }
+        return std::nullopt;
+    }
+
+    /// @brief チャンクを未処理に戻す
+    void Requeue(std::size_t chunk) {
+        if (!completed[chunk]) states[chunk] = kQueued;
+        cond_var.notify_all();
+    }
+
+    /// @brief チャンクの結果を書き込む
+    /// @return 先に完了していた場合は `false`
+    bool Complete(std::size_t chunk, std::vector<CompactBoard> const& boards) {
+        if (completed[chunk].exchange(true)) return false;
+
+        auto const [begin, end] = GetRange(chunk);
+        for (auto i = begin; i < end; ++i) jobs[i].board = boards[i - begin];
+        {
+            std::lock_guard lock(mutex);
+            completed_count++;
+        }
+        cond_var.notify_all();
+        return true;
+    }
+
+    bool IsFinished() {
+        std::lock_guard lock(mutex);
+        return completed_count == chunk_count;
+    }
+};
+
+struct RemoteSimulationEvaluator::Node {
+    std::string url;
+    std::thread thread;
+    /// @brief 次に使用できる時刻 (ノードのスレッドのみが使用する)
+    Clock::time_point available_at {};
+    /// @brief このノードで処理したジョブ数
+    std::atomic<std::uint64_t> jobs = 0;
+};
+
+RemoteSimulationEvaluator::RemoteSimulationEvaluator(
+    nlohmann::json const& simulator_json,
+    float sheet_width,
+    std::vector<std::string> const& nodes,
+    std::unique_ptr<ISimulationEvaluator> local
+)
+  : simulator_json_(simulator_json.dump()),
+    sheet_width_(sheet_width),
+    local_(std::move(local))
+{
+    for (auto const& url : nodes) {
+        auto node = std::make_unique<Node>();
+        node->url = url;
+        nodes_.push_back(std::move(node));
+    }
+    for (auto& node : nodes_) {
+        node->thread = std::thread([this, node = node.get()]() { RunNodeThread(*node); });
+    }
+}
+
+RemoteSimulationEvaluator::~RemoteSimulationEvaluator() {
+    {
+        std::lock_guard lock(mutex_);
+        is_stopped_ = true;
+    }
+    cond_var_.notify_all();
+    for (auto& node : nodes_) node->thread.join();
+
+    if (total_jobs_ > 0) {
+        std::string per_node;
+        for (auto const& node : nodes_) {
+            per_node += " " + node->url + "=" + std::to_string(node->jobs.load());
+        }
+        AsyncLogger::GetInstance().Log(LogLevel::kInfo, "remote",
+            "Remote evaluation: %llu jobs, %.0f jobs/s, local=%llu%s",
+            static_cast<unsigned long long>(total_jobs_),
+            static_cast<double>(total_jobs_) / std::chrono::duration<double>(total_time_).count(),
+            static_cast<unsigned long long>(total_local_jobs_),
+            per_node.c_str());
+    }
+}
+
+void RemoteSimulationEvaluator::SetDeadline(std::optional<std::chrono::steady_clock::time_point> deadline) {
+    deadline_ = deadline;
+    local_->SetDeadline(deadline);
+}
+
+void RemoteSimulationEvaluator::WarmUp() {
+    local_->WarmUp();
+}
+
+void RemoteSimulationEvaluator::Evaluate(std::pmr::vector<SimulationJob>& jobs) {
+    PROFILE_ZONE("RemoteSimulationEvaluator::Evaluate");
+    if (jobs.empty()) return;
+    auto const start = Clock::now();
+
+    auto const worker_count = nodes_.size() + 1;
+    auto const chunk_size = std::max(kMinChunkSize, (jobs.size() + worker_count * kChunksPerWorker - 1) / (worker_count * kChunksPerWorker));
+    auto batch = std::make_shared<Batch>(jobs, chunk_size, deadline_);
+    {
+        std::lock_guard lock(mutex_);
+        batch_ = batch;
+        batch_generation_++;
+    }
+    cond_var_.notify_all();
+
+    // ローカルでも未処理のチャンクを処理し、期限を過ぎた後はノードで処理中のチャンクも引き継ぐ
+    std::size_t local_jobs = 0;
+    std::pmr::vector<SimulationJob> chunk_jobs;
+    std::vector<CompactBoard> boards;
+    auto const* const context = ThinkingContext::GetCurrent();
+    while (!batch->IsFinished()) {
+        // 思考が取り消された場合は、ノードで処理中のチャンクを待たずに戻る (結果は破棄される)
+        if (context != nullptr && context->IsCancelled()) {
+            batch->is_cancelled = true;
+            break;
+        }
+
+        auto chunk = batch->Claim();
+        if (!chunk.has_value() && deadline_.has_value() && Clock::now() >= deadline_.value()) {
+            chunk = batch->FindStraggler();
+        }
+        if (!chunk.has_value()) {
+            std::unique_lock lock(batch->mutex);
+            batch->cond_var.wait_for(lock, kWaitInterval);
+            continue;
+        }
+
+        auto const [begin, end] = batch->GetRange(chunk.value());
+        chunk_jobs.assign(jobs.begin() + begin, jobs.begin() + end);
+        local_->Evaluate(chunk_jobs);
+
+        boards.resize(chunk_jobs.size());
+        for (std::size_t i = 0; i < chunk_jobs.size(); ++i) boards[i] = chunk_jobs[i].board;
+        if (batch->Complete(chunk.value(), boards)) local_jobs += chunk_jobs.size();
+    }
+
+    {
+        std::lock_guard lock(mutex_);
+        batch_.reset();
+    }
+    // 取り消した場合はノードがまだ結果を書き込んでいる可能性があるため、盤面を書き戻さない
+    if (batch->is_cancelled) return;
+    {
+        std::lock_guard lock(batch->mutex);
+        for (std::size_t i = 0; i < jobs.size(); ++i) jobs[i].board = batch->jobs[i].board;
+    }
+
+    auto const elapsed = Clock::now() - start;
+    total_jobs_ += jobs.size();
+    total_local_jobs_ += local_jobs;
+    total_time_ += elapsed;
+
+    AsyncLogger::GetInstance().Log(LogLevel::kDebug, "remote",
+        "Evaluated %zu jobs in %.1f ms (%.0f jobs/s, local %zu, remote %zu)",
+        jobs.size(), ToMilliseconds(elapsed),
+        static_cast<double>(jobs.size()) / std::chrono::duration<double>(elapsed).count(),
+        local_jobs, jobs.size() - local_jobs);
+}
+
+void RemoteSimulationEvaluator::RunNodeThread(Node& node) {
+    httplib::Client client(node.url);
+    client.set_connection_timeout(kConnectionTimeout);
+    client.set_keep_alive(true);
+
+    std::uint64_t generation = 0;
+    std::vector<CompactBoard> boards;
+    while (true) {
+        std::shared_ptr<Batch> batch;
+        {
+            std::unique_lock lock(mutex_);
+            cond_var_.wait(lock, [&]() { return is_stopped_ || batch_generation_ != generation; });
+            if (is_stopped_) return;
+            generation = batch_generation_;
+            batch = batch_;
+        }
+        if (batch == nullptr || Clock::now() < node.available_at) continue;
+
+        while (auto chunk = batch->Claim()) {
+            auto const [begin, end] = batch->GetRange(chunk.value());
+            auto const count = end - begin;
+
+            auto const body = EncodeRequest(simulator_json_, sheet_width_, batch->jobs.data() + begin, count);
+
+            // 期限がある場合は、期限を過ぎてローカルに引き継がれるまでを待ち時間の目安とする
+            auto read_timeout = std::chrono::duration_cast<std::chrono::milliseconds>(kReadTimeout);
+            if (batch->deadline.has_value()) {
+                auto const remaining = std::chrono::duration_cast<std::chrono::milliseconds>(batch->deadline.value() - Clock::now());
+                read_timeout = std::max(remaining + kConnectionTimeout, std::chrono::milliseconds(kConnectionTimeout));
+            }
+            client.set_read_timeout(read_timeout);
+
+            auto result = client.Post(kSimulatePath, body, kContentType);
+            if (!result || result->status != 200 || result->body.size() != count * sizeof(CompactBoard)) {
+                std::string reason = !result ? httplib::to_string(result.error())
+                    : result->status != 200 ? "status " + std::to_string(result->status) + " " + result->body
+                    : "unexpected response size";
+                AsyncLogger::GetInstance().Log(LogLevel::kWarning, "remote",
+                    "Simulation node %s failed (%s). Falling back to local evaluation.", node.url.c_str(), reason.c_str());
+                batch->Requeue(chunk.value());
+                node.available_at = Clock::now() + kNodeCooldown;
+                break;
+            }
+
+            boards.resize(count);
+            std::memcpy(boards.data(), result->body.data(), count * sizeof(CompactBoard));
+            if (batch->Complete(chunk.value(), boards)) node.jobs += count;
+        }
+    }
+}
+
+std::string RemoteSimulationEvaluator::EncodeRequest(
+    std::string const& simulator_json,
+    float sheet_width,
+    SimulationJob const* jobs,
+    std::size_t count
+) {
+    RequestHeader header { kMagic, kProtocolVersion, sheet_width,
+        static_cast<std::uint32_t>(simulator_json.size()), static_cast<std::uint32_t>(count) };
+
+    std::string body;
+    body.reserve(sizeof(header) + simulator_json.size() + count * sizeof(SimulationJob));
+    body.append(reinterpret_cast<char const*>(&header), sizeof(header));
+    body += simulator_json;
+    body.append(reinterpret_cast<char const*>(jobs), count * sizeof(SimulationJob));
+    return body;
+}
+
+RemoteSimulationEvaluator::Request RemoteSimulationEvaluator::DecodeRequest(std::string const& body) {
+    RequestHeader header;
+    if (body.size() < sizeof(header)) {
+        throw std::invalid_argument("request is too short");
+    }
+    std::memcpy(&header, body.data(), sizeof(header));
+    if (header.magic != kMagic || header.version != kProtocolVersion) {
+        throw std::invalid_argument("unsupported request format");
+    }
+    if (body.size() != sizeof(header) + header.json_size + std::size_t(header.job_count) * sizeof(SimulationJob)) {
+        throw std::invalid_argument("request size does not match the header");
+    }
+    if (!std::isfinite(header.sheet_width) || header.sheet_width <= 0.f) {
+        throw std::invalid_argument("invalid sheet width");
+    }
+
+    Request request;
+    request.sheet_width = header.sheet_width;
+    request.simulator_json = body.substr(sizeof(header), header.json_size);
+    request.jobs.resize(header.job_count);
+    std::memcpy(request.jobs.data(), body.data() + sizeof(header) + header.json_size, request.jobs.size() * sizeof(SimulationJob));
+
+    for (std::size_t i = 0; i < request.jobs.size(); ++i) {
+        auto const& job = request.jobs[i];
+        if (job.stone_index >= CompactBoard::kStoneCount) {
+            throw std::invalid_argument("job " + std::to_string(i) + ": stone index out of range");
+        }
+        if (!std::isfinite(job.translational_velocity) || !std::isfinite(job.angular_velocity) || !std::isfinite(job.release_angle)) {
+            throw std::invalid_argument("job " + std::to_string(i) + ": invalid shot");
+        }
+        for (std::size_t j = 0; j < CompactBoard::kStoneCount; ++j) {
+            if (job.board.HasStone(j) && !(std::isfinite(job.board.x[j]) && std::isfinite(job.board.y[j]))) {
+                throw std::invalid_argument("job " + std::to_string(i) + ": invalid stone position");
+            }
+        }
+    }
+    return request;
+}
+
+int RemoteSimulationEvaluator::RunNode(std::string const& host, int port, FactoryCreator const& create_factory, std::size_t thread_count) {
+    // 最近使用した順に並べる (処理中のリクエストがあっても追い出せるよう、共有で保持する)
+    std::mutex mutex;
+    std::list<std::pair<std::string, std::shared_ptr<LocalSimulationEvaluator>>> evaluators;
+
+    return ServeNode(host, port, [&](Request& request) {
+        auto const key = request.simulator_json + "@" + std::to_string(request.sheet_width);
+        std::shared_ptr<LocalSimulationEvaluator> evaluator;
+        {
+            std::lock_guard lock(mutex);
+            auto it = std::find_if(evaluators.begin(), evaluators.end(), [&key](auto const& entry) { return entry.first == key; });
+            if (it != evaluators.end()) {
+                evaluators.splice(evaluators.begin(), evaluators, it);
+            } else {
+                auto const factory = create_factory(nlohmann::json::parse(request.simulator_json));
+                auto const& setting = SimulationEvaluatorSetting::GetInstance();
+                auto created = std::make_shared<LocalSimulationEvaluator>(
+                    *factory, request.sheet_width, thread_count, setting.free_path, setting.checkpoints);
+                created->WarmUp();
+                evaluators.emplace_front(key, std::move(created));
+                if (evaluators.size() > kMaxNodeEvaluators) evaluators.pop_back();
+            }
+            evaluator = evaluators.front().second;
+        }
+        evaluator->Evaluate(request.jobs);
+    });
+}
+
+int RemoteSimulationEvaluator::RunNode(std::string const& host, int port, JobRunner const& run_job) {
+    return ServeNode(host, port, [&run_job](Request& request) {
+        for (auto& job : request.jobs) run_job(job);
+    });
+}
+
+int RemoteSimulationEvaluator::ServeNode(std::string const& host, int port, std::function<void(Request&)> const& evaluate) {
+    httplib::Server server;
+    server.Get("/health", [](httplib::Request const&, httplib::Response& res) {
+        res.set_content("ok", "text/plain");
+    });
+    server.Post(kSimulatePath, [&](httplib::Request const& req, httplib::Response& res) {
+        auto const start = Clock::now();
+
+        Request request;
+        try {
+            request = DecodeRequest(req.body);
+        } catch (std::invalid_argument const& e) {
+            res.status = 400;
+            res.set_content(e.what(), "text/plain");
+            AsyncLogger::GetInstance().Log(LogLevel::kWarning, "node", "Rejected a request from %s: %s", req.remote_addr.c_str(), e.what());
+            return;
+        }
+
+        try {
+            evaluate(request);
+
+            auto const& jobs = request.jobs;
+            std::string body(jobs.size() * sizeof(CompactBoard), '\0');
+            for (std::size_t i = 0; i < jobs.size(); ++i) {
+                std::memcpy(body.data() + i * sizeof(CompactBoard), &jobs[i].board, sizeof(CompactBoard));
+            }
+            res.set_content(body, kContentType);
+
+            AsyncLogger::GetInstance().Log(LogLevel::kDebug, "node",
+                "Simulated %zu jobs in %.1f ms", jobs.size(), ToMilliseconds(Clock::now() - start));
+        } catch (std::exception const& e) {
+            res.status = 500;
+            res.set_content(e.what(), "text/plain");
+            AsyncLogger::GetInstance().Log(LogLevel::kError, "node", "%s", e.what());
+        }
+    });
+
+    AsyncLogger::GetInstance().Log(LogLevel::kInfo, "node", "Simulation node listening on %s:%d", host.c_str(), port);
+    if (!server.listen(host, port)) {
+        AsyncLogger::GetInstance().Flush();
+        std::cerr << "[Error] Failed to listen on " << host << ":" << port << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+} // namespace digitalcurling::client
@@ -0,0 +1,215 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: Unlicense
+
+#include "digitalcurling/client/client_helpers.hpp"
+#include "digitalcurling/client/free_path_model.hpp"
+#include "digitalcurling/client/process_simulation_evaluator.hpp"
+#include "digitalcurling/client/profiler.hpp"
+#include "digitalcurling/client/remote_simulation_evaluator.hpp"
+#include "digitalcurling/client/simulation_evaluator.hpp"
+#include "digitalcurling/client/thinking_context.hpp"
+
+#ifdef DIGITALCURLING_CLIENT_USE_LOADER
+    #include "digitalcurling/plugins/plugin_json_converter.hpp"
+#endif
+
+namespace digitalcurling::client {
+
+namespace {
+
+/// @brief 評価したジョブ数とスループットをメトリクスに記録する
+///
+/// 評価器は入れ子になりうるため (評価ノードの評価器がローカルの評価器を保持するなど)、
+/// `CreateSimulationEvaluator()` が返す最も外側の評価器でのみ記録する。
+class MeteredSimulationEvaluator : public ISimulationEvaluator {
+public:
+    explicit MeteredSimulationEvaluator(std::unique_ptr<ISimulationEvaluator> evaluator)
+        : evaluator_(std::move(evaluator)) {}
+
+    void Evaluate(std::pmr::vector<SimulationJob>& jobs) override {
+        auto const start = std::chrono::steady_clock::now();
+        evaluator_->Evaluate(jobs);
+        // 取り消した場合は全てのジョブを評価したとは限らない
+        if (jobs.empty() || ThinkingContext::IsCurrentCancelled()) return;
+
+        auto& metrics = Metrics::GetInstance();
+        metrics.simulations.Add(jobs.size());
+        auto const seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (seconds > 0.) metrics.simulations_per_second.Set(static_cast<double>(jobs.size()) / seconds);
+    }
+
+    void SetDeadline(std::optional<std::chrono::steady_clock::time_point> deadline) override {
+        evaluator_->SetDeadline(deadline);
+    }
+
+    void WarmUp() override { evaluator_->WarmUp(); }
+
+private:
+    std::unique_ptr<ISimulationEvaluator> evaluator_;
+};
+
+} // namespace
+
+void RunSimulationJob(
+    simulators::ISimulator& simulator,
+    SimulationJob& job,
+    float sheet_width,
+    std::uint16_t active_stones,
+    std::optional<simulators::ISimulator::StoneState> const& checkpoint
+) {
+    auto stones = job.board.ToSimulatorStones();
+    for (std::size_t i = 0; i < stones.size(); ++i) {
+        if (((active_stones >> i) & 1u) == 0) stones[i] = std::nullopt;
+    }
+    if (checkpoint.has_value()) {
+        stones[job.stone_index] = checkpoint.value();
+    } else {
+        auto const shot = job.GetShot();
+        stones[job.stone_index] = simulators::ISimulator::StoneState(
+            Vector2 { 0.f, 0.f }, 0.f, shot.ToVector2(), shot.angular_velocity
+        );
+    }
+    simulator.SetStones(stones);
+
+    SimulateFull(&simulator, sheet_width);
+    auto const result = CompactBoard::FromSimulatorStones(simulator.GetStones());
+    if ((active_stones | job.board.occupied) == active_stones) {
+        job.board = result;
+        return;
+    }
+    for (std::size_t i = 0; i < CompactBoard::kStoneCount; ++i) {
+        if (((active_stones >> i) & 1u) == 0) continue;
+        if (result.HasStone(i)) {
+            job.board.SetStone(i, result.GetPosition(i));
+        } else {
+            job.board.RemoveStone(i);
+        }
+    }
+}
+
+
+// --- LocalSimulationEvaluator ---
+LocalSimulationEvaluator::LocalSimulationEvaluator(
+    simulators::ISimulatorFactory const& factory,
+    float sheet_width,
+    std::size_t thread_count,
+    bool use_free_path,
+    bool use_checkpoints
+)
+  : factory_(factory.Clone()),
+    sheet_width_(sheet_width),
+    simulator_pool_(),
+    thread_pool_(thread_count),
+    use_free_path_(use_free_path),
+    use_checkpoints_(use_checkpoints),
+    free_path_()
+{
+    simulator_pool_.Register(*factory_, thread_pool_.GetThreadCount());
+}
+
+LocalSimulationEvaluator::~LocalSimulationEvaluator() = default;
+
+void LocalSimulationEvaluator::Evaluate(std::pmr::vector<SimulationJob>& jobs) {
+    PROFILE_ZONE("LocalSimulationEvaluator::Evaluate");
+    // ジョブごとにシミュレーターを借りるとロックが多くなるため、スレッドごとにまとめて処理する
+    auto const thread_count = std::min(thread_pool_.GetThreadCount(), jobs.size());
+    if (thread_count == 0) return;
+
+    auto const free_path = std::atomic_load(&free_path_);
+    auto const chunk_size = (jobs.size() + thread_count - 1) / thread_count;
+    // 思考の状態は呼び出したスレッドにのみ設定されているため、ワーカーには直接渡す
+    auto const* const context = ThinkingContext::GetCurrent();
+    thread_pool_.ParallelFor(thread_count, [this, &jobs, &free_path, context, chunk_size](std::size_t chunk) {
+        auto simulator = simulator_pool_.Acquire(*factory_);
+        auto const end = std::min(jobs.size(), (chunk + 1) * chunk_size);
+        for (auto i = chunk * chunk_size; i < end; ++i) {
+            if (context != nullptr && context->IsCancelled()) return;
+            auto& job = jobs[i];
+            if (free_path != nullptr) {
+                if (free_path->IsPredictionEnabled()) {
+                    auto board = free_path->Predict(job.board, job.stone_index, job.GetShot());
+                    free_path_metrics_->Record(board.has_value());
+                    if (board.has_value()) {
+                        job.board = board.value();
+                        continue;
+                    }
+                }
+
+                auto const active = free_path->FindActiveStones(job.board, job.stone_index, job.GetShot());
+                active_stones_metrics_->Record(active.has_value());
+                std::optional<simulators::ISimulator::StoneState> checkpoint;
+                if (use_checkpoints_) {
+                    checkpoint = free_path->FindCheckpoint(job.board, job.stone_index, job.GetShot());
+                    checkpoint_metrics_->Record(checkpoint.has_value());
+                }
+                RunSimulationJob(*simulator, job, sheet_width_, active.value_or(0xFFFF), checkpoint);
+                continue;
+            }
+            RunSimulationJob(*simulator, job, sheet_width_);
+        }
+    });
+}
+
+void LocalSimulationEvaluator::WarmUp() {
+    if (std::atomic_load(&free_path_) != nullptr) return;
+    // 動きうるストーンの判定は結果を変えないため、予測の有無によらず表を作成する
+    if (use_free_path_) free_path_metrics_ = &Metrics::GetInstance().GetCache("free_path");
+    active_stones_metrics_ = &Metrics::GetInstance().GetCache("active_stones");
+    if (use_checkpoints_) checkpoint_metrics_ = &Metrics::GetInstance().GetCache("checkpoint");
+    FreePathModel::Setting free_path_setting;
+    free_path_setting.use_prediction = use_free_path_;
+    free_path_setting.use_checkpoints = use_checkpoints_;
+    std::shared_ptr<FreePathModel const> free_path = FreePathModel::Fit(*factory_, simulator_pool_, thread_pool_, sheet_width_, free_path_setting);
+    std::atomic_store(&free_path_, std::move(free_path));
+}
+
+
+// --- CreateSimulationEvaluator ---
+std::unique_ptr<ISimulationEvaluator> CreateSimulationEvaluator(simulators::ISimulatorFactory const& factory, float sheet_width) {
+    auto const& setting = SimulationEvaluatorSetting::GetInstance();
+
+#ifdef DIGITALCURLING_CLIENT_USE_LOADER
+    // ワーカープロセスと評価ノードには JSON でシミュレーターを受け渡すため、プラグインローダーが必要となる
+    if (setting.worker_process_count > 0 || !setting.remote_nodes.empty()) {
+        nlohmann::json simulator_json = factory;
+
+        std::unique_ptr<ISimulationEvaluator> evaluator;
+        if (setting.worker_process_count > 0) {
+            evaluator = std::make_unique<ProcessSimulationEvaluator>(
+                simulator_json, sheet_width, setting.worker_process_count, setting.worker_arguments
+            );
+        } else {
+            evaluator = std::make_unique<LocalSimulationEvaluator>(
+                factory, sheet_width, setting.thread_count, setting.free_path, setting.checkpoints);
+        }
+
+        if (!setting.remote_nodes.empty()) {
+            evaluator = std::make_unique<RemoteSimulationEvaluator>(
+                simulator_json, sheet_width, setting.remote_nodes, std::move(evaluator)
+            );
+        }
+        return std::make_unique<MeteredSimulationEvaluator>(std::move(evaluator));
+    }
+#endif
+
+    return std::make_unique<MeteredSimulationEvaluator>(std::make_unique<LocalSimulationEvaluator>(
+        factory, sheet_width, setting.thread_count, setting.free_path, setting.checkpoints));
+}
+
+std::unique_ptr<ISimulationEvaluator> CreateScreeningSimulationEvaluator(simulators::ISimulatorFactory const& factory, float sheet_width) {
+    auto const& setting = SimulationEvaluatorSetting::GetInstance();
+    if (setting.screening_seconds_per_frame <= 0.) return nullptr;
+
+#ifdef DIGITALCURLING_CLIENT_USE_LOADER
+    // 1フレームの時間はファクトリーの JSON でのみ変更できる
+    nlohmann::json simulator_json = factory;
+    simulator_json["seconds_per_frame"] = setting.screening_seconds_per_frame;
+    auto const screening_factory = simulator_json.get<std::unique_ptr<simulators::ISimulatorFactory>>();
+    return std::make_unique<MeteredSimulationEvaluator>(
+        std::make_unique<LocalSimulationEvaluator>(*screening_factory, sheet_width, setting.thread_count));
+#else
+    return nullptr;
+#endif
+}
+
+} // namespace digitalcurling::client
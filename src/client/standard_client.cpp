@@ -37,6 +37,10 @@ std::vector<std::uint8_t> StandardClient::GetPlayersIndex() const {
     return players_index_;
 }
 
+void StandardClient::OnWarmUp() {
+    engine_->OnWarmUp();
+}
+
 void StandardClient::OnGameStart(
     Team const& team,
     std::vector<std::pair<GameState, std::optional<moves::Shot>>> states
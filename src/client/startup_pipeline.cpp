@@ -0,0 +1,63 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: Unlicense
+
+#include <stdexcept>
+#include "digitalcurling/client/startup_pipeline.hpp"
+
+namespace digitalcurling::client {
+
+StartupPipeline::StartupPipeline(Clock::time_point origin)
+  : origin_(origin)
+{}
+
+StartupPipeline::~StartupPipeline() {
+    for (auto const& [name, step] : steps_) {
+        if (step.valid()) step.wait();
+    }
+}
+
+void StartupPipeline::AddStep(std::string name, std::vector<std::string> const& dependencies, std::function<void()> func) {
+    if (steps_.count(name) > 0) {
+        throw std::runtime_error("StartupPipeline: step already exists: " + name);
+    }
+
+    std::vector<std::shared_future<void>> waits;
+    for (auto const& dependency : dependencies) {
+        waits.push_back(GetFuture(dependency));
+    }
+
+    auto step = std::async(std::launch::async, [this, name, waits = std::move(waits), func = std::move(func)]() {
+        for (auto const& wait : waits) wait.get();
+
+        auto const start = GetElapsed();
+        func();
+        auto const end = GetElapsed();
+
+        std::lock_guard lock(timings_mutex_);
+        timings_.push_back(StepTiming { name, start, end });
+    });
+    steps_.emplace(std::move(name), step.share());
+}
+
+std::shared_future<void> StartupPipeline::GetFuture(std::string const& name) const {
+    auto it = steps_.find(name);
+    if (it == steps_.end()) {
+        throw std::runtime_error("StartupPipeline: unknown step: " + name);
+    }
+    return it->second;
+}
+
+void StartupPipeline::Wait(std::string const& name) const {
+    GetFuture(name).get();
+}
+
+std::chrono::milliseconds StartupPipeline::GetElapsed() const {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - origin_);
+}
+
+std::vector<StartupPipeline::StepTiming> StartupPipeline::GetTimings() const {
+    std::lock_guard lock(timings_mutex_);
+    return timings_;
+}
+
+} // namespace digitalcurling::client
@@ -0,0 +1,46 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: Unlicense
+
+#include "digitalcurling/client/thinking_context.hpp"
+
+namespace digitalcurling::client {
+
+namespace {
+
+thread_local ThinkingContext* current_context = nullptr;
+
+} // namespace
+
+void ThinkingContext::Publish(moves::Move const& move) {
+    std::lock_guard lock(mutex_);
+    best_ = move;
+}
+
+std::optional<moves::Move> ThinkingContext::GetBest() const {
+    std::lock_guard lock(mutex_);
+    return best_;
+}
+
+void ThinkingContext::ReportEvaluation(double value) {
+    std::lock_guard lock(mutex_);
+    evaluation_ = value;
+}
+
+std::optional<double> ThinkingContext::GetEvaluation() const {
+    std::lock_guard lock(mutex_);
+    return evaluation_;
+}
+
+ThinkingContext* ThinkingContext::GetCurrent() {
+    return current_context;
+}
+
+ThinkingContext::Scope::Scope(ThinkingContext& context) : previous_(current_context) {
+    current_context = &context;
+}
+
+ThinkingContext::Scope::~Scope() {
+    current_context = previous_;
+}
+
+} // namespace digitalcurling::client
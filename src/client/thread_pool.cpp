@@ -0,0 +1,86 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: Unlicense
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include "digitalcurling/client/profiler.hpp"
+#include "digitalcurling/client/thread_pool.hpp"
+
+namespace digitalcurling::client {
+
+ThreadPool::ThreadPool(std::size_t thread_count) {
+    if (thread_count == 0) {
+        thread_count = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    }
+
+    threads_.reserve(thread_count);
+    for (std::size_t i = 0; i < thread_count; ++i) {
+        threads_.emplace_back([this]() {
+            Profiler::SetThreadName("thread pool");
+            while (true) {
+                std::function<void()> task;
+                {
+                    std::unique_lock lock(mutex_);
+                    cond_var_.wait(lock, [this]() { return is_stopped_ || !tasks_.empty(); });
+                    if (is_stopped_ && tasks_.empty()) return;
+                    task = std::move(tasks_.front());
+                    tasks_.pop();
+                }
+                task();
+            }
+        });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard lock(mutex_);
+        is_stopped_ = true;
+    }
+    cond_var_.notify_all();
+    for (auto& thread : threads_) thread.join();
+}
+
+void ThreadPool::Push(std::function<void()> task) {
+    {
+        std::lock_guard lock(mutex_);
+        tasks_.push(std::move(task));
+    }
+    cond_var_.notify_one();
+}
+
+void ThreadPool::ParallelFor(std::size_t count, std::function<void(std::size_t)> const& func) {
+    if (count == 0) return;
+
+    struct State {
+        std::atomic<std::size_t> next = 0;
+        std::mutex mutex;
+        std::exception_ptr exception;
+    };
+    auto state = std::make_shared<State>();
+
+    auto run = [state, count, &func]() {
+        for (auto i = state->next.fetch_add(1); i < count; i = state->next.fetch_add(1)) {
+            try {
+                func(i);
+            } catch (...) {
+                std::lock_guard lock(state->mutex);
+                if (!state->exception) state->exception = std::current_exception();
+                state->next = count;
+            }
+        }
+    };
+
+    auto const helper_count = std::min(threads_.size(), count - 1);
+    std::vector<std::future<void>> helpers;
+    helpers.reserve(helper_count);
+    for (std::size_t i = 0; i < helper_count; ++i) helpers.push_back(Submit(run));
+
+    run();
+    for (auto& helper : helpers) helper.wait();
+
+    if (state->exception) std::rethrow_exception(state->exception);
+}
+
+} // namespace digitalcurling::client
@@ -0,0 +1,235 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: Unlicense
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include "digitalcurling/client/turn_arena.hpp"
+
+namespace digitalcurling::client {
+
+#ifndef NDEBUG
+namespace {
+
+/// @brief 破棄した領域を埋める値
+constexpr int kPoison = 0xDD;
+
+/// @brief 確保の直前に置くヘッダ
+struct AllocationHeader {
+    /// @brief 確保した時点の `Reset()` の回数
+    std::uint64_t reset_count;
+    /// @brief 解放されていなければ `kLive`
+    std::uint64_t state;
+};
+
+/// @brief 解放されていない確保を表す値
+constexpr std::uint64_t kLive = 0xA11C'A7ED'A11C'A7ED;
+
+static_assert(sizeof(AllocationHeader) <= alignof(std::max_align_t));
+
+/// @brief 確保の前に置くヘッダの大きさ (確保したメモリの整列を保つため、整列の倍数とする)
+std::size_t GetHeaderSize(std::size_t alignment) {
+    return std::max(alignment, alignof(std::max_align_t));
+}
+
+} // namespace
+#endif
+
+// --- Arena ---
+Arena::Arena(std::size_t chunk_size, std::pmr::memory_resource* upstream, std::atomic<std::uint64_t> const* generation)
+  : chunk_size_(chunk_size),
+    upstream_(upstream),
+    generation_source_(generation),
+    generation_(generation != nullptr ? generation->load(std::memory_order_acquire) : 0)
+{}
+
+Arena::~Arena() {
+    for (auto const& chunk : chunks_) {
+        upstream_->deallocate(chunk.data, chunk.size, alignof(std::max_align_t));
+    }
+}
+
+void Arena::Reset() {
+#ifndef NDEBUG
+    // 破棄した確保を使い続けている場合に気付けるよう、使用した領域を埋める
+    for (std::size_t i = 0; i < chunks_.size() && i <= current_chunk_; ++i) {
+        std::memset(chunks_[i].data, kPoison, i < current_chunk_ ? chunks_[i].size : offset_);
+    }
+    reset_count_++;
+#endif
+    current_chunk_ = 0;
+    offset_ = 0;
+    allocations_.store(0, std::memory_order_relaxed);
+    allocated_bytes_.store(0, std::memory_order_relaxed);
+    upstream_allocations_.store(0, std::memory_order_relaxed);
+    if (generation_source_ != nullptr) {
+        generation_.store(generation_source_->load(std::memory_order_acquire), std::memory_order_release);
+    }
+}
+
+ArenaStatistics Arena::GetStatistics() const {
+    return ArenaStatistics {
+        allocations_.load(std::memory_order_relaxed),
+        allocated_bytes_.load(std::memory_order_relaxed),
+        upstream_allocations_.load(std::memory_order_relaxed)
+    };
+}
+
+void* Arena::do_allocate(std::size_t bytes, std::size_t alignment) {
+    // 世代が進んでいれば、前の世代の確保を破棄する
+    if (generation_source_ != nullptr
+        && generation_source_->load(std::memory_order_acquire) != generation_.load(std::memory_order_relaxed)) {
+        Reset();
+    }
+
+    allocations_.fetch_add(1, std::memory_order_relaxed);
+    allocated_bytes_.fetch_add(bytes, std::memory_order_relaxed);
+
+#ifndef NDEBUG
+    // 確保の直前に、確保した時点の `Reset()` の回数を記録する
+    auto const header_size = GetHeaderSize(alignment);
+    auto const data = static_cast<std::byte*>(Bump(bytes + header_size, alignment)) + header_size;
+    AllocationHeader const header { reset_count_, kLive };
+    std::memcpy(data - sizeof(header), &header, sizeof(header));
+    return data;
+#else
+    return Bump(bytes, alignment);
+#endif
+}
+
+void* Arena::Bump(std::size_t bytes, std::size_t alignment) {
+    while (current_chunk_ < chunks_.size()) {
+        auto const& chunk = chunks_[current_chunk_];
+        auto const address = reinterpret_cast<std::uintptr_t>(chunk.data) + offset_;
+        auto const padding = (alignment - address % alignment) % alignment;
+        if (offset_ + padding + bytes <= chunk.size) {
+            offset_ += padding + bytes;
+            return chunk.data + offset_ - bytes;
+        }
+        current_chunk_++;
+        offset_ = 0;
+    }
+
+    // 既存のチャンクに収まらない場合は新しいチャンクを確保する
+    auto const size = std::max(chunk_size_, bytes + alignment);
+    auto data = static_cast<std::byte*>(upstream_->allocate(size, alignof(std::max_align_t)));
+    upstream_allocations_.fetch_add(1, std::memory_order_relaxed);
+    chunks_.push_back(Chunk { data, size });
+    current_chunk_ = chunks_.size() - 1;
+
+    auto const address = reinterpret_cast<std::uintptr_t>(data);
+    auto const padding = (alignment - address % alignment) % alignment;
+    offset_ = padding + bytes;
+    return data + padding;
+}
+
+void Arena::do_deallocate(void* p, std::size_t bytes, std::size_t alignment) {
+    // 個別の解放は行わない
+#ifndef NDEBUG
+    // 破棄した後に解放される確保は、ターンをまたいで保持されていたもの。
+    // 破棄の後に同じ位置へ確保し直された場合はヘッダが上書きされるため、2度目の解放で検出する
+    AllocationHeader header;
+    auto const header_address = static_cast<std::byte*>(p) - sizeof(header);
+    std::memcpy(&header, header_address, sizeof(header));
+    if (header.reset_count != reset_count_ || header.state != kLive) {
+        std::fprintf(stderr, "[Error] Arena: memory allocated before Reset() was released after it, or released twice "
+            "(an ArenaVector was kept across a turn).\n");
+        std::abort();
+    }
+    header.state = 0;
+    std::memcpy(header_address, &header, sizeof(header));
+#endif
+}
+
+bool Arena::do_is_equal(std::pmr::memory_resource const& other) const noexcept {
+    return this == &other;
+}
+
+
+// --- TurnArena ---
+namespace {
+
+struct ArenaRegistry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<Arena>> arenas;
+    std::vector<Arena*> free_arenas;
+    /// @brief ターンの世代
+    std::atomic<std::uint64_t> turn = 0;
+    /// @brief 前のターンの統計情報
+    ArenaStatistics previous_statistics;
+
+    /// @brief 現在のターンに確保を行ったアリーナの統計情報を合計する (ロックを取ってから呼び出す)
+    ArenaStatistics Sum(std::uint64_t generation) const {
+        ArenaStatistics statistics;
+        for (auto const& arena : arenas) {
+            if (arena->GetGeneration() == generation) statistics += arena->GetStatistics();
+        }
+        return statistics;
+    }
+
+    static ArenaRegistry& GetInstance() {
+        static ArenaRegistry instance;
+        return instance;
+    }
+};
+
+struct LocalArenaHolder {
+    Arena* arena = nullptr;
+
+    ~LocalArenaHolder() {
+        if (arena == nullptr) return;
+        auto& registry = ArenaRegistry::GetInstance();
+        std::lock_guard lock(registry.mutex);
+        registry.free_arenas.push_back(arena);
+    }
+};
+
+thread_local LocalArenaHolder local_arena;
+
+} // namespace
+
+Arena& TurnArena::Local() {
+    if (local_arena.arena != nullptr) return *local_arena.arena;
+
+    auto& registry = ArenaRegistry::GetInstance();
+    std::lock_guard lock(registry.mutex);
+    if (!registry.free_arenas.empty()) {
+        local_arena.arena = registry.free_arenas.back();
+        registry.free_arenas.pop_back();
+    } else {
+        registry.arenas.push_back(std::make_unique<Arena>(1 << 20, std::pmr::new_delete_resource(), &registry.turn));
+        local_arena.arena = registry.arenas.back().get();
+    }
+    return *local_arena.arena;
+}
+
+ArenaStatistics TurnArena::BeginTurn() {
+    auto& registry = ArenaRegistry::GetInstance();
+    std::lock_guard lock(registry.mutex);
+
+    // 各アリーナは所有するスレッドが次に確保する際に破棄する
+    auto const previous = registry.turn.fetch_add(1, std::memory_order_acq_rel);
+    registry.previous_statistics = registry.Sum(previous);
+    return registry.previous_statistics;
+}
+
+void TurnArena::ResetLocal() {
+    Local().Reset();
+}
+
+ArenaStatistics TurnArena::GetStatistics() {
+    auto& registry = ArenaRegistry::GetInstance();
+    std::lock_guard lock(registry.mutex);
+    return registry.Sum(registry.turn.load(std::memory_order_acquire));
+}
+
+ArenaStatistics TurnArena::GetPreviousTurnStatistics() {
+    auto& registry = ArenaRegistry::GetInstance();
+    std::lock_guard lock(registry.mutex);
+    return registry.previous_statistics;
+}
+
+} // namespace digitalcurling::client
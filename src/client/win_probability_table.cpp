@@ -0,0 +1,247 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: Unlicense
+
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include "digitalcurling/client/async_logger.hpp"
+#include "digitalcurling/client/profiler.hpp"
+#include "digitalcurling/client/win_probability_table.hpp"
+
+namespace digitalcurling::client {
+
+namespace {
+
+constexpr std::uint32_t kMagic = 0x50574344; // "DCWP"
+constexpr std::uint32_t kVersion = 1;
+
+/// @brief ファイルのヘッダ
+struct FileHeader {
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint8_t rule_type;
+    std::uint8_t max_ends_remaining;
+    std::uint8_t max_score_difference;
+    std::uint8_t reserved;
+    std::uint32_t value_count;
+};
+
+/// @brief ブランクエンドの後もハンマーが移らないか
+bool KeepsHammerAfterBlank(GameRuleType rule_type) {
+    // ミックスダブルスではブランクエンドの後にハンマーが相手に移る
+    return rule_type != GameRuleType::kMixedDoubles;
+}
+
+/// @brief エンドの得点から次のエンドでハンマーを持つかを返す
+bool HasHammerAfterEnd(bool has_hammer, int end_score, GameRuleType rule_type) {
+    if (end_score > 0) return false;
+    if (end_score < 0) return true;
+    return KeepsHammerAfterBlank(rule_type) ? has_hammer : !has_hammer;
+}
+
+} // namespace
+
+// --- EndScoreDistribution ---
+void EndScoreDistribution::Normalize() {
+    double const sum = std::accumulate(probabilities.begin(), probabilities.end(), 0.);
+    if (sum <= 0.) return;
+    for (auto& probability : probabilities) probability /= sum;
+}
+
+EndScoreDistribution EndScoreDistribution::GetDefault(GameRuleType rule_type) {
+    EndScoreDistribution distribution;
+    if (rule_type == GameRuleType::kMixedDoubles) {
+        for (auto [score, probability] : std::initializer_list<std::pair<int, double>> {
+            { -4, 0.01 }, { -3, 0.03 }, { -2, 0.08 }, { -1, 0.17 }, { 0, 0.04 },
+            { 1, 0.28 }, { 2, 0.20 }, { 3, 0.11 }, { 4, 0.05 }, { 5, 0.02 }, { 6, 0.01 } }) {
+            distribution.Set(score, probability);
+        }
+    } else {
+        for (auto [score, probability] : std::initializer_list<std::pair<int, double>> {
+            { -4, 0.003 }, { -3, 0.012 }, { -2, 0.05 }, { -1, 0.19 }, { 0, 0.12 },
+            { 1, 0.30 }, { 2, 0.22 }, { 3, 0.08 }, { 4, 0.02 }, { 5, 0.005 } }) {
+            distribution.Set(score, probability);
+        }
+    }
+    distribution.Normalize();
+    return distribution;
+}
+
+// --- WinProbabilityKey ---
+WinProbabilityKey WinProbabilityKey::Create(GameState const& game_state, Team team, std::uint8_t max_end) {
+    int const difference = static_cast<int>(game_state.GetTotalScore(team))
+        - static_cast<int>(game_state.GetTotalScore(GetOpponentTeam(team)));
+    int const ends_remaining = static_cast<int>(max_end) - static_cast<int>(game_state.end);
+
+    WinProbabilityKey key;
+    key.ends_remaining = static_cast<std::uint8_t>(std::clamp(ends_remaining, 0, kMaxEndsRemaining));
+    key.score_difference = static_cast<std::int8_t>(std::clamp(difference, -kMaxScoreDifference, kMaxScoreDifference));
+    key.has_hammer = game_state.hammer == team ? 1 : 0;
+    return key;
+}
+
+// --- WinProbabilityTable ---
+WinProbabilityTable::WinProbabilityTable(std::filesystem::path const& path) : file_(path) {
+    FileHeader header;
+    if (file_.GetSize() < sizeof(header)) {
+        throw std::runtime_error("Win probability table is corrupted: " + path.string());
+    }
+    std::memcpy(&header, file_.GetData(), sizeof(header));
+    if (header.magic != kMagic || header.version != kVersion
+        || header.max_ends_remaining != WinProbabilityKey::kMaxEndsRemaining
+        || header.max_score_difference != WinProbabilityKey::kMaxScoreDifference
+        || header.value_count != kValueCount) {
+        throw std::runtime_error("Unsupported win probability table format: " + path.string());
+    }
+    if (file_.GetSize() != sizeof(header) + kValueCount * sizeof(std::uint16_t)) {
+        throw std::runtime_error("Win probability table is corrupted: " + path.string());
+    }
+
+    values_ = reinterpret_cast<std::uint16_t const*>(static_cast<char const*>(file_.GetData()) + sizeof(header));
+    rule_type_ = static_cast<GameRuleType>(header.rule_type);
+}
+
+WinProbabilityTable WinProbabilityTable::Build(EndScoreDistribution const& distribution, GameRuleType rule_type) {
+    PROFILE_ZONE("WinProbabilityTable::Build");
+    constexpr int kMaxDifference = WinProbabilityKey::kMaxScoreDifference;
+    constexpr int kMaxScore = EndScoreDistribution::kMaxScore;
+
+    double win = 0., lose = 0.;
+    for (int score = 1; score <= kMaxScore; ++score) {
+        win += distribution.Get(score);
+        lose += distribution.Get(-score);
+    }
+    double const blank = distribution.Get(0);
+
+    // 同点で規定のエンドを終えた場合にハンマーを持つチームの勝率
+    double extra_end = 0.5;
+    if (KeepsHammerAfterBlank(rule_type)) {
+        if (win + lose > 0.) extra_end = win / (win + lose);
+    } else if (blank < 1.) {
+        extra_end = (win + blank * lose) / (1. - blank * blank);
+    }
+
+    std::vector<double> values(kValueCount);
+    for (int difference = -kMaxDifference; difference <= kMaxDifference; ++difference) {
+        for (bool has_hammer : { false, true }) {
+            double value = difference > 0 ? 1. : difference < 0 ? 0. : has_hammer ? extra_end : 1. - extra_end;
+            values[Index(0, difference, has_hammer)] = value;
+        }
+    }
+
+    for (int ends_remaining = 1; ends_remaining <= WinProbabilityKey::kMaxEndsRemaining; ++ends_remaining) {
+        for (int difference = -kMaxDifference; difference <= kMaxDifference; ++difference) {
+            for (bool has_hammer : { false, true }) {
+                double value = 0.;
+                for (int score = -kMaxScore; score <= kMaxScore; ++score) {
+                    // 分布はハンマーを持つチームから見た得点
+                    double const probability = distribution.Get(has_hammer ? score : -score);
+                    if (probability == 0.) continue;
+                    auto const next_difference = std::clamp(difference + score, -kMaxDifference, kMaxDifference);
+                    value += probability * values[Index(ends_remaining - 1, next_difference,
+                        HasHammerAfterEnd(has_hammer, score, rule_type))];
+                }
+                values[Index(ends_remaining, difference, has_hammer)] = value;
+            }
+        }
+    }
+
+    WinProbabilityTable table;
+    table.storage_.resize(kValueCount);
+    for (std::size_t i = 0; i < kValueCount; ++i) {
+        table.storage_[i] = static_cast<std::uint16_t>(std::lround(std::clamp(values[i], 0., 1.) * 65535.));
+    }
+    table.values_ = table.storage_.data();
+    table.rule_type_ = rule_type;
+    return table;
+}
+
+std::size_t WinProbabilityTable::Index(int ends_remaining, int score_difference, bool has_hammer) {
+    return (static_cast<std::size_t>(ends_remaining) * kDifferenceCount
+        + static_cast<std::size_t>(score_difference + WinProbabilityKey::kMaxScoreDifference)) * 2
+        + (has_hammer ? 1 : 0);
+}
+
+float WinProbabilityTable::GetValue(int ends_remaining, int score_difference, bool has_hammer) const {
+    ends_remaining = std::clamp(ends_remaining, 0, WinProbabilityKey::kMaxEndsRemaining);
+    score_difference = std::clamp(score_difference, -WinProbabilityKey::kMaxScoreDifference, WinProbabilityKey::kMaxScoreDifference);
+    return Decode(values_[Index(ends_remaining, score_difference, has_hammer)]);
+}
+
+float WinProbabilityTable::Get(WinProbabilityKey const& key) const {
+    return GetValue(key.ends_remaining, key.score_difference, key.has_hammer != 0);
+}
+
+float WinProbabilityTable::GetAfterEnd(WinProbabilityKey const& key, int end_score) const {
+    // エキストラエンドの後も同点ならエキストラエンドを続ける
+    return GetValue(key.ends_remaining - 1, key.score_difference + end_score,
+        HasHammerAfterEnd(key.has_hammer != 0, end_score, rule_type_));
+}
+
+float WinProbabilityTable::GetExpected(WinProbabilityKey const& key, EndScoreDistribution const& distribution) const {
+    double value = 0.;
+    for (int score = -EndScoreDistribution::kMaxScore; score <= EndScoreDistribution::kMaxScore; ++score) {
+        double const probability = distribution.Get(score);
+        if (probability != 0.) value += probability * GetAfterEnd(key, score);
+    }
+    return static_cast<float>(value);
+}
+
+void WinProbabilityTable::Save(std::filesystem::path const& path) const {
+    if (!IsOpen()) {
+        throw std::runtime_error("Win probability table is not open.");
+    }
+
+    FileHeader header {};
+    header.magic = kMagic;
+    header.version = kVersion;
+    header.rule_type = static_cast<std::uint8_t>(rule_type_);
+    header.max_ends_remaining = WinProbabilityKey::kMaxEndsRemaining;
+    header.max_score_difference = WinProbabilityKey::kMaxScoreDifference;
+    header.value_count = kValueCount;
+
+    std::error_code ec;
+    if (path.has_parent_path()) std::filesystem::create_directories(path.parent_path(), ec);
+
+    auto temp_path = path;
+    temp_path += ".tmp";
+    {
+        std::ofstream ofs(temp_path, std::ios::binary | std::ios::trunc);
+        ofs.write(reinterpret_cast<char const*>(&header), sizeof(header));
+        ofs.write(reinterpret_cast<char const*>(values_), static_cast<std::streamsize>(kValueCount * sizeof(std::uint16_t)));
+        if (!ofs) {
+            throw std::runtime_error("Failed to write " + temp_path.string());
+        }
+    }
+    std::filesystem::rename(temp_path, path, ec);
+    if (ec) {
+        throw std::runtime_error("Failed to write " + path.string() + ": " + ec.message());
+    }
+}
+
+WinProbabilityTable LoadOrBuildWinProbabilityTable(std::filesystem::path const& path, GameRuleType rule_type) {
+    std::error_code ec;
+    if (!path.empty() && std::filesystem::exists(path, ec)) {
+        try {
+            WinProbabilityTable table(path);
+            if (table.GetRuleType() == rule_type) return table;
+        } catch (std::exception const& e) {
+            AsyncLogger::GetInstance().Log(LogLevel::kWarning, "win", "%s", e.what());
+        }
+    }
+
+    auto table = WinProbabilityTable::Build(EndScoreDistribution::GetDefault(rule_type), rule_type);
+    if (!path.empty()) {
+        try {
+            table.Save(path);
+        } catch (std::exception const& e) {
+            AsyncLogger::GetInstance().Log(LogLevel::kWarning, "win", "%s", e.what());
+        }
+    }
+    return table;
+}
+
+} // namespace digitalcurling::client
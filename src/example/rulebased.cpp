@@ -1,7 +1,12 @@
 // Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
 // SPDX-License-Identifier: MIT
 
+#include "digitalcurling/client/async_logger.hpp"
 #include "digitalcurling/client/client_helpers.hpp"
+#include "digitalcurling/client/metrics.hpp"
+#include "digitalcurling/client/profiler.hpp"
+#include "digitalcurling/client/thinking_context.hpp"
+#include "digitalcurling/client/turn_arena.hpp"
 #include "rulebased.hpp"
 
 namespace digitalcurling::client {
@@ -13,37 +18,108 @@ std::vector<std::uint8_t> RulebasedEngine::OnInit(
     std::unique_ptr<simulators::ISimulatorFactory> simulator,
     std::vector<std::unique_ptr<players::IPlayerFactory>> const& players
 ) {
-    auto sim = simulator->CreateSimulator();
-    auto inv_sim = dynamic_cast<simulators::IInvertibleSimulator*>(sim.get());
-    if (inv_sim == nullptr) {
-        throw std::runtime_error("Simulator is not invertible simulator.");
-    }
+    // 前の試合のシミュレーターとプレイヤーを借りているものを先に破棄する
+    positioned_stone_decider_.reset();
+    endgame_solver_.reset();
+    simulator_ = SimulatorPool::Lease();
+    simulator_pool_.Clear();
+    player_pool_.Clear();
+
+    evaluator_ = CreateSimulationEvaluator(*simulator, game_setting.sheet_width);
+    // 粗いシミュレーターが設定されていれば、エンドゲームの候補をそれで絞り込む
+    multi_fidelity_ = std::make_unique<MultiFidelityEvaluator>(
+        *evaluator_, CreateScreeningSimulationEvaluator(*simulator, game_setting.sheet_width));
 
-    sim.release();
-    simulator_ = std::move(std::unique_ptr<simulators::IInvertibleSimulator>(inv_sim));
+    // ショットの計算に用いるシミュレーターは試合中ずっと借りる
+    simulator_factory_ = std::move(simulator);
+    simulator_pool_.Register(*simulator_factory_, 1);
+    simulator_ = simulator_pool_.Acquire(*simulator_factory_);
 
     game_rule_ = game_rule;
     game_setting_ = game_setting;
 
-    if (game_rule_.type == GameRuleType::kMixedDoubles) {
+    // プレイヤーは試合中に使い回すため、ここで生成しておく
+    // (ミックスダブルスでは配置済みストーンの選択が試合中ずっと借りる分も生成する)
+    bool const is_mixed_doubles = game_rule_.type == GameRuleType::kMixedDoubles;
+    for (auto const& player : players) {
+        player_pool_.Register(*player, is_mixed_doubles ? 2 : 1);
+    }
+
+    if (is_mixed_doubles) {
+        // 配置済みストーンの選択では、投球順の2人のプレイヤーでエンドを最後までプレイアウトする
+        std::vector<PlayerPool::Lease> md_players;
+        for (auto const& player : players) md_players.push_back(player_pool_.Acquire(*player));
+        positioned_stone_decider_ = std::make_unique<PositionedStoneDecider>(
+            game_rule_, game_setting_, *evaluator_, *simulator_, win_probability_, std::move(md_players),
+            PositionedStoneSetting::GetInstance().cache_path);
         return {0, 1};
-    } else {
+    }
+
+    // プレイヤーの誤差に応じて投球順を決める
+    try {
+        DeliveryOrderOptimizer optimizer(game_rule_, *evaluator_, *simulator_, DeliveryOrderSetting::GetInstance().cache_path);
+        return optimizer.Optimize(players).order;
+    } catch (std::exception const& e) {
+        AsyncLogger::GetInstance().Log(LogLevel::kWarning, "order", "%s", e.what());
         return {0, 1, 2, 3};
     }
 }
 
+void RulebasedEngine::OnWarmUp() {
+    evaluator_->WarmUp();
+    LoadOpeningBook();
+    win_probability_ = LoadOrBuildWinProbabilityTable(WinProbabilitySetting::GetInstance().path, game_rule_.type);
+
+    // テーブルを開けなくても、保存せずに解く
+    auto const& table_path = EndgameSolverSetting::GetInstance().table_path;
+    if (!table_path.empty()) {
+        try {
+            endgame_table_ = std::make_unique<EndgameTable>(table_path, game_setting_.sheet_width);
+        } catch (std::exception const& e) {
+            AsyncLogger::GetInstance().Log(LogLevel::kWarning, "endgame", "%s", e.what());
+        }
+    }
+    endgame_solver_ = std::make_unique<EndgameSolver>(
+        game_rule_, *evaluator_, *simulator_, endgame_table_.get(), &win_probability_, multi_fidelity_.get());
+}
+
+void RulebasedEngine::LoadOpeningBook() {
+    auto const& path = OpeningBookSetting::GetInstance().path;
+    if (path.empty() || !std::filesystem::exists(path)) return;
+
+    try {
+        OpeningBook book(path);
+        if (book.GetSheetWidth() != game_setting_.sheet_width) {
+            AsyncLogger::GetInstance().Log(LogLevel::kWarning, "book",
+                "Ignoring the opening book made for a different sheet width (%.3f m).", book.GetSheetWidth());
+            return;
+        }
+        opening_book_ = std::move(book);
+    } catch (std::exception const& e) {
+        AsyncLogger::GetInstance().Log(LogLevel::kWarning, "book", "%s", e.what());
+    }
+}
+
 void RulebasedEngine::OnGameStart(
     Team const& team,
     std::vector<std::pair<GameState, std::optional<moves::Shot>>> states
 ) {
     team_ = team;
+    power_play_used_ = false;
+    search_tree_.Clear();
 }
 void RulebasedEngine::OnNextEnd(GameState const& game_state) {
     // Nothing to do
 }
 
 IMixedDoublesThinkingEngine::PositionedStoneOptions RulebasedEngine::OnDecidePositionedStone(GameState const& game_state) {
-    return PositionedStoneOptions::kCenterHouse;
+    if (positioned_stone_decider_ == nullptr) return PositionedStoneOptions::kCenterHouse;
+
+    auto const option = positioned_stone_decider_->Decide(game_state, team_, !power_play_used_).option;
+    if (option == PositionedStoneOptions::kPowerPlayLeft || option == PositionedStoneOptions::kPowerPlayRight) {
+        power_play_used_ = true;
+    }
+    return option;
 }
 
 moves::Move RulebasedEngine::OnMyTurn(
@@ -51,6 +127,42 @@ moves::Move RulebasedEngine::OnMyTurn(
     GameState const& game_state,
     std::optional<moves::Shot> const& last_shot
 ) {
+    PROFILE_ZONE("RulebasedEngine::OnMyTurn");
+    auto* const context = ThinkingContext::GetCurrent();
+    AdvanceSearchTree(game_state, last_shot);
+
+    // 定石にある局面なら探索を行わない
+    if (auto entry = opening_book_.Find(game_state, team_)) {
+        if (context != nullptr) context->ReportEvaluation(entry->value);
+        return entry->GetShot();
+    }
+
+    // 思考が期限に間に合わない場合に備え、ティーへのドローを暫定の手として公開しておく
+    if (context != nullptr) {
+        context->Publish(simulator_->CalculateShot(coordinate::kTee, 0.f, -1.57f));
+    }
+    // 期限はこのターンの評価にのみ用い、戻る際に解除する
+    DeadlineScope const deadline_scope(*evaluator_, context != nullptr ? context->GetDeadline() : std::nullopt);
+
+    // エンドの最後の2投は全ての候補を評価して解く
+    auto const shots_remaining = GetShotsPerEnd(game_rule_.type) - game_state.shot;
+    if (endgame_solver_ != nullptr && shots_remaining <= EndgameSolver::kMaxShotsRemaining) {
+        // エンドの得点ではなく試合の勝率を最大化する
+        auto const situation = WinProbabilityKey::Create(game_state, team_, game_setting_.max_end);
+
+        auto current_player = player_pool_.Acquire(*player_factory);
+        auto result = endgame_solver_->Solve(
+            CompactBoard::FromStoneCoordinate(game_state.stones), team_, game_state.end, game_state.shot,
+            static_cast<std::uint8_t>(shots_remaining), *current_player, situation, &search_tree_);
+        if (result.has_value()) {
+            if (context != nullptr) context->ReportEvaluation(result->value);
+            return result->shot;
+        }
+        if (context != nullptr && context->IsCancelled()) {
+            return context->GetBest().value();
+        }
+    }
+
     auto sorted = game_state.stones.GetSortedIndex();
     if (sorted.size() > 0) {
         auto const& no1_stone = game_state.stones[sorted[0]].value();
@@ -65,31 +177,30 @@ moves::Move RulebasedEngine::OnMyTurn(
                     simulator_->CalculateShot(no1_stone.position, 3.f,  1.57f)
                 }};
 
-                auto current_player = player_factory->CreatePlayer();
-                auto stones = ConvertToSimulatorStones(game_state.stones);
-                auto stone_no = static_cast<std::uint8_t>(team_) * 8 + (game_state.shot / 2 + 1);
+                auto current_player = player_pool_.Acquire(*player_factory);
+                auto const board = CompactBoard::FromStoneCoordinate(game_state.stones);
+                auto stone_no = static_cast<std::uint8_t>(static_cast<std::uint8_t>(team_) * 8 + (game_state.shot / 2 + 1));
 
                 constexpr std::uint32_t kTrials = 50;
                 std::array<std::uint32_t, candidate_shots.size()> success_counts{{}};
 
+                // 誤差を加えたショットをまとめて評価器に渡す
+                auto jobs = MakeArenaVector<SimulationJob>(kTrials * candidate_shots.size());
                 for (std::uint32_t i = 0; i < kTrials; ++i) {
                     for (size_t j = 0; j < candidate_shots.size(); ++j) {
-                        auto temp_shot = current_player->Play(candidate_shots[j]);
-                        stones[stone_no] =
-                            simulators::ISimulator::StoneState(
-                                Vector2 { 0.f, 0.f }, 0.f, temp_shot.ToVector2(), temp_shot.angular_velocity
-                            );
-                        simulator_->SetStones(stones);
-
-                        SimulateFull(simulator_.get(), game_setting_.sheet_width);
-                        auto simulated_stones = GetStoneCoordinateFromSimulator(simulator_.get());
-                        auto violated_rule = game_rule_.VerifyShot(game_state.end, team_, game_state.stones, simulated_stones);
-
-                        if (!violated_rule.has_value()) {
-                            auto res_stone0 = simulated_stones[sorted[0]];
-                            if (res_stone0.has_value() && res_stone0.value().IsInHouse())
-                                success_counts[j]++;
-                        }
+                        jobs.push_back(SimulationJob::Create(board, stone_no, current_player->Play(candidate_shots[j])));
+                    }
+                }
+                evaluator_->Evaluate(jobs);
+
+                for (size_t k = 0; k < jobs.size(); ++k) {
+                    auto simulated_stones = jobs[k].board.ToStoneCoordinate();
+                    auto violated_rule = game_rule_.VerifyShot(game_state.end, team_, game_state.stones, simulated_stones);
+
+                    if (!violated_rule.has_value()) {
+                        auto res_stone0 = simulated_stones[sorted[0]];
+                        if (res_stone0.has_value() && res_stone0.value().IsInHouse())
+                            success_counts[k % candidate_shots.size()]++;
                     }
                 }
 
@@ -121,7 +232,23 @@ moves::Move RulebasedEngine::OnMyTurn(
     return simulator_->CalculateShot(coordinate::kTee, 0.f, -1.57f);
 }
 void RulebasedEngine::OnOpponentTurn(GameState const& game_state,std::optional<moves::Shot> const& last_shot) {
-    // Nothing to do
+    AdvanceSearchTree(game_state, last_shot);
+}
+
+void RulebasedEngine::AdvanceSearchTree(GameState const& game_state, std::optional<moves::Shot> const& last_shot) {
+    // 探索した子ノードがなければ、ルートを実際の盤面に置き換えるだけでよい
+    bool const has_searched = search_tree_.GetNodeCount() > 1;
+    auto const result = search_tree_.Advance(CompactBoard::FromStoneCoordinate(game_state.stones), last_shot);
+    if (!has_searched) return;
+
+    Metrics::GetInstance().carried_playouts.Add(result.carried_playouts);
+    if (result.reused) {
+        AsyncLogger::GetInstance().Log(LogLevel::kDebug, "tree",
+            "Carried over %llu playouts in %zu nodes (%.3f m from the searched outcome)",
+            static_cast<unsigned long long>(result.carried_playouts), result.carried_nodes, result.distance);
+    } else {
+        AsyncLogger::GetInstance().Log(LogLevel::kDebug, "tree", "No searched outcome matched the board; the tree was discarded");
+    }
 }
 
 void RulebasedEngine::OnGameOver(GameState const& game_state) {
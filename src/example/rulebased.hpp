@@ -3,8 +3,17 @@
 
 #pragma once
 
+#include "digitalcurling/client/delivery_order_optimizer.hpp"
+#include "digitalcurling/client/endgame_solver.hpp"
 #include "digitalcurling/client/i_factory_creator.hpp"
 #include "digitalcurling/client/i_thinking_engine.hpp"
+#include "digitalcurling/client/multi_fidelity_evaluator.hpp"
+#include "digitalcurling/client/object_pool.hpp"
+#include "digitalcurling/client/opening_book.hpp"
+#include "digitalcurling/client/positioned_stone_decider.hpp"
+#include "digitalcurling/client/search_tree.hpp"
+#include "digitalcurling/client/simulation_evaluator.hpp"
+#include "digitalcurling/client/win_probability_table.hpp"
 
 namespace digitalcurling::client {
 
@@ -25,6 +34,8 @@ public:
         std::vector<std::unique_ptr<players::IPlayerFactory>> const& players
     ) override;
 
+    virtual void OnWarmUp() override;
+
     virtual void OnGameStart(
         Team const& team,
         std::vector<std::pair<digitalcurling::GameState, std::optional<moves::Shot>>> states
@@ -49,7 +60,22 @@ private:
     Team team_;
     GameRule game_rule_;
     GameSetting game_setting_;
-    std::unique_ptr<simulators::IInvertibleSimulator> simulator_;
+    std::unique_ptr<simulators::ISimulatorFactory> simulator_factory_;
+    SimulatorPool simulator_pool_;
+    SimulatorPool::Lease simulator_;
+    PlayerPool player_pool_;
+    std::unique_ptr<ISimulationEvaluator> evaluator_;
+    std::unique_ptr<MultiFidelityEvaluator> multi_fidelity_;
+    OpeningBook opening_book_;
+    WinProbabilityTable win_probability_;
+    std::unique_ptr<EndgameTable> endgame_table_;
+    std::unique_ptr<EndgameSolver> endgame_solver_;
+    std::unique_ptr<PositionedStoneDecider> positioned_stone_decider_;
+    SearchTree<> search_tree_;
+    bool power_play_used_ = false;
+
+    void LoadOpeningBook();
+    void AdvanceSearchTree(GameState const& game_state, std::optional<moves::Shot> const& last_shot);
 };
 
 } // namespace digitalcurling::client
@@ -1,17 +1,36 @@
 // Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
 // SPDX-License-Identifier: Unlicense
 
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
 #include <memory>
 #include <iostream>
+#include <optional>
 #include <string>
 #include <string_view>
+#include <vector>
 #include <CLI/CLI.hpp>
+#include "digitalcurling/client/async_logger.hpp"
 #include "digitalcurling/client/client_factory.hpp"
 #include "digitalcurling/client/client_base.hpp"
+#include "digitalcurling/client/delivery_order_optimizer.hpp"
+#include "digitalcurling/client/endgame_solver.hpp"
 #include "digitalcurling/client/i_thinking_engine.hpp"
+#include "digitalcurling/client/metrics.hpp"
+#include "digitalcurling/client/opening_book.hpp"
+#include "digitalcurling/client/positioned_stone_decider.hpp"
+#include "digitalcurling/client/process_simulation_evaluator.hpp"
+#include "digitalcurling/client/profiler.hpp"
+#include "digitalcurling/client/remote_simulation_evaluator.hpp"
+#include "digitalcurling/client/simulation_evaluator.hpp"
+#include "digitalcurling/client/startup_pipeline.hpp"
+#include "digitalcurling/client/turn_arena.hpp"
+#include "digitalcurling/client/win_probability_table.hpp"
 
 #ifdef DIGITALCURLING_CLIENT_USE_LOADER
     #include <digitalcurling/plugins/plugin_manager.hpp>
+    #include "digitalcurling/plugins/plugin_directory_loader.hpp"
 #endif
 
 using namespace digitalcurling::client;
@@ -26,6 +45,8 @@ constexpr std::string_view PROGRESS_HEADER = "Game in progress...";
 
 int main(int argc, char const* argv[])
 {
+    auto const process_start = std::chrono::steady_clock::now();
+
     /* Command line arguments */
     const std::string app_text = "Digital Curling Client: " + std::string(CLIENT_NAME);
 
@@ -50,10 +71,83 @@ int main(int argc, char const* argv[])
 #ifdef DIGITALCURLING_CLIENT_USE_LOADER
     std::string plugin_dir;
     app.add_option("--plugin-dir", plugin_dir, "The directory to load plugins from")->check(CLI::ExistingDirectory);
+    bool is_lazy_plugin_load;
+    app.add_flag("--lazy-plugin-load", is_lazy_plugin_load, "Load only the plugins required by the match")->default_val(false)->force_callback();
+    std::size_t simulation_workers;
+    app.add_option("--simulation-workers", simulation_workers, "The number of simulation worker processes (0 to simulate in-process)")->default_val(0)->force_callback();
+    // ワーカープロセスとして起動する際の内部用オプション
+    std::string simulation_worker;
+    std::size_t simulation_worker_index;
+    app.add_option("--simulation-worker", simulation_worker)->group("");
+    app.add_option("--simulation-worker-index", simulation_worker_index)->default_val(0)->force_callback()->group("");
+    std::vector<std::string> simulation_nodes;
+    app.add_option("--simulation-nodes", simulation_nodes, "The URLs of simulation nodes to distribute simulations to");
+    double screening_seconds_per_frame;
+    app.add_option("--screening-seconds-per-frame", screening_seconds_per_frame, "The timestep of the coarse simulator used to screen candidates (0 to disable)")->default_val(0.)->check(CLI::Range(0., 0.1))->force_callback();
+    bool is_simulation_node;
+    app.add_flag("--simulation-node", is_simulation_node, "Run as a simulation node instead of a client")->default_val(false)->force_callback();
+    int node_port;
+    app.add_option("--port", node_port, "The port to listen on as a simulation node")->default_val(10000)->check(CLI::Range(1,65535))->force_callback();
+    std::string node_bind;
+    app.add_option("--bind", node_bind, "The address to listen on as a simulation node (the node has no authentication)")->default_str("127.0.0.1")->force_callback();
+    bool is_build_opening_book;
+    app.add_flag("--build-opening-book", is_build_opening_book, "Build the opening book for the match instead of playing")->default_val(false)->force_callback();
+    std::string opening_book_positions;
+    app.add_option("--opening-book-positions", opening_book_positions, "The JSON file of positions to add to the opening book")->check(CLI::ExistingFile);
+#endif
+    std::string cache_dir;
+    app.add_option("--cache-dir", cache_dir, "The directory to store cache files")->default_str("./cache")->force_callback();
+    std::string opening_book;
+    app.add_option("--opening-book", opening_book, "The opening book file (default: <cache-dir>/opening_book.bin)");
+    std::string log_file;
+    app.add_option("--log-file", log_file, "The file to write logs to");
+    bool is_free_path;
+    app.add_flag("--free-path", is_free_path, "Predict shots that cannot touch another stone from a trajectory table instead of simulating them (slightly changes results)")->default_val(false)->force_callback();
+    bool is_checkpoints;
+    app.add_flag("--checkpoints", is_checkpoints, "Start simulations from the interpolated state just before the first possible contact (slightly changes results)")->default_val(false)->force_callback();
+    int metrics_port;
+    app.add_option("--metrics-port", metrics_port, "The local port to serve metrics on (0 to disable)")->default_val(0)->check(CLI::Range(0,65535))->force_callback();
+#ifdef DIGITALCURLING_CLIENT_ENABLE_PROFILER
+    std::string profile_output;
+    app.add_option("--profile-output", profile_output, "The file to write the Chrome trace of profiled zones to on game over");
+    bool is_profile_counters;
+    app.add_flag("--profile-counters", is_profile_counters, "Record hardware counters for each profiled zone (Linux only)")->default_val(false)->force_callback();
 #endif
 
     CLI11_PARSE(app, argc, argv);
 
+    // ワーカープロセスと評価ノードもクライアントと同じ方法で評価する
+    SimulationEvaluatorSetting::GetInstance().free_path = is_free_path;
+    SimulationEvaluatorSetting::GetInstance().checkpoints = is_checkpoints;
+
+#ifdef DIGITALCURLING_CLIENT_USE_LOADER
+    // シミュレーターのプラグインのみを読み込み、ファクトリーを生成する
+    auto const create_simulator_factory = [&](nlohmann::json const& json) {
+        if (!plugin_dir.empty()) {
+            using digitalcurling::plugins::PluginDirectoryLoader;
+            PluginDirectoryLoader loader(plugin_dir, std::filesystem::path(cache_dir) / "plugin_manifest.json");
+            loader.LoadRequired({{ digitalcurling::plugins::PluginType::simulator, json.at("type").get<std::string>() }});
+        }
+        return CreateFactoryCreator()->CreateSimulatorFactory(json);
+    };
+
+    if (!simulation_worker.empty()) {
+        // 親プロセスからのジョブを処理する
+        return ProcessSimulationEvaluator::RunWorker(simulation_worker, simulation_worker_index, create_simulator_factory);
+    }
+
+    if (is_simulation_node) {
+        // 他のマシンのクライアントからのジョブを処理する
+        if (app.count("--plugin-dir") == 0 && std::filesystem::is_directory("./plugins")) {
+            plugin_dir = "./plugins";
+        }
+        AsyncLogger::GetInstance().SetConsoleLevel(is_debug ? LogLevel::kDebug : LogLevel::kInfo);
+        auto const exit_code = RemoteSimulationEvaluator::RunNode(node_bind, node_port, create_simulator_factory);
+        AsyncLogger::GetInstance().Flush();
+        return exit_code;
+    }
+#endif
+
     if (host.empty() || id.empty()) {
         if (is_enable_console) {
             if (host.empty()) {
@@ -77,54 +171,186 @@ int main(int argc, char const* argv[])
         std::cout << "[Debug] Debug mode enabled." << std::endl;
     }
 
-#ifdef DIGITALCURLING_CLIENT_USE_LOADER
-    /* Load plugins */
-    std::cout << "Loading plugins ... ";
+    // 試合中の出力はイベント処理をブロックしないよう、非同期ロガーを経由する
+    auto& logger = AsyncLogger::GetInstance();
+    logger.SetConsoleLevel(is_debug ? LogLevel::kDebug : LogLevel::kInfo);
+    if (!log_file.empty()) {
+        try {
+            logger.OpenFile(log_file);
+        } catch (const std::exception& e) {
+            std::cerr << "[Error] " << e.what() << std::endl;
+            return 1;
+        }
+    }
+
+#ifdef DIGITALCURLING_CLIENT_ENABLE_PROFILER
+    if (!profile_output.empty()) {
+        Profiler::Start(is_profile_counters);
+    }
+#endif
+
+    MetricsServer metrics_server;
+    if (metrics_port != 0) {
+        try {
+            metrics_server.Start("127.0.0.1", metrics_port);
+            std::cout << "Metrics: http://127.0.0.1:" << metrics_port << "/metrics\n" << std::endl;
+        } catch (const std::exception& e) {
+            std::cerr << "[Error] " << e.what() << std::endl;
+            return 1;
+        }
+    }
 
+    /* Startup */
+    // ステップが参照する変数は pipeline より先に宣言する
+    auto const endpoint_cache = std::filesystem::path(cache_dir) / "endpoints.json";
+    std::optional<MatchEndpoint> endpoint;
+    std::unique_ptr<ClientBase> client;
+    digitalcurling::Team team = digitalcurling::Team::kInvalid;
+#ifdef DIGITALCURLING_CLIENT_USE_LOADER
     std::string player_plugins = "", simulator_plugins = "";
-    int loaded = 0;
-
-    // check static loaded plugins
-    auto manager = &digitalcurling::plugins::PluginManager::GetInstance();
-    auto ids = manager->GetLoadedPlugins();
-    for (const auto& id : ids) {
-        if (id.type == digitalcurling::plugins::PluginType::player) {
-            if (!player_plugins.empty()) player_plugins += ", ";
-            player_plugins += id.name + "(static)";
-        } else if (id.type == digitalcurling::plugins::PluginType::simulator) {
-            if (!simulator_plugins.empty()) simulator_plugins += ", ";
-            simulator_plugins += id.name + "(static)";
+    std::vector<std::pair<std::filesystem::path, std::string>> plugin_errors;
+    bool has_plugin_dir = app.count("--plugin-dir") > 0 ||
+        (std::filesystem::exists((plugin_dir = "./plugins")) && std::filesystem::is_directory(plugin_dir));
+
+    auto& evaluator_setting = SimulationEvaluatorSetting::GetInstance();
+    evaluator_setting.worker_process_count = simulation_workers;
+    evaluator_setting.remote_nodes = simulation_nodes;
+    evaluator_setting.screening_seconds_per_frame = screening_seconds_per_frame;
+    evaluator_setting.worker_arguments = { "--cache-dir", cache_dir };
+    if (has_plugin_dir) {
+        evaluator_setting.worker_arguments.insert(evaluator_setting.worker_arguments.end(), { "--plugin-dir", plugin_dir });
+    }
+#endif
+    OpeningBookSetting::GetInstance().path = opening_book.empty()
+        ? std::filesystem::path(cache_dir) / "opening_book.bin"
+        : std::filesystem::path(opening_book);
+    EndgameSolverSetting::GetInstance().table_path = std::filesystem::path(cache_dir) / "endgame_table.bin";
+    WinProbabilitySetting::GetInstance().path = std::filesystem::path(cache_dir) / "win_probability.bin";
+    PositionedStoneSetting::GetInstance().cache_path = std::filesystem::path(cache_dir) / "positioned_stone.json";
+    DeliveryOrderSetting::GetInstance().cache_path = std::filesystem::path(cache_dir) / "delivery_order.json";
+
+#ifdef DIGITALCURLING_CLIENT_USE_LOADER
+    if (is_build_opening_book) {
+        // 試合の設定 (ルール、シミュレーター、プレイヤー) で定石を作成する
+        try {
+            auto const match = ClientFactory::GetMatch(host, id, endpoint_cache);
+            if (has_plugin_dir) {
+                using digitalcurling::plugins::PluginDirectoryLoader;
+                PluginDirectoryLoader loader(plugin_dir, std::filesystem::path(cache_dir) / "plugin_manifest.json");
+                loader.LoadRequired(PluginDirectoryLoader::GetRequiredPlugins(match.match_info));
+            }
+
+            auto positions = GetDefaultOpeningBookPositions(match.match_info.rule.type);
+            if (!opening_book_positions.empty()) {
+                auto loaded = LoadOpeningBookPositions(opening_book_positions);
+                positions.insert(positions.end(), loaded.begin(), loaded.end());
+            }
+            if (positions.empty()) {
+                throw std::runtime_error("No positions to build the opening book from. Use --opening-book-positions.");
+            }
+
+            BuildOpeningBook(match.match_info, *CreateFactoryCreator(), positions, OpeningBookSetting::GetInstance().path);
+        } catch (const std::exception& e) {
+            logger.Flush();
+            std::cerr << "[Error] " << e.what() << std::endl;
+            return 1;
         }
-        loaded++;
+        logger.Flush();
+        return 0;
     }
+#endif
+    StartupPipeline pipeline(process_start);
 
-    // load file from plugin_dir
-    if (app.count("--plugin-dir") > 0 ||
-        (std::filesystem::exists((plugin_dir = "./plugins")) && std::filesystem::is_directory(plugin_dir))) {
-        for (const auto& entry : std::filesystem::directory_iterator(plugin_dir)) {
-            if (entry.is_regular_file()) {
-                try {
-                    auto result = manager->LoadPlugin(entry.path(), false);
-                    if (result.has_value()) {
-                        if (result->type == digitalcurling::plugins::PluginType::player) {
-                            if (!player_plugins.empty()) player_plugins += ", ";
-                            player_plugins += result->name;
-                        } else if (result->type == digitalcurling::plugins::PluginType::simulator) {
-                            if (!simulator_plugins.empty()) simulator_plugins += ", ";
-                            simulator_plugins += result->name;
-                        }
-                        loaded++;
-                    }
-                } catch (const std::exception& e) {
-                    std::cerr << "[Error] Failed to load plugin from " << entry.path() << ": " << e.what() << std::endl;
+    pipeline.AddStep("fetch_match", {}, [&]() {
+        endpoint = ClientFactory::GetMatch(host, id, endpoint_cache);
+    });
+#ifdef DIGITALCURLING_CLIENT_USE_LOADER
+    // 遅延読み込みでなければ、プラグインの読み込みと試合情報の取得を並行して行う
+    std::vector<std::string> plugin_dependencies;
+    if (is_lazy_plugin_load) plugin_dependencies.push_back("fetch_match");
+
+    pipeline.AddStep("load_plugins", plugin_dependencies, [&]() {
+        int loaded = 0;
+
+        // check static loaded plugins
+        auto manager = &digitalcurling::plugins::PluginManager::GetInstance();
+        auto ids = manager->GetLoadedPlugins();
+        for (const auto& id : ids) {
+            if (id.type == digitalcurling::plugins::PluginType::player) {
+                if (!player_plugins.empty()) player_plugins += ", ";
+                player_plugins += id.name + "(static)";
+            } else if (id.type == digitalcurling::plugins::PluginType::simulator) {
+                if (!simulator_plugins.empty()) simulator_plugins += ", ";
+                simulator_plugins += id.name + "(static)";
+            }
+            loaded++;
+        }
+
+        // load file from plugin_dir
+        if (has_plugin_dir) {
+            using digitalcurling::plugins::PluginDirectoryLoader;
+            PluginDirectoryLoader loader(plugin_dir, std::filesystem::path(cache_dir) / "plugin_manifest.json");
+            auto result = is_lazy_plugin_load
+                ? loader.LoadRequired(PluginDirectoryLoader::GetRequiredPlugins(endpoint->match_info))
+                : loader.LoadAll();
+
+            plugin_errors = std::move(result.errors);
+            for (const auto& plugin : result.loaded) {
+                if (plugin.type == digitalcurling::plugins::PluginType::player) {
+                    if (!player_plugins.empty()) player_plugins += ", ";
+                    player_plugins += plugin.name;
+                } else if (plugin.type == digitalcurling::plugins::PluginType::simulator) {
+                    if (!simulator_plugins.empty()) simulator_plugins += ", ";
+                    simulator_plugins += plugin.name;
                 }
+                loaded++;
             }
         }
+
+        if (loaded == 0) {
+            throw std::runtime_error("No plugins loaded. The client cannot function properly.");
+        }
+    });
+    pipeline.AddStep("create_client", { "fetch_match", "load_plugins" }, [&]() {
+#else
+    pipeline.AddStep("create_client", { "fetch_match" }, [&]() {
+#endif
+        std::unique_ptr<IFactoryCreator> factory_creator = CreateFactoryCreator();
+        std::unique_ptr<IThinkingEngine> engine = CreateThinkingEngine();
+        client = ClientFactory::CreateClient(std::move(endpoint.value()), std::move(engine), std::move(factory_creator));
+    });
+    // 思考エンジンの準備処理は、試合への参加とサーバーへの接続と並行して行う
+    pipeline.AddStep("join_game", { "create_client" }, [&]() {
+        team = client->JoinGame(static_cast<digitalcurling::Team>(team_idx), auth_id, auth_pw);
+    });
+    pipeline.AddStep("warm_up", { "create_client" }, [&]() {
+        client->WarmUp();
+    });
+
+    try {
+        std::cout << "Fetching match ... ";
+        pipeline.Wait("fetch_match");
+        std::cout << "OK" << std::endl;
+    } catch (const std::exception& e) {
+        std::cout << "ERROR" << std::endl;
+        std::cerr << "[Error] " << e.what() << std::endl;
+        return 1;
     }
 
-    if (loaded == 0) {
+#ifdef DIGITALCURLING_CLIENT_USE_LOADER
+    /* Load plugins */
+    std::cout << "Loading plugins ... ";
+    try {
+        pipeline.Wait("load_plugins");
+        for (const auto& [path, message] : plugin_errors) {
+            std::cerr << "[Error] Failed to load plugin from " << path << ": " << message << std::endl;
+        }
+    } catch (const std::exception& e) {
         std::cout << "ERROR" << std::endl;
-        std::cerr << "[Error] No plugins loaded. The client cannot function properly." << std::endl;
+        for (const auto& [path, message] : plugin_errors) {
+            std::cerr << "[Error] Failed to load plugin from " << path << ": " << message << std::endl;
+        }
+        std::cerr << "[Error] " << e.what() << std::endl;
         return 1;
     }
 
@@ -135,54 +361,93 @@ int main(int argc, char const* argv[])
         << std::endl;
 #endif
 
-    std::unique_ptr<ClientBase> client;
     try {
         std::cout << "Creating client ... ";
-        std::unique_ptr<IFactoryCreator> factory_creator = CreateFactoryCreator();
-        std::unique_ptr<IThinkingEngine> engine = CreateThinkingEngine();
-        client = ClientFactory::CreateClient(host, id, std::move(engine), std::move(factory_creator));
+        pipeline.Wait("create_client");
         std::cout << "OK" << std::endl;
 
         std::cout << "Joining game ... ";
-        auto team = client->JoinGame(static_cast<digitalcurling::Team>(team_idx), auth_id, auth_pw);
+        pipeline.Wait("join_game");
         std::cout << "OK\n\n[Game Info]\n"
             << "  Host: " << host << "\n"
             << "  Game ID: " << id << "\n"
             << "  Team: " << digitalcurling::ToString(team) << "\n"
             << std::endl;
 
-        std::cout << "Connecting to server ... ";
+        std::cout << "Connecting to server ... " << std::flush;
 
-        auto update_log = [](StateUpdateEventData const& event_data) {
-            printf(
-                "\033[1A\033[%zdG\033[K (end %d, shot %d)",
+        auto update_log = [is_debug, &logger](StateUpdateEventData const& event_data) {
+            char arena_info[96] = "";
+            if (is_debug) {
+                // 更新イベントの時点で次のターンは始まっているため、前のターンの値を表示する
+                auto arena = TurnArena::GetPreviousTurnStatistics();
+                std::snprintf(arena_info, sizeof(arena_info),
+                    " [last turn arena: %llu allocs, %llu bytes, %llu heap allocs]",
+                    static_cast<unsigned long long>(arena.allocations),
+                    static_cast<unsigned long long>(arena.allocated_bytes),
+                    static_cast<unsigned long long>(arena.upstream_allocations)
+                );
+            }
+            logger.Log(LogLevel::kInfo, "progress",
+                "\033[1A\033[%zuG\033[K (end %d, shot %d)%s",
                 PROGRESS_HEADER.size() + 1,
                 event_data.game_state.end + 1,
-                event_data.total_shot_number
+                event_data.total_shot_number,
+                arena_info
             );
-            std::cout << std::endl;
         };
 
         ClientConnectSetting setting;
+        setting.ready = pipeline.GetFuture("warm_up");
+
+        bool is_first_connection = true;
         auto user_callback = GetCallback();
         setting.callback = {
-            [&user_callback]() { // on_connected
-                std::cout << "OK\n" << PROGRESS_HEADER << " (end 1, shot 0)" << std::endl;
+            [&user_callback, &pipeline, &is_first_connection, &logger]() { // on_connected
+                if (is_first_connection) {
+                    // 準備処理の完了後に呼び出されるため、ここで最初のターンの準備が整う
+                    is_first_connection = false;
+                    logger.Log(LogLevel::kInfo, "client", "OK (ready in %lld ms)",
+                        static_cast<long long>(pipeline.GetElapsed().count()));
+
+                    // ログのメッセージは固定長で切り捨てられるため、ステップごとに出力する
+                    for (const auto& timing : pipeline.GetTimings()) {
+                        logger.Log(LogLevel::kDebug, "client", "Startup step %s (%lld-%lld ms)", timing.name.c_str(),
+                            static_cast<long long>(timing.start.count()), static_cast<long long>(timing.end.count()));
+                    }
+                } else {
+                    logger.Log(LogLevel::kInfo, "client", "OK");
+                }
+                logger.Log(LogLevel::kInfo, "progress", "%s (end 1, shot 0)", PROGRESS_HEADER.data());
                 if (user_callback.on_connected) user_callback.on_connected();
             },
-            [&user_callback, &update_log](StateUpdateEventData const& event_data) { // on_latest_state_update
+            [&](StateUpdateEventData const& event_data) { // on_latest_state_update
                 update_log(event_data);
+#ifdef DIGITALCURLING_CLIENT_ENABLE_PROFILER
+                if (event_data.game_state.IsGameOver() && !profile_output.empty()) {
+                    try {
+                        Profiler::WriteChromeTrace(profile_output);
+                        logger.Log(LogLevel::kInfo, "client", "Profile written to %s", profile_output.c_str());
+                    } catch (const std::exception& e) {
+                        logger.Log(LogLevel::kWarning, "client", "%s", e.what());
+                    }
+                }
+#endif
                 if (user_callback.on_latest_state_update) user_callback.on_latest_state_update(event_data);
             },
             [&user_callback, &update_log](StateUpdateEventData const& event_data) { // on_state_update
                 update_log(event_data);
                 if (user_callback.on_state_update) user_callback.on_state_update(event_data);
             },
-            [is_debug, &user_callback](std::runtime_error const& e) { // on_event_process_error
-                std::cout << "[Error] " << e.what() << std::endl;
-                if (user_callback.on_event_process_error && user_callback.on_event_process_error(e)) {
-                    std::cout << PROGRESS_HEADER << std::endl;
-                    return true;
+            [&user_callback, &logger](std::runtime_error const& e) { // on_event_process_error
+                logger.Log(LogLevel::kError, "client", "%s", e.what());
+                if (user_callback.on_event_process_error) {
+                    // ユーザーのコールバックは標準入出力を使用するため、先に出力を済ませておく
+                    logger.Flush();
+                    if (user_callback.on_event_process_error(e)) {
+                        logger.Log(LogLevel::kInfo, "progress", "%s", PROGRESS_HEADER.data());
+                        return true;
+                    }
                 }
                 return false;
             }
@@ -190,8 +455,10 @@ int main(int argc, char const* argv[])
 
         client->Connect(setting);
     } catch (const std::exception& e) {
+        logger.Flush();
         std::cerr << "[Error] " << e.what() << std::endl;
         return 1;
     }
+    logger.Flush();
     return 0;
 }
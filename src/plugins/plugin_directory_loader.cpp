@@ -0,0 +1,236 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: Unlicense
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <future>
+#include <random>
+#include <nlohmann/json.hpp>
+#include "digitalcurling/plugins/plugin_directory_loader.hpp"
+#include "digitalcurling/plugins/plugin_registry.hpp"
+
+namespace digitalcurling::plugins {
+
+namespace {
+
+std::string ToString(PluginType type) {
+    return type == PluginType::player ? "player" : "simulator";
+}
+PluginType ToPluginType(std::string const& str) {
+    if (str == "player") return PluginType::player;
+    if (str == "simulator") return PluginType::simulator;
+    throw std::runtime_error("Unknown plugin type: " + str);
+}
+
+std::pair<std::uintmax_t, std::int64_t> GetFileStamp(std::filesystem::path const& path) {
+    std::error_code ec;
+    auto size = std::filesystem::file_size(path, ec);
+    if (ec) return { 0, 0 };
+    auto mtime = std::filesystem::last_write_time(path, ec);
+    if (ec) return { size, 0 };
+    return { size, static_cast<std::int64_t>(mtime.time_since_epoch().count()) };
+}
+
+/// @brief ファイルを読み捨て、OS のページキャッシュに載せる
+void WarmFile(std::filesystem::path const& path) {
+    std::ifstream ifs(path, std::ios::binary);
+    std::array<char, 1 << 16> buffer;
+    while (ifs.read(buffer.data(), buffer.size())) {}
+}
+
+} // namespace
+
+PluginDirectoryLoader::PluginDirectoryLoader(
+    std::filesystem::path plugin_dir,
+    std::optional<std::filesystem::path> manifest_path
+) : plugin_dir_(std::move(plugin_dir)),
+    manifest_path_(std::move(manifest_path))
+{
+    LoadManifest();
+}
+
+PluginDirectoryLoader::Result PluginDirectoryLoader::LoadAll() {
+    Result result;
+    LoadFiles(GetPluginFiles(), result);
+    SaveManifest();
+    return result;
+}
+
+PluginDirectoryLoader::Result PluginDirectoryLoader::LoadRequired(std::vector<PluginEntry> const& required) {
+    auto& manager = PluginManager::GetInstance();
+
+    std::vector<PluginEntry> pending;
+    for (auto const& plugin : required) {
+        if (!manager.IsPluginLoaded(plugin.type, plugin.name)) pending.push_back(plugin);
+    }
+
+    // マニフェストから提供元のファイルを探す
+    std::vector<std::filesystem::path> files;
+    bool has_unresolved = false;
+    for (auto const& plugin : pending) {
+        auto it = std::find_if(manifest_.begin(), manifest_.end(), [&](ManifestEntry const& entry) {
+            return entry.plugin.has_value() && entry.plugin->type == plugin.type && entry.plugin->name == plugin.name
+                && FindManifestEntry(plugin_dir_ / entry.file) == &entry;
+        });
+        if (it != manifest_.end()) {
+            files.push_back(plugin_dir_ / it->file);
+        } else {
+            has_unresolved = true;
+        }
+    }
+
+    // 提供元が分からないプラグインがあれば、マニフェストに無いファイルを全て探索する
+    if (has_unresolved) {
+        for (auto const& path : GetPluginFiles()) {
+            if (FindManifestEntry(path) == nullptr) files.push_back(path);
+        }
+    }
+    std::sort(files.begin(), files.end());
+    files.erase(std::unique(files.begin(), files.end()), files.end());
+
+    Result result;
+    LoadFiles(files, result);
+    SaveManifest();
+
+    for (auto const& plugin : pending) {
+        if (!manager.IsPluginLoaded(plugin.type, plugin.name)) {
+            result.errors.emplace_back(plugin_dir_, ToString(plugin.type) + " plugin not found: " + plugin.name);
+        }
+    }
+    return result;
+}
+
+std::vector<PluginEntry> PluginDirectoryLoader::GetRequiredPlugins(client::MatchInfo const& match_info) {
+    std::vector<PluginEntry> required;
+    auto add = [&required](PluginType type, std::string name) {
+        auto it = std::find_if(required.begin(), required.end(), [&](PluginEntry const& e) {
+            return e.type == type && e.name == name;
+        });
+        if (it == required.end()) required.push_back(PluginEntry { type, std::move(name) });
+    };
+
+    add(PluginType::simulator, match_info.simulator.at("type").get<std::string>());
+    for (auto const& player : match_info.players) {
+        add(PluginType::player, player.at("type").get<std::string>());
+    }
+    return required;
+}
+
+void PluginDirectoryLoader::LoadManifest() {
+    manifest_.clear();
+    if (!manifest_path_.has_value() || !std::filesystem::exists(*manifest_path_)) return;
+
+    try {
+        std::ifstream ifs(*manifest_path_);
+        auto json = nlohmann::json::parse(ifs);
+        for (auto const& j : json.at("files")) {
+            ManifestEntry entry {
+                j.at("file").get<std::string>(),
+                j.at("size").get<std::uintmax_t>(),
+                j.at("mtime").get<std::int64_t>(),
+                std::nullopt
+            };
+            if (!j.at("type").is_null()) {
+                entry.plugin = PluginEntry { ToPluginType(j.at("type").get<std::string>()), j.at("name").get<std::string>() };
+            }
+            manifest_.push_back(std::move(entry));
+        }
+    } catch (std::exception const&) {
+        // 壊れたマニフェストは破棄してディレクトリを探索し直す
+        manifest_.clear();
+    }
+}
+
+void PluginDirectoryLoader::SaveManifest() const {
+    if (!manifest_path_.has_value()) return;
+
+    nlohmann::json files = nlohmann::json::array();
+    for (auto const& entry : manifest_) {
+        files.push_back({
+            { "file", entry.file },
+            { "size", entry.size },
+            { "mtime", entry.mtime },
+            { "type", entry.plugin.has_value() ? nlohmann::json(ToString(entry.plugin->type)) : nlohmann::json(nullptr) },
+            { "name", entry.plugin.has_value() ? nlohmann::json(entry.plugin->name) : nlohmann::json(nullptr) }
+        });
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(manifest_path_->parent_path(), ec);
+
+    // ワーカープロセスや評価ノードも同じマニフェストを同時に書き換えるため、
+    // プロセスごとの一時ファイルに書き込んでから置き換える
+    auto temp_path = *manifest_path_;
+    temp_path += ".tmp" + std::to_string(std::random_device {}());
+    {
+        std::ofstream ofs(temp_path);
+        if (!ofs) return;
+        ofs << nlohmann::json { { "files", files } }.dump(2);
+        if (!ofs) {
+            ofs.close();
+            std::filesystem::remove(temp_path, ec);
+            return;
+        }
+    }
+    std::filesystem::rename(temp_path, *manifest_path_, ec);
+    if (ec) std::filesystem::remove(temp_path, ec);
+}
+
+PluginDirectoryLoader::ManifestEntry const* PluginDirectoryLoader::FindManifestEntry(std::filesystem::path const& path) const {
+    auto const file = path.filename().string();
+    auto const [size, mtime] = GetFileStamp(path);
+    for (auto const& entry : manifest_) {
+        if (entry.file == file && entry.size == size && entry.mtime == mtime) return &entry;
+    }
+    return nullptr;
+}
+
+std::vector<std::filesystem::path> PluginDirectoryLoader::GetPluginFiles() const {
+    std::vector<std::filesystem::path> files;
+    if (!std::filesystem::is_directory(plugin_dir_)) return files;
+
+    for (auto const& entry : std::filesystem::directory_iterator(plugin_dir_)) {
+        if (entry.is_regular_file()) files.push_back(entry.path());
+    }
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+void PluginDirectoryLoader::LoadFiles(std::vector<std::filesystem::path> const& files, Result& result) {
+    // 互いに独立なファイルの読み込みは並行して行う。`dlopen` は動的リンカのロックで直列化され、
+    // `PluginManager` への登録もスレッドセーフであることが保証されていないため、その後の読み込みと登録は逐次に行う
+    if (files.size() > 1) {
+        std::vector<std::future<void>> warms;
+        warms.reserve(files.size());
+        for (auto const& path : files) warms.push_back(std::async(std::launch::async, WarmFile, path));
+        for (auto& warm : warms) warm.get();
+    }
+
+    auto& manager = PluginManager::GetInstance();
+    for (auto const& path : files) {
+        auto const file = path.filename().string();
+        auto const [size, mtime] = GetFileStamp(path);
+        ManifestEntry entry { file, size, mtime, std::nullopt };
+
+        try {
+            auto loaded = manager.LoadPlugin(path, false);
+            if (loaded.has_value()) {
+                entry.plugin = PluginEntry { loaded->type, loaded->name };
+                result.loaded.push_back(*entry.plugin);
+            }
+        } catch (std::exception const& e) {
+            result.errors.emplace_back(path, e.what());
+        }
+
+        manifest_.erase(std::remove_if(manifest_.begin(), manifest_.end(), [&](ManifestEntry const& e) {
+            return e.file == file;
+        }), manifest_.end());
+        manifest_.push_back(std::move(entry));
+    }
+
+    // 読み込んだプラグインを索引に反映させる
+    if (!result.loaded.empty()) PluginRegistry::Invalidate();
+}
+
+} // namespace digitalcurling::plugins
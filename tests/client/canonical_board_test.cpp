@@ -0,0 +1,86 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: Unlicense
+
+#include <gtest/gtest.h>
+#include "digitalcurling/client/canonical_board.hpp"
+
+namespace digitalcurling::client {
+namespace {
+
+/// @brief センターラインについて非対称な盤面を返す
+CompactBoard MakeAsymmetricBoard() {
+    CompactBoard board;
+    board.SetStone(0, Vector2(0.42f, coordinate::kTee.y + 0.3f));
+    board.SetStone(3, Vector2(-1.1f, coordinate::kTee.y - 2.5f));
+    board.SetStone(9, Vector2(0.05f, coordinate::kTee.y));
+    board.SetStone(12, Vector2(-0.7f, coordinate::kTee.y + 1.2f));
+    return board;
+}
+
+TEST(CanonicalBoardTest, MirrorTwiceRestoresBoard) {
+    auto const board = MakeAsymmetricBoard();
+    EXPECT_EQ(MirrorBoard(MirrorBoard(board)), board);
+    EXPECT_NE(MirrorBoard(board), board);
+
+    auto const canonical = CanonicalBoard::CreateUnmirrored(board, Team::k0);
+    EXPECT_EQ(canonical.Mirror().Mirror(), canonical);
+    EXPECT_NE(canonical.Mirror(), canonical);
+}
+
+TEST(CanonicalBoardTest, MirrorShotTwiceRestoresShot) {
+    moves::Shot const shot(2.31f, -0.5f, 0.03f);
+    auto const mirrored = MirrorShot(shot);
+    EXPECT_EQ(mirrored.translational_velocity, shot.translational_velocity);
+    EXPECT_EQ(mirrored.angular_velocity, -shot.angular_velocity);
+    EXPECT_EQ(mirrored.release_angle, -shot.release_angle);
+
+    auto const restored = MirrorShot(mirrored);
+    EXPECT_EQ(restored.translational_velocity, shot.translational_velocity);
+    EXPECT_EQ(restored.angular_velocity, shot.angular_velocity);
+    EXPECT_EQ(restored.release_angle, shot.release_angle);
+}
+
+TEST(CanonicalBoardTest, CreateIsInvariantToMirroredInput) {
+    auto const board = MakeAsymmetricBoard();
+    bool is_mirrored = false;
+    bool is_input_mirrored = false;
+    auto const canonical = CanonicalBoard::Create(board, Team::k0, &is_mirrored);
+    auto const from_mirrored = CanonicalBoard::Create(MirrorBoard(board), Team::k0, &is_input_mirrored);
+
+    EXPECT_EQ(from_mirrored, canonical);
+    EXPECT_EQ(from_mirrored.GetHash(), canonical.GetHash());
+    // 非対称な盤面では、どちらか一方のみが反転される
+    EXPECT_NE(is_mirrored, is_input_mirrored);
+
+    auto const unmirrored = CanonicalBoard::CreateUnmirrored(board, Team::k0);
+    EXPECT_EQ(is_mirrored ? unmirrored.Mirror() : unmirrored, canonical);
+}
+
+TEST(CanonicalBoardTest, CreateIgnoresStoneIndicesAndTeamNumbers) {
+    auto const board = MakeAsymmetricBoard();
+
+    // 同じ配置をチームとインデックスを入れ替えて置く
+    CompactBoard swapped;
+    swapped.SetStone(15, board.GetPosition(0));
+    swapped.SetStone(8, board.GetPosition(3));
+    swapped.SetStone(1, board.GetPosition(9));
+    swapped.SetStone(6, board.GetPosition(12));
+
+    EXPECT_EQ(CanonicalBoard::Create(swapped, Team::k1), CanonicalBoard::Create(board, Team::k0));
+    EXPECT_NE(CanonicalBoard::Create(swapped, Team::k0), CanonicalBoard::Create(board, Team::k0));
+}
+
+TEST(CanonicalBoardTest, DoesNotMirrorSymmetricBoard) {
+    CompactBoard board;
+    board.SetStone(0, Vector2(0.5f, coordinate::kTee.y));
+    board.SetStone(1, Vector2(-0.5f, coordinate::kTee.y));
+    board.SetStone(8, Vector2(0.f, coordinate::kTee.y - 2.f));
+
+    bool is_mirrored = true;
+    auto const canonical = CanonicalBoard::Create(board, Team::k0, &is_mirrored);
+    EXPECT_FALSE(is_mirrored);
+    EXPECT_EQ(canonical.Mirror(), canonical);
+}
+
+} // namespace
+} // namespace digitalcurling::client
@@ -0,0 +1,97 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: Unlicense
+
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <gtest/gtest.h>
+#include "digitalcurling/client/endgame_solver.hpp"
+
+namespace digitalcurling::client {
+namespace {
+
+class EndgameTableTest : public ::testing::Test {
+protected:
+    std::filesystem::path path_;
+
+    void SetUp() override {
+        auto const name = ::testing::UnitTest::GetInstance()->current_test_info()->name();
+        path_ = std::filesystem::temp_directory_path() / (std::string("endgame_table_test_") + name + ".bin");
+        std::filesystem::remove(path_);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove(path_);
+    }
+
+    static EndgameTableEntry MakeEntry(float x, float value) {
+        CompactBoard board;
+        board.SetStone(0, Vector2(x, coordinate::kTee.y));
+        EndgameTableEntry entry;
+        entry.board = CanonicalBoard::Create(board, Team::k0);
+        entry.board_hash = entry.board.GetHash();
+        entry.translational_velocity = 2.3f;
+        entry.value = value;
+        entry.trials = 16;
+        entry.key.shot = 15;
+        entry.key.shots_remaining = 1;
+        return entry;
+    }
+};
+
+TEST_F(EndgameTableTest, ReloadsAppendedEntries) {
+    auto const first = MakeEntry(0.f, 1.f);
+    auto const second = MakeEntry(0.5f, -1.f);
+    {
+        EndgameTable table(path_, 4.75f);
+        table.Add(first);
+        table.Add(second);
+        table.Add(first);
+        EXPECT_EQ(table.GetEntryCount(), 2u);
+    }
+
+    EndgameTable table(path_, 4.75f);
+    EXPECT_EQ(table.GetEntryCount(), 2u);
+    auto const entry = table.Find(second.key, second.board);
+    ASSERT_TRUE(entry.has_value());
+    EXPECT_EQ(entry->value, -1.f);
+
+    auto other_key = second.key;
+    other_key.shots_remaining = 2;
+    EXPECT_FALSE(table.Find(other_key, second.board).has_value());
+}
+
+TEST_F(EndgameTableTest, DropsTruncatedTailAndKeepsAppending) {
+    {
+        EndgameTable table(path_, 4.75f);
+        table.Add(MakeEntry(0.f, 1.f));
+        table.Add(MakeEntry(0.5f, -1.f));
+    }
+    auto const full_size = std::filesystem::file_size(path_);
+    std::filesystem::resize_file(path_, full_size - 10);
+
+    {
+        // 欠けたエントリを取り除き、残りのエントリの直後から追記する
+        EndgameTable table(path_, 4.75f);
+        EXPECT_EQ(table.GetEntryCount(), 1u);
+        EXPECT_EQ(std::filesystem::file_size(path_), full_size - sizeof(EndgameTableEntry));
+        table.Add(MakeEntry(1.f, 0.5f));
+    }
+
+    EndgameTable table(path_, 4.75f);
+    EXPECT_EQ(table.GetEntryCount(), 2u);
+    auto const entry = MakeEntry(1.f, 0.5f);
+    ASSERT_TRUE(table.Find(entry.key, entry.board).has_value());
+    EXPECT_EQ(std::filesystem::file_size(path_), full_size);
+}
+
+TEST_F(EndgameTableTest, RejectsTruncatedHeaderAndOtherSheetWidth) {
+    { EndgameTable table(path_, 4.75f); }
+    EXPECT_THROW((EndgameTable { path_, 5.f }), std::runtime_error);
+
+    std::filesystem::resize_file(path_, 4);
+    EXPECT_THROW((EndgameTable { path_, 4.75f }), std::runtime_error);
+}
+
+} // namespace
+} // namespace digitalcurling::client
@@ -0,0 +1,87 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: Unlicense
+
+#include <string>
+#include <gtest/gtest.h>
+#include "digitalcurling/client/event_cursor.hpp"
+
+namespace digitalcurling::client {
+namespace {
+
+std::string MakeEvent(int end, int total_shot, std::string const& next_team, std::string const& winner = "null") {
+    return R"({"end_number": )" + std::to_string(end)
+        + R"(, "total_shot_number": )" + std::to_string(total_shot)
+        + R"(, "next_shot_team": )" + next_team
+        + R"(, "last_move": {"end_number": 99, "note": "\"winner_team\": \"team0\" }"})"
+        + R"(, "winner_team": )" + winner + "}";
+}
+
+TEST(EventCursorTest, PeekReadsTopLevelKeysOnly) {
+    auto const header = EventHeader::Peek(MakeEvent(3, 5, R"("team1")"));
+    ASSERT_TRUE(header.cursor.has_value());
+    EXPECT_EQ(header.cursor->end, 3);
+    EXPECT_EQ(header.cursor->total_shot, 5);
+    EXPECT_TRUE(header.cursor->has_next_team);
+    EXPECT_EQ(header.next_team, Team::k1);
+    EXPECT_FALSE(header.is_game_over);
+}
+
+TEST(EventCursorTest, PeekIgnoresNestedKeysWhenTopLevelKeyIsMissing) {
+    auto const data = R"({"total_shot_number": 1, "next_shot_team": null, "winner_team": null, "last_move": {"end_number": 2}})";
+    EXPECT_FALSE(EventHeader::Peek(data).cursor.has_value());
+    EXPECT_FALSE(EventHeader::Peek("not json").cursor.has_value());
+    EXPECT_FALSE(EventHeader::Peek(R"({"end_number": 1, "total_shot_number": )").cursor.has_value());
+}
+
+TEST(EventCursorTest, DropsOnlyCommittedEvents) {
+    EventCursorFilter filter;
+    auto const first = EventHeader::Peek(MakeEvent(0, 1, R"("team0")"));
+    auto const second = EventHeader::Peek(MakeEvent(0, 2, R"("team1")"));
+
+    EXPECT_FALSE(filter.IsProcessed(first));
+    EXPECT_FALSE(filter.IsProcessed(second));
+
+    // 処理に失敗したイベントは位置を進めない
+    filter.Commit(first);
+    EXPECT_TRUE(filter.IsProcessed(first));
+    EXPECT_FALSE(filter.IsProcessed(second));
+
+    filter.Commit(second);
+    EXPECT_TRUE(filter.IsProcessed(first));
+    EXPECT_TRUE(filter.IsProcessed(second));
+    EXPECT_FALSE(filter.IsProcessed(EventHeader::Peek(MakeEvent(1, 0, R"("team0")"))));
+}
+
+TEST(EventCursorTest, NeverDropsGameOverOrUnreadableEvents) {
+    EventCursorFilter filter;
+    filter.Commit(EventHeader::Peek(MakeEvent(9, 16, R"("team0")")));
+    EXPECT_FALSE(filter.IsProcessed(EventHeader::Peek(MakeEvent(0, 0, "null", R"("team1")"))));
+    EXPECT_FALSE(filter.IsProcessed(EventHeader::Peek("{}")));
+}
+
+TEST(EventCursorTest, KeepsResentOwnTurnUntilMoveIsPosted) {
+    EventCursorFilter filter;
+    auto const own_turn = EventHeader::Peek(MakeEvent(2, 4, R"("team0")"));
+    filter.Commit(own_turn);
+
+    // 行動の送信に失敗した後に再送された自チームの手番は処理する
+    EXPECT_FALSE(filter.IsProcessed(own_turn, Team::k0));
+    EXPECT_TRUE(filter.IsProcessed(own_turn, Team::k1));
+    EXPECT_TRUE(filter.IsProcessed(own_turn));
+    EXPECT_TRUE(filter.IsLatest(own_turn));
+
+    // 以前の手番は行動の送信の有無によらず破棄する
+    EXPECT_TRUE(filter.IsProcessed(EventHeader::Peek(MakeEvent(2, 2, R"("team0")")), Team::k0));
+
+    filter.MarkMovePosted();
+    EXPECT_TRUE(filter.IsProcessed(own_turn, Team::k0));
+
+    // 次のイベントを処理すると送信の記録は消える
+    auto const next_own_turn = EventHeader::Peek(MakeEvent(2, 6, R"("team0")"));
+    filter.Commit(next_own_turn);
+    EXPECT_FALSE(filter.IsProcessed(next_own_turn, Team::k0));
+    EXPECT_FALSE(filter.IsLatest(own_turn));
+}
+
+} // namespace
+} // namespace digitalcurling::client
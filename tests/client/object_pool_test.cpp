@@ -0,0 +1,74 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: Unlicense
+
+#include <memory>
+#include <gtest/gtest.h>
+#include "digitalcurling/client/object_pool.hpp"
+
+namespace digitalcurling::client {
+namespace {
+
+struct TestObject {
+    int id = 0;
+    int state = 0;
+};
+
+struct TestFactory {
+    int created = 0;
+};
+
+using TestPool = ObjectPool<TestFactory, TestObject>;
+
+std::unique_ptr<TestObject> CreateTestObject(TestFactory& factory) {
+    return std::make_unique<TestObject>(TestObject { ++factory.created, 0 });
+}
+
+TEST(ObjectPoolTest, ResetsStateInPlaceOnReturn) {
+    TestPool pool(CreateTestObject, [](TestFactory&, std::unique_ptr<TestObject>& object) { object->state = 0; });
+    TestFactory factory;
+    pool.Register(factory, 1);
+    {
+        auto lease = pool.Acquire(factory);
+        lease->state = 42;
+    }
+
+    auto const lease = pool.Acquire(factory);
+    EXPECT_EQ(lease->id, 1);
+    EXPECT_EQ(lease->state, 0);
+    EXPECT_EQ(factory.created, 1);
+}
+
+TEST(ObjectPoolTest, ResetterCanReplaceObjectFromFactory) {
+    // 状態を戻せないオブジェクトは、返却時に生成し直したものと置き換える
+    TestPool pool(CreateTestObject, [](TestFactory& factory, std::unique_ptr<TestObject>& object) {
+        object = CreateTestObject(factory);
+    });
+    TestFactory factory;
+    pool.Register(factory, 1);
+    {
+        auto lease = pool.Acquire(factory);
+        EXPECT_EQ(lease->id, 1);
+        lease->state = 42;
+    }
+
+    auto const lease = pool.Acquire(factory);
+    EXPECT_EQ(lease->id, 2);
+    EXPECT_EQ(lease->state, 0);
+    EXPECT_EQ(factory.created, 2);
+}
+
+TEST(ObjectPoolTest, DiscardsObjectsReturnedAfterClear) {
+    int resets = 0;
+    TestPool pool(CreateTestObject, [&resets](TestFactory&, std::unique_ptr<TestObject>&) { ++resets; });
+    TestFactory factory;
+    pool.Register(factory, 1);
+    auto lease = pool.Acquire(factory);
+
+    pool.Clear();
+    lease = TestPool::Lease();
+    EXPECT_EQ(resets, 0);
+    EXPECT_THROW(pool.Acquire(factory), std::runtime_error);
+}
+
+} // namespace
+} // namespace digitalcurling::client
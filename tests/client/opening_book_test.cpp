@@ -0,0 +1,78 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: Unlicense
+
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <gtest/gtest.h>
+#include "digitalcurling/client/opening_book.hpp"
+
+namespace digitalcurling::client {
+namespace {
+
+class OpeningBookTest : public ::testing::Test {
+protected:
+    std::filesystem::path path_;
+
+    void SetUp() override {
+        auto const name = ::testing::UnitTest::GetInstance()->current_test_info()->name();
+        path_ = std::filesystem::temp_directory_path() / (std::string("opening_book_test_") + name + ".bin");
+        std::filesystem::remove(path_);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove(path_);
+    }
+
+    static CompactBoard MakeBoard(float x) {
+        CompactBoard board;
+        board.SetStone(8, Vector2(x, coordinate::kTee.y - 3.f));
+        return board;
+    }
+
+    /// @brief 2つの局面を書き出す
+    void Write() const {
+        OpeningBookWriter writer(4.75f);
+        OpeningBookKey key;
+        key.shot = 1;
+        key.has_hammer = 1;
+        writer.Add(key, CanonicalBoard::Create(MakeBoard(0.f), Team::k0), { moves::Shot(2.3f, 1.57f, 0.01f), 0.5f, 32 });
+        writer.Add(key, CanonicalBoard::Create(MakeBoard(1.f), Team::k0), { moves::Shot(2.4f, 1.57f, 0.02f), 0.25f, 32 });
+        writer.Save(path_);
+    }
+};
+
+TEST_F(OpeningBookTest, FindsSavedEntries) {
+    Write();
+    OpeningBook book(path_);
+    ASSERT_TRUE(book.IsOpen());
+    EXPECT_EQ(book.GetEntryCount(), 2u);
+    EXPECT_EQ(book.GetSheetWidth(), 4.75f);
+
+    OpeningBookKey key;
+    key.shot = 1;
+    key.has_hammer = 1;
+    auto const entry = book.Find(key, CanonicalBoard::Create(MakeBoard(0.f), Team::k0));
+    ASSERT_TRUE(entry.has_value());
+    EXPECT_EQ(entry->value, 0.5f);
+    EXPECT_EQ(entry->trials, 32u);
+
+    key.has_hammer = 0;
+    EXPECT_FALSE(book.Find(key, CanonicalBoard::Create(MakeBoard(0.f), Team::k0)).has_value());
+}
+
+TEST_F(OpeningBookTest, RejectsTruncatedTail) {
+    Write();
+    auto const size = std::filesystem::file_size(path_);
+    std::filesystem::resize_file(path_, size - 1);
+    EXPECT_THROW(OpeningBook { path_ }, std::runtime_error);
+
+    std::filesystem::resize_file(path_, size - sizeof(OpeningBookEntry));
+    EXPECT_THROW(OpeningBook { path_ }, std::runtime_error);
+
+    std::filesystem::resize_file(path_, 4);
+    EXPECT_THROW(OpeningBook { path_ }, std::runtime_error);
+}
+
+} // namespace
+} // namespace digitalcurling::client
@@ -0,0 +1,173 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: Unlicense
+
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include "digitalcurling/client/process_simulation_evaluator.hpp"
+#include "digitalcurling/client/thinking_context.hpp"
+
+namespace digitalcurling::client {
+namespace {
+
+constexpr char const* kMarkerDirectoryVariable = "DIGITALCURLING_CLIENT_TEST_MARKER_DIR";
+constexpr std::size_t kNoSpecialJob = static_cast<std::size_t>(-1);
+constexpr std::size_t kAllJobs = static_cast<std::size_t>(-2);
+
+/// @brief ジョブの種類 (`release_angle` で指定する)
+enum class JobKind { kNormal = 0, kCrashOnce = 1, kCrashAlways = 2, kHangOnce = 3, kSlow = 4 };
+
+/// @brief 初回の実行かを、ジョブごとの印のファイルで判定する
+bool IsFirstRun(SimulationJob const& job) {
+    auto const path = std::filesystem::path(std::getenv(kMarkerDirectoryVariable))
+        / ("job-" + std::to_string(static_cast<int>(job.translational_velocity)));
+    if (std::filesystem::exists(path)) return false;
+    std::ofstream(path).put('x');
+    return true;
+}
+
+/// @brief シミュレーターの代わりに、初速を投げたストーンの位置として書き込む
+void RunTestJob(SimulationJob& job) {
+    switch (static_cast<JobKind>(static_cast<int>(job.release_angle))) {
+        case JobKind::kCrashOnce:
+            if (IsFirstRun(job)) std::raise(SIGKILL);
+            break;
+        case JobKind::kCrashAlways:
+            std::raise(SIGKILL);
+            break;
+        case JobKind::kHangOnce:
+            if (IsFirstRun(job)) std::this_thread::sleep_for(std::chrono::hours(1));
+            break;
+        case JobKind::kSlow:
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            break;
+        default:
+            break;
+    }
+    job.board.SetStone(job.stone_index, Vector2 { job.translational_velocity, 1.f });
+}
+
+class ProcessSimulationEvaluatorTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        auto const name = std::string("dcclient-test-") + ::testing::UnitTest::GetInstance()->current_test_info()->name();
+        marker_directory_ = std::filesystem::temp_directory_path() / name;
+        std::filesystem::remove_all(marker_directory_);
+        std::filesystem::create_directories(marker_directory_);
+        setenv(kMarkerDirectoryVariable, marker_directory_.c_str(), 1);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(marker_directory_);
+    }
+
+    static std::pmr::vector<SimulationJob> MakeJobs(std::size_t count, std::size_t special_index, JobKind kind) {
+        std::pmr::vector<SimulationJob> jobs;
+        for (std::size_t i = 0; i < count; ++i) {
+            auto const angle = static_cast<float>(i == special_index || special_index == kAllJobs ? kind : JobKind::kNormal);
+            jobs.push_back(SimulationJob::Create(CompactBoard(), 3, moves::Shot(static_cast<float>(i), 0.f, angle)));
+        }
+        return jobs;
+    }
+
+    static void ExpectEvaluated(std::pmr::vector<SimulationJob> const& jobs) {
+        for (std::size_t i = 0; i < jobs.size(); ++i) {
+            ASSERT_TRUE(jobs[i].board.HasStone(3)) << "job " << i;
+            EXPECT_EQ(jobs[i].board.x[3], static_cast<float>(i)) << "job " << i;
+        }
+    }
+
+private:
+    std::filesystem::path marker_directory_;
+};
+
+TEST_F(ProcessSimulationEvaluatorTest, EvaluatesAllJobs) {
+    ProcessSimulationEvaluator evaluator(nlohmann::json::object(), 4.75f, 3);
+    auto jobs = MakeJobs(5000, kNoSpecialJob, JobKind::kNormal);
+    evaluator.Evaluate(jobs);
+    ExpectEvaluated(jobs);
+}
+
+TEST_F(ProcessSimulationEvaluatorTest, RequeuesJobOfCrashedWorker) {
+    ProcessSimulationEvaluator evaluator(nlohmann::json::object(), 4.75f, 2);
+    auto jobs = MakeJobs(200, 17, JobKind::kCrashOnce);
+    evaluator.Evaluate(jobs);
+    ExpectEvaluated(jobs);
+
+    // 再起動したワーカーで続けて評価できる
+    auto next_jobs = MakeJobs(200, kNoSpecialJob, JobKind::kNormal);
+    evaluator.Evaluate(next_jobs);
+    ExpectEvaluated(next_jobs);
+}
+
+TEST_F(ProcessSimulationEvaluatorTest, RecoversWhenOnlyWorkerCrashes) {
+    ProcessSimulationEvaluator evaluator(nlohmann::json::object(), 4.75f, 1);
+    auto jobs = MakeJobs(50, 0, JobKind::kCrashOnce);
+    evaluator.Evaluate(jobs);
+    ExpectEvaluated(jobs);
+}
+
+TEST_F(ProcessSimulationEvaluatorTest, GivesUpOnJobThatAlwaysCrashes) {
+    ProcessSimulationEvaluator evaluator(nlohmann::json::object(), 4.75f, 2);
+    auto jobs = MakeJobs(20, 5, JobKind::kCrashAlways);
+    EXPECT_THROW(evaluator.Evaluate(jobs), std::runtime_error);
+}
+
+TEST_F(ProcessSimulationEvaluatorTest, KillsHungWorkerAfterDeadline) {
+    ProcessSimulationEvaluator evaluator(nlohmann::json::object(), 4.75f, 2);
+    evaluator.SetDeadline(std::chrono::steady_clock::now());
+    auto jobs = MakeJobs(20, 4, JobKind::kHangOnce);
+
+    auto const start = std::chrono::steady_clock::now();
+    evaluator.Evaluate(jobs);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+    ExpectEvaluated(jobs);
+}
+
+TEST_F(ProcessSimulationEvaluatorTest, ReturnsPromptlyWhenThinkingIsCancelled) {
+    ProcessSimulationEvaluator evaluator(nlohmann::json::object(), 4.75f, 2);
+    // 全て評価すると 2 ワーカーで 5 秒かかる
+    auto jobs = MakeJobs(1000, kAllJobs, JobKind::kSlow);
+
+    ThinkingContext context;
+    auto const start = std::chrono::steady_clock::now();
+    std::thread canceller([&context]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        context.Cancel();
+    });
+    {
+        ThinkingContext::Scope scope(context);
+        evaluator.Evaluate(jobs);
+    }
+    canceller.join();
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(1));
+
+    std::size_t evaluated = 0;
+    for (auto const& job : jobs) evaluated += job.board.HasStone(3) ? 1 : 0;
+    EXPECT_GT(evaluated, 0u);
+    EXPECT_LT(evaluated, jobs.size());
+
+    // 破棄したジョブが残っていても、続けて評価できる
+    auto next_jobs = MakeJobs(200, kNoSpecialJob, JobKind::kNormal);
+    evaluator.Evaluate(next_jobs);
+    ExpectEvaluated(next_jobs);
+}
+
+} // namespace
+} // namespace digitalcurling::client
+
+int main(int argc, char** argv) {
+    // 評価器は自身の実行ファイルをワーカーとして起動する
+    if (argc >= 5 && std::string(argv[1]) == "--simulation-worker") {
+        return digitalcurling::client::ProcessSimulationEvaluator::RunWorker(
+            argv[2], std::stoul(argv[4]), digitalcurling::client::RunTestJob);
+    }
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
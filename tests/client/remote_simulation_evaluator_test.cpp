@@ -0,0 +1,73 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: Unlicense
+
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "digitalcurling/client/remote_simulation_evaluator.hpp"
+
+namespace digitalcurling::client {
+namespace {
+
+constexpr char const* kSimulatorJson = R"({"type":"fcv1","seconds_per_frame":0.001})";
+
+std::pmr::vector<SimulationJob> MakeJobs() {
+    CompactBoard board;
+    board.SetStone(8, Vector2 { 0.3f, 38.4f });
+    return {
+        SimulationJob::Create(board, 0, moves::Shot(2.3f, 1.57f, 0.01f)),
+        SimulationJob::Create(board, 1, moves::Shot(3.f, -1.57f, -0.02f)),
+    };
+}
+
+TEST(RemoteSimulationEvaluatorTest, DecodeRestoresEncodedRequest) {
+    auto const jobs = MakeJobs();
+    auto const body = RemoteSimulationEvaluator::EncodeRequest(kSimulatorJson, 4.75f, jobs.data(), jobs.size());
+
+    auto const request = RemoteSimulationEvaluator::DecodeRequest(body);
+    EXPECT_EQ(request.sheet_width, 4.75f);
+    EXPECT_EQ(request.simulator_json, kSimulatorJson);
+    ASSERT_EQ(request.jobs.size(), jobs.size());
+    for (std::size_t i = 0; i < jobs.size(); ++i) {
+        EXPECT_EQ(request.jobs[i].board, jobs[i].board);
+        EXPECT_EQ(request.jobs[i].stone_index, jobs[i].stone_index);
+        EXPECT_EQ(request.jobs[i].translational_velocity, jobs[i].translational_velocity);
+    }
+}
+
+TEST(RemoteSimulationEvaluatorTest, DecodeRejectsStoneIndexOutOfRange) {
+    auto jobs = MakeJobs();
+    for (std::uint8_t index : { std::uint8_t(16), std::uint8_t(255) }) {
+        jobs[1].stone_index = index;
+        auto const body = RemoteSimulationEvaluator::EncodeRequest(kSimulatorJson, 4.75f, jobs.data(), jobs.size());
+        EXPECT_THROW(RemoteSimulationEvaluator::DecodeRequest(body), std::invalid_argument);
+    }
+}
+
+TEST(RemoteSimulationEvaluatorTest, DecodeRejectsSizeMismatch) {
+    auto const jobs = MakeJobs();
+    auto const body = RemoteSimulationEvaluator::EncodeRequest(kSimulatorJson, 4.75f, jobs.data(), jobs.size());
+
+    EXPECT_THROW(RemoteSimulationEvaluator::DecodeRequest(body.substr(0, body.size() - 1)), std::invalid_argument);
+    EXPECT_THROW(RemoteSimulationEvaluator::DecodeRequest(body + '\0'), std::invalid_argument);
+    EXPECT_THROW(RemoteSimulationEvaluator::DecodeRequest(body.substr(0, 8)), std::invalid_argument);
+}
+
+TEST(RemoteSimulationEvaluatorTest, DecodeRejectsBadHeaderAndValues) {
+    auto jobs = MakeJobs();
+    auto body = RemoteSimulationEvaluator::EncodeRequest(kSimulatorJson, 4.75f, jobs.data(), jobs.size());
+    body[0] ^= 0x01;
+    EXPECT_THROW(RemoteSimulationEvaluator::DecodeRequest(body), std::invalid_argument);
+
+    EXPECT_THROW(RemoteSimulationEvaluator::DecodeRequest(
+        RemoteSimulationEvaluator::EncodeRequest(kSimulatorJson, -1.f, jobs.data(), jobs.size())), std::invalid_argument);
+
+    jobs[0].translational_velocity = std::numeric_limits<float>::quiet_NaN();
+    EXPECT_THROW(RemoteSimulationEvaluator::DecodeRequest(
+        RemoteSimulationEvaluator::EncodeRequest(kSimulatorJson, 4.75f, jobs.data(), jobs.size())), std::invalid_argument);
+}
+
+} // namespace
+} // namespace digitalcurling::client
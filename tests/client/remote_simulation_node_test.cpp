@@ -0,0 +1,193 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: Unlicense
+
+#include <chrono>
+#include <csignal>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <gtest/gtest.h>
+#include <httplib.h>
+#include "digitalcurling/client/remote_simulation_evaluator.hpp"
+
+namespace digitalcurling::client {
+namespace {
+
+constexpr char const* kNodeArgument = "--simulation-node";
+constexpr std::size_t kNodeCount = 3;
+
+/// @brief シミュレーターの代わりに、初速とリリース角度を投げたストーンの位置として書き込む
+void ApplyTestJob(SimulationJob& job) {
+    job.board.SetStone(job.stone_index, Vector2 { job.translational_velocity, job.release_angle });
+}
+
+/// @brief ノードとローカルの評価器で実行するジョブ (分散の効果が測れるよう、1 ジョブごとに待つ)
+void RunTestJob(SimulationJob& job) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    ApplyTestJob(job);
+}
+
+/// @brief ノードと同じ方法でジョブを処理するローカルの評価器
+class TestLocalEvaluator : public ISimulationEvaluator {
+public:
+    void Evaluate(std::pmr::vector<SimulationJob>& jobs) override {
+        for (auto& job : jobs) RunTestJob(job);
+    }
+};
+
+/// @brief 空いているポートを返す
+int GetFreePort() {
+    int const fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = 0;
+    socklen_t length = sizeof(address);
+    if (fd < 0 || bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0
+        || getsockname(fd, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+        if (fd >= 0) close(fd);
+        return 0;
+    }
+    close(fd);
+    return ntohs(address.sin_port);
+}
+
+class RemoteSimulationNodeTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // ノードは自身の実行ファイルを別のプロセスとして起動する
+        for (std::size_t i = 0; i < kNodeCount; ++i) {
+            auto const port = GetFreePort();
+            ASSERT_NE(port, 0);
+            auto const pid = fork();
+            ASSERT_GE(pid, 0);
+            if (pid == 0) {
+                auto const port_string = std::to_string(port);
+                execl("/proc/self/exe", "/proc/self/exe", kNodeArgument, port_string.c_str(), static_cast<char*>(nullptr));
+                _exit(127);
+            }
+            pids_.push_back(pid);
+            urls_.push_back("http://127.0.0.1:" + std::to_string(port));
+        }
+
+        for (auto const& url : urls_) {
+            httplib::Client client(url);
+            client.set_connection_timeout(std::chrono::milliseconds(100));
+            bool is_ready = false;
+            for (auto const start = std::chrono::steady_clock::now();
+                 !is_ready && std::chrono::steady_clock::now() - start < std::chrono::seconds(10);) {
+                auto const result = client.Get("/health");
+                is_ready = result && result->status == 200;
+                if (!is_ready) std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            }
+            ASSERT_TRUE(is_ready) << url;
+        }
+    }
+
+    void TearDown() override {
+        for (std::size_t i = 0; i < pids_.size(); ++i) KillNode(i);
+    }
+
+    /// @brief ノードを停止させる
+    void KillNode(std::size_t index) {
+        if (pids_[index] <= 0) return;
+        kill(pids_[index], SIGKILL);
+        waitpid(pids_[index], nullptr, 0);
+        pids_[index] = -1;
+    }
+
+    std::unique_ptr<RemoteSimulationEvaluator> CreateEvaluator(std::size_t node_count) const {
+        std::vector<std::string> const nodes(urls_.begin(), urls_.begin() + node_count);
+        return std::make_unique<RemoteSimulationEvaluator>(
+            nlohmann::json::object(), 4.75f, nodes, std::make_unique<TestLocalEvaluator>());
+    }
+
+    static std::pmr::vector<SimulationJob> MakeJobs(std::size_t count) {
+        CompactBoard board;
+        board.SetStone(8, Vector2 { 0.3f, 38.4f });
+        std::pmr::vector<SimulationJob> jobs;
+        for (std::size_t i = 0; i < count; ++i) {
+            auto const stone_index = static_cast<std::uint8_t>(i % 8);
+            jobs.push_back(SimulationJob::Create(board, stone_index,
+                moves::Shot(static_cast<float>(i), i % 2 == 0 ? 1.57f : -1.57f, static_cast<float>(i % 7))));
+        }
+        return jobs;
+    }
+
+    /// @brief ローカルで順に評価した結果と一致するかを確かめる
+    static void ExpectMatchesLocal(std::pmr::vector<SimulationJob> const& evaluated) {
+        auto expected = MakeJobs(evaluated.size());
+        for (auto& job : expected) ApplyTestJob(job);
+        for (std::size_t i = 0; i < evaluated.size(); ++i) {
+            ASSERT_EQ(evaluated[i].board, expected[i].board) << "job " << i;
+        }
+    }
+
+    std::vector<pid_t> pids_;
+    std::vector<std::string> urls_;
+};
+
+TEST_F(RemoteSimulationNodeTest, MatchesLocalEvaluation) {
+    auto evaluator = CreateEvaluator(kNodeCount);
+    auto jobs = MakeJobs(1000);
+    evaluator->Evaluate(jobs);
+    ExpectMatchesLocal(jobs);
+}
+
+TEST_F(RemoteSimulationNodeTest, MatchesLocalEvaluationWhenNodeIsKilledMidBatch) {
+    auto evaluator = CreateEvaluator(kNodeCount);
+    // 全て評価するには 4 ワーカーで 0.5 秒以上かかるため、評価中にノードを停止させる
+    auto jobs = MakeJobs(2000);
+    std::thread killer([this]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        KillNode(0);
+    });
+    evaluator->Evaluate(jobs);
+    killer.join();
+    ExpectMatchesLocal(jobs);
+
+    // 残りのノードとローカルで続けて評価できる
+    auto next_jobs = MakeJobs(200);
+    evaluator->Evaluate(next_jobs);
+    ExpectMatchesLocal(next_jobs);
+}
+
+TEST_F(RemoteSimulationNodeTest, ReportsThroughputByNodeCount) {
+    constexpr std::size_t kJobCount = 1000;
+    std::vector<double> jobs_per_second;
+    for (std::size_t node_count = 0; node_count <= kNodeCount; ++node_count) {
+        auto evaluator = CreateEvaluator(node_count);
+        auto jobs = MakeJobs(kJobCount);
+        auto const start = std::chrono::steady_clock::now();
+        evaluator->Evaluate(jobs);
+        auto const seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        ExpectMatchesLocal(jobs);
+
+        jobs_per_second.push_back(static_cast<double>(kJobCount) / seconds);
+        std::cout << "[  SCALING ] " << node_count << " node(s): "
+            << static_cast<int>(jobs_per_second.back()) << " jobs/s ("
+            << jobs_per_second.back() / jobs_per_second.front() << "x)" << std::endl;
+        RecordProperty("jobs_per_second_" + std::to_string(node_count) + "_nodes", static_cast<int>(jobs_per_second.back()));
+    }
+    // ローカルのみの 1 ワーカーに対し、ノードを加えると 4 ワーカーで処理する
+    EXPECT_GT(jobs_per_second.back(), jobs_per_second.front() * 1.5);
+}
+
+} // namespace
+} // namespace digitalcurling::client
+
+int main(int argc, char** argv) {
+    // 評価ノードは自身の実行ファイルを別のプロセスとして起動したもの
+    if (argc >= 3 && std::string(argv[1]) == digitalcurling::client::kNodeArgument) {
+        return digitalcurling::client::RemoteSimulationEvaluator::RunNode(
+            "127.0.0.1", std::stoi(argv[2]), digitalcurling::client::RunTestJob);
+    }
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,94 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: Unlicense
+
+#include <gtest/gtest.h>
+#include "digitalcurling/client/search_tree.hpp"
+
+namespace digitalcurling::client {
+namespace {
+
+CompactBoard MakeBoard(float x) {
+    CompactBoard board;
+    board.SetStone(0, Vector2(x, coordinate::kTee.y));
+    return board;
+}
+
+TEST(SearchTreeTest, AdvancePromotesClosestChildWithItsSubtree) {
+    SearchTree<> tree(0.05f);
+    tree.Reset(CompactBoard {});
+    auto const near = tree.AddChild(tree.GetRoot(), MakeBoard(0.f), moves::Shot(2.3f, 1.57f, 0.f));
+    auto const far = tree.AddChild(tree.GetRoot(), MakeBoard(1.f), moves::Shot(2.3f, -1.57f, 0.f));
+    auto const grandchild = tree.AddChild(near, MakeBoard(0.5f), moves::Shot(2.4f, 1.57f, 0.f));
+    tree.AddResult(near, 1., 4);
+    tree.AddResult(grandchild, 0.5, 6);
+    tree.AddResult(far, 0., 100);
+    EXPECT_EQ(tree.GetNode(tree.GetRoot()).playouts, 110u);
+
+    auto const real = MakeBoard(0.02f);
+    auto const result = tree.Advance(real, moves::Shot(2.3f, 1.57f, 0.f));
+    ASSERT_TRUE(result.reused);
+    EXPECT_NEAR(result.distance, 0.02f, 1e-6f);
+    EXPECT_EQ(result.carried_nodes, 2u);
+    EXPECT_EQ(result.carried_playouts, 10u);
+    EXPECT_EQ(tree.GetTotalCarriedPlayouts(), 10u);
+
+    // 新しいルートは実際の盤面を持ち、部分木の統計と構造を保つ
+    auto const& root = tree.GetNode(tree.GetRoot());
+    EXPECT_EQ(root.board, real);
+    EXPECT_FALSE(root.shot.has_value());
+    EXPECT_DOUBLE_EQ(root.value_sum, 4. + 3.);
+    ASSERT_NE(root.first_child, SearchTree<>::kNullIndex);
+    auto const& child = tree.GetNode(root.first_child);
+    EXPECT_EQ(child.board, MakeBoard(0.5f));
+    EXPECT_EQ(child.parent, tree.GetRoot());
+    EXPECT_EQ(child.next_sibling, SearchTree<>::kNullIndex);
+
+    // 引き継いだノードへの加算はルートにも反映される
+    tree.AddResult(root.first_child, 1., 2);
+    EXPECT_EQ(tree.GetNode(tree.GetRoot()).playouts, 12u);
+}
+
+TEST(SearchTreeTest, AdvanceDiscardsTreeWhenNoChildIsWithinTolerance) {
+    SearchTree<> tree(0.05f);
+    tree.Reset(CompactBoard {});
+    tree.AddResult(tree.AddChild(tree.GetRoot(), MakeBoard(0.f), moves::Shot(2.3f, 1.57f, 0.f)), 1., 8);
+
+    auto const real = MakeBoard(0.2f);
+    auto const result = tree.Advance(real, std::nullopt);
+    EXPECT_FALSE(result.reused);
+    EXPECT_EQ(result.carried_playouts, 0u);
+    EXPECT_EQ(tree.GetNodeCount(), 1u);
+    EXPECT_EQ(tree.GetNode(tree.GetRoot()).board, real);
+    EXPECT_EQ(tree.GetNode(tree.GetRoot()).playouts, 0u);
+
+    // 石の有無が異なる盤面は距離によらず一致しない
+    tree.AddChild(tree.GetRoot(), CompactBoard {}, moves::Shot(2.3f, 1.57f, 0.f));
+    EXPECT_FALSE(tree.Advance(MakeBoard(0.f), std::nullopt).reused);
+}
+
+TEST(SearchTreeTest, AdvancePrefersPlayedShotAmongEqualBoards) {
+    SearchTree<> tree;
+    tree.Reset(CompactBoard {});
+    auto const cw = tree.AddChild(tree.GetRoot(), MakeBoard(0.f), moves::Shot(2.3f, 1.57f, 0.f));
+    auto const ccw = tree.AddChild(tree.GetRoot(), MakeBoard(0.f), moves::Shot(2.3f, -1.57f, 0.f));
+    tree.AddResult(cw, 1., 1);
+    tree.AddResult(ccw, 0., 3);
+
+    auto const result = tree.Advance(MakeBoard(0.f), moves::Shot(2.3f, -1.57f, 0.f));
+    ASSERT_TRUE(result.reused);
+    EXPECT_EQ(result.carried_playouts, 3u);
+}
+
+TEST(SearchTreeTest, AdvanceWithoutRootStartsFromBoard) {
+    SearchTree<> tree;
+    auto const result = tree.Advance(MakeBoard(0.f), std::nullopt);
+    EXPECT_FALSE(result.reused);
+    ASSERT_TRUE(tree.HasRoot());
+    EXPECT_EQ(tree.GetNode(tree.GetRoot()).board, MakeBoard(0.f));
+
+    tree.Clear();
+    EXPECT_FALSE(tree.HasRoot());
+}
+
+} // namespace
+} // namespace digitalcurling::client
@@ -0,0 +1,95 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: Unlicense
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <gtest/gtest.h>
+#include "digitalcurling/client/turn_arena.hpp"
+
+namespace digitalcurling::client {
+namespace {
+
+TEST(ArenaTest, ResetReusesChunks) {
+    Arena arena(1024);
+    auto const first = arena.allocate(100, 8);
+    EXPECT_NE(arena.allocate(200, 8), nullptr);
+    EXPECT_EQ(arena.GetStatistics().allocations, 2u);
+    EXPECT_EQ(arena.GetStatistics().upstream_allocations, 1u);
+
+    arena.Reset();
+    EXPECT_EQ(arena.GetStatistics().allocations, 0u);
+    EXPECT_EQ(arena.allocate(100, 8), first);
+    EXPECT_EQ(arena.GetStatistics().upstream_allocations, 0u);
+}
+
+TEST(ArenaTest, KeepsAlignmentAndGrowsForLargeRequests) {
+    Arena arena(256);
+    EXPECT_NE(arena.allocate(3, 1), nullptr);
+    auto const aligned = reinterpret_cast<std::uintptr_t>(arena.allocate(16, 64));
+    EXPECT_EQ(aligned % 64, 0u);
+
+    EXPECT_NE(arena.allocate(1000, 8), nullptr);
+    EXPECT_EQ(arena.GetStatistics().upstream_allocations, 2u);
+}
+
+TEST(ArenaTest, ResetsOnNextAllocationAfterGenerationAdvances) {
+    std::atomic<std::uint64_t> generation = 0;
+    Arena arena(1024, std::pmr::new_delete_resource(), &generation);
+    auto const first = arena.allocate(100, 8);
+    EXPECT_NE(arena.allocate(100, 8), nullptr);
+
+    // 別のスレッドは世代を進めるだけで、アリーナには触れない
+    std::thread([&generation] { generation.fetch_add(1); }).join();
+    EXPECT_EQ(arena.GetGeneration(), 0u);
+    EXPECT_EQ(arena.GetStatistics().allocations, 2u);
+
+    EXPECT_EQ(arena.allocate(100, 8), first);
+    EXPECT_EQ(arena.GetGeneration(), 1u);
+    EXPECT_EQ(arena.GetStatistics().allocations, 1u);
+}
+
+TEST(TurnArenaTest, BeginTurnResetsEachThreadOnItsNextAllocation) {
+    TurnArena::BeginTurn();
+    {
+        auto vec = MakeArenaVector<int>(16);
+        vec.push_back(1);
+        EXPECT_GE(TurnArena::GetStatistics().allocations, 1u);
+
+        // 他のスレッドからターンを進めても、このスレッドのアリーナは次の確保まで保たれる
+        ArenaStatistics previous;
+        std::thread([&previous] { previous = TurnArena::BeginTurn(); }).join();
+        EXPECT_GE(previous.allocations, 1u);
+        EXPECT_EQ(TurnArena::GetPreviousTurnStatistics().allocations, previous.allocations);
+        EXPECT_EQ(vec[0], 1);
+        // 前のターンの配列は、次の確保の前に破棄する
+    }
+
+    auto next = MakeArenaVector<int>(16);
+    EXPECT_EQ(TurnArena::GetStatistics().allocations, 1u);
+}
+
+#ifndef NDEBUG
+TEST(TurnArenaDeathTest, ArenaVectorKeptAcrossTurnAbortsInDebugBuild) {
+    EXPECT_DEATH({
+        TurnArena::BeginTurn();
+        auto vec = MakeArenaVector<int>(16);
+        TurnArena::BeginTurn();
+        auto next = MakeArenaVector<int>(16);
+    }, "kept across a turn");
+}
+#endif
+
+TEST(TurnArenaTest, ResetLocalDiscardsOnlyTheCallingThread) {
+    TurnArena::BeginTurn();
+    auto const data = MakeArenaVector<int>(16).data();
+    std::thread([] { EXPECT_EQ(MakeArenaVector<int>(16).capacity(), 16u); }).join();
+    EXPECT_EQ(TurnArena::GetStatistics().allocations, 2u);
+
+    TurnArena::ResetLocal();
+    EXPECT_EQ(TurnArena::GetStatistics().allocations, 1u);
+    EXPECT_EQ(MakeArenaVector<int>(16).data(), data);
+}
+
+} // namespace
+} // namespace digitalcurling::client
@@ -0,0 +1,88 @@
+// Copyright (c) 2022-2026 UEC Takeshi Ito Laboratory
+// SPDX-License-Identifier: Unlicense
+
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <gtest/gtest.h>
+#include "digitalcurling/client/win_probability_table.hpp"
+
+namespace digitalcurling::client {
+namespace {
+
+/// @brief 量子化による誤差の許容値
+constexpr float kTolerance = 2.f / 65535.f;
+
+WinProbabilityKey MakeKey(int ends_remaining, int score_difference, bool has_hammer) {
+    WinProbabilityKey key;
+    key.ends_remaining = static_cast<std::uint8_t>(ends_remaining);
+    key.score_difference = static_cast<std::int8_t>(score_difference);
+    key.has_hammer = has_hammer ? 1 : 0;
+    return key;
+}
+
+class WinProbabilityTableTest : public ::testing::TestWithParam<GameRuleType> {
+protected:
+    WinProbabilityTable table_ = WinProbabilityTable::Build(EndScoreDistribution::GetDefault(GetParam()), GetParam());
+};
+
+TEST_P(WinProbabilityTableTest, IsNonDecreasingInScoreDifference) {
+    constexpr int kMaxDifference = WinProbabilityKey::kMaxScoreDifference;
+    for (int ends = 0; ends <= WinProbabilityKey::kMaxEndsRemaining; ++ends) {
+        for (bool has_hammer : { false, true }) {
+            for (int difference = -kMaxDifference; difference < kMaxDifference; ++difference) {
+                EXPECT_LE(table_.Get(MakeKey(ends, difference, has_hammer)), table_.Get(MakeKey(ends, difference + 1, has_hammer)))
+                    << "ends=" << ends << " difference=" << difference << " hammer=" << has_hammer;
+            }
+        }
+    }
+}
+
+TEST_P(WinProbabilityTableTest, HammerIsBeneficial) {
+    constexpr int kMaxDifference = WinProbabilityKey::kMaxScoreDifference;
+    for (int ends = 0; ends <= WinProbabilityKey::kMaxEndsRemaining; ++ends) {
+        for (int difference = -kMaxDifference; difference <= kMaxDifference; ++difference) {
+            EXPECT_GE(table_.Get(MakeKey(ends, difference, true)), table_.Get(MakeKey(ends, difference, false)))
+                << "ends=" << ends << " difference=" << difference;
+        }
+    }
+    EXPECT_GT(table_.Get(MakeKey(0, 0, true)), 0.5f);
+    EXPECT_GT(table_.Get(MakeKey(8, 0, true)), 0.5f);
+}
+
+TEST_P(WinProbabilityTableTest, IsComplementaryBetweenTeams) {
+    constexpr int kMaxDifference = WinProbabilityKey::kMaxScoreDifference;
+    for (int ends = 0; ends <= WinProbabilityKey::kMaxEndsRemaining; ++ends) {
+        for (int difference = -kMaxDifference; difference <= kMaxDifference; ++difference) {
+            EXPECT_NEAR(table_.Get(MakeKey(ends, difference, true)) + table_.Get(MakeKey(ends, -difference, false)), 1.f, kTolerance)
+                << "ends=" << ends << " difference=" << difference;
+        }
+    }
+    // 規定のエンドを終えた時点でリードしていれば勝ち
+    EXPECT_EQ(table_.Get(MakeKey(0, 1, false)), 1.f);
+    EXPECT_EQ(table_.Get(MakeKey(0, -1, true)), 0.f);
+}
+
+INSTANTIATE_TEST_SUITE_P(RuleTypes, WinProbabilityTableTest,
+    ::testing::Values(GameRuleType::kStandard, GameRuleType::kMixedDoubles));
+
+TEST(WinProbabilityTableFileTest, ReloadsSavedTableAndRejectsTruncatedFile) {
+    auto const path = std::filesystem::temp_directory_path() / "win_probability_table_test.bin";
+    std::filesystem::remove(path);
+
+    auto const built = WinProbabilityTable::Build(EndScoreDistribution::GetDefault(GameRuleType::kMixedDoubles), GameRuleType::kMixedDoubles);
+    built.Save(path);
+    {
+        WinProbabilityTable const loaded(path);
+        EXPECT_EQ(loaded.GetRuleType(), GameRuleType::kMixedDoubles);
+        auto const key = MakeKey(3, -2, true);
+        EXPECT_EQ(loaded.Get(key), built.Get(key));
+    }
+
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 2);
+    EXPECT_THROW(WinProbabilityTable { path }, std::runtime_error);
+    std::filesystem::remove(path);
+}
+
+} // namespace
+} // namespace digitalcurling::client